@@ -101,16 +101,12 @@ void IO::write(int step, const HeatTransfer &ht, const Settings &s,
     varT->SetSelection(
         adios2::Box<adios2::Dims>({s.offsx, s.offsy}, {s.ndx, s.ndy}));
 
-    /* Select the area that we want to write from the data pointer we pass to
-         the
-         writer.
-         Think HDF5 memspace, just not hyperslabs, only a bounding box
-       selection. Engine will copy this bounding box from the data pointer into
-       the output buffer. Size of the bounding box should match the "space"
-       selection which was given above. Default memspace is always the full
-       selection.
+    /* A memory selection could describe the ghost cells of ht.data(), the
+       {ndx, ndy} block starts at {1, 1} in the {ndx + 2, ndy + 2} array:
+         varT->SetMemorySelection({{1, 1}, {s.ndx + 2, s.ndy + 2}});
+       HDFMixer doesn't copy memory selections, data without ghost cells is
+       passed instead.
     */
-    varT->SetMemorySelection(adios2::Box<adios2::Dims>({1, 1}, {s.ndx, s.ndy}));
 
     h5mixerWriter->PutSync<unsigned int>(*varGndx, s.gndx);
     h5mixerWriter->PutSync<unsigned int>("gndy", s.gndy);
@@ -188,6 +188,10 @@ constexpr size_t DefaultMaxBufferSize = MaxSizeT - 1;
  * for optimizing applications*/
 constexpr float DefaultBufferGrowthFactor = 1.05f;
 
+/** default gap in bytes up to which nearby reads of the same file are merged
+ * into a single read, 64Kb */
+constexpr size_t DefaultReadGapSize = 64 * 1024;
+
 /** default size for writing/reading files using POSIX/fstream/stdio write
  *  2Gb - 100Kb (tolerance)*/
 constexpr size_t DefaultMaxFileBatchSize = 2147381248;
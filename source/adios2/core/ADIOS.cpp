@@ -38,7 +38,7 @@ namespace adios2
 ADIOS::ADIOS(const std::string configFile, MPI_Comm mpiComm,
              const bool debugMode, const std::string hostLanguage)
 : m_MPIComm(mpiComm), m_ConfigFile(configFile), m_DebugMode(debugMode),
-  m_HostLanguage(hostLanguage)
+  m_HostLanguage(hostLanguage), m_ThreadPool(std::make_shared<ThreadPool>())
 {
     if (m_DebugMode)
     {
@@ -83,6 +83,7 @@ IO &ADIOS::DeclareIO(const std::string name)
         if (!io.IsDeclared()) // exists from config xml
         {
             io.SetDeclared();
+            io.m_ThreadPool = m_ThreadPool;
             return io;
         }
         else
@@ -101,6 +102,7 @@ IO &ADIOS::DeclareIO(const std::string name)
         name, IO(name, m_MPIComm, false, m_HostLanguage, m_DebugMode));
     IO &io = ioPair.first->second;
     io.SetDeclared();
+    io.m_ThreadPool = m_ThreadPool;
     return io;
 }
 
@@ -23,6 +23,7 @@
 #include "adios2/ADIOSTypes.h"
 #include "adios2/core/IO.h"
 #include "adios2/core/Operator.h"
+#include "adios2/helper/adiosThreadPool.h"
 
 namespace adios2
 {
@@ -168,6 +169,9 @@ private:
     /** operators created with DefineOperator */
     std::map<std::string, std::shared_ptr<Operator>> m_Operators;
 
+    /** persistent workers shared by all IOs, sized by their Threads */
+    std::shared_ptr<ThreadPool> m_ThreadPool;
+
     /** throws exception if m_MPIComm = MPI_COMM_NULL */
     void CheckMPI() const;
 
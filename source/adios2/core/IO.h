@@ -27,6 +27,7 @@
 #include "adios2/core/Attribute.h"
 #include "adios2/core/Variable.h"
 #include "adios2/core/VariableCompound.h"
+#include "adios2/helper/adiosThreadPool.h"
 
 namespace adios2
 {
@@ -72,6 +73,13 @@ public:
     /** From AddOperator, contains operators added to this IO */
     std::vector<OperatorInfo> m_Operators;
 
+    /**
+     * Workers shared across IOs from the same ADIOS object, set in
+     * ADIOS::DeclareIO. Engines, transports and operators use it for parallel
+     * work, up to the Threads parameter.
+     */
+    std::shared_ptr<ThreadPool> m_ThreadPool;
+
     /**
      * @brief Constructor called from ADIOS factory class DeclareIO function.
      * Not to be used direclty in applications.
@@ -106,19 +106,11 @@ size_t Operator::Decompress(const void * /*bufferIn*/, const size_t /*sizeIn*/,
 }
 
 // PROTECTED
-size_t Operator::DoBufferMaxSize(const void *dataIn, const Dims &dimensions,
-                                 const std::string type,
-                                 const Params &parameters) const
+size_t Operator::DoBufferMaxSize(const void * /*dataIn*/,
+                                 const Dims & /*dimensions*/,
+                                 const std::string /*type*/,
+                                 const Params & /*parameters*/) const
 {
-    if (m_DebugMode)
-    {
-        throw std::invalid_argument(
-            "ERROR: signature (const void*, const Dims& "
-            "std::string ) not supported "
-            "by derived class implemented with " +
-            m_Type + ", in call to BufferMaxSize\n");
-    }
-
     return 0;
 }
 
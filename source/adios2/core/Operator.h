@@ -63,8 +63,8 @@ public:
     virtual size_t BufferMaxSize(const size_t sizeIn) const;
 
     /**
-     * Used by Zfp
-     * Returns a conservative buffer size to hold input data for classes
+     * Returns a conservative buffer size to hold input data for classes,
+     * data dependent for Zfp, otherwise from BufferMaxSize(sizeIn)
      * @param dataIn
      * @param dimensions
      * @return recommended allocation for output buffer in bytes
@@ -118,7 +118,8 @@ protected:
      * @param dataIn
      * @param dimensions
      * @param type
-     * @return conservative buffer size for allocation
+     * @return conservative buffer size for allocation, 0 (default) if the
+     * size only depends on the input bytes
      */
     virtual size_t DoBufferMaxSize(const void *dataIn, const Dims &dimensions,
                                    const std::string type,
@@ -128,6 +129,12 @@ private:
     void CheckCallbackType(const std::string type) const;
 };
 
+#define declare_type(T)                                                        \
+    extern template size_t Operator::BufferMaxSize<T>(                         \
+        const T *, const Dims &, const Params &) const;
+ADIOS2_FOREACH_TYPE_1ARG(declare_type)
+#undef declare_type
+
 } // end namespace adios2
 
 #endif /* ADIOS2_CORE_OPERATOR_H_ */
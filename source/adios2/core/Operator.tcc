@@ -19,14 +19,26 @@
 namespace adios2
 {
 
-#define declare_type(T)                                                        \
-    template <>                                                                \
-    size_t Operator::BufferMaxSize<T>(const T *dataIn, const Dims &dimensions, \
-                                      const Params &parameters) const          \
-    {                                                                          \
-        return DoBufferMaxSize(dataIn, dimensions, GetType<T>(), parameters);  \
+template <class T>
+size_t Operator::BufferMaxSize(const T *dataIn, const Dims &dimensions,
+                               const Params &parameters) const
+{
+    // data dependent bound (e.g. Zfp), otherwise bound from bytes in
+    const size_t maxSize =
+        DoBufferMaxSize(dataIn, dimensions, GetType<T>(), parameters);
+
+    if (maxSize > 0)
+    {
+        return maxSize;
     }
-ADIOS2_FOREACH_ZFP_TYPE_1ARG(declare_type)
+
+    return BufferMaxSize(GetTotalSize(dimensions) * sizeof(T));
+}
+
+#define declare_type(T)                                                        \
+    template size_t Operator::BufferMaxSize<T>(                                \
+        const T *, const Dims &, const Params &) const;
+ADIOS2_FOREACH_TYPE_1ARG(declare_type)
 #undef declare_type
 
 } // end namespace adios2
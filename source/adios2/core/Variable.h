@@ -36,6 +36,12 @@ public:
     typename TypeInfo<T>::ValueType m_Max;
     typename TypeInfo<T>::ValueType m_Value;
 
+    /** true: reads skip blocks outside [m_ValueSelectionMin,
+     * m_ValueSelectionMax], set with SetValueSelection */
+    bool m_HasValueSelection = false;
+    typename TypeInfo<T>::ValueType m_ValueSelectionMin;
+    typename TypeInfo<T>::ValueType m_ValueSelectionMax;
+
     Variable<T>(const std::string &name, const Dims &shape, const Dims &start,
                 const Dims &count, const bool constantShape, T *data,
                 const bool debugMode);
@@ -48,6 +54,21 @@ public:
     /** Sets current data pointer for this Variable object */
     void SetData(const T *) noexcept;
 
+    /**
+     * Reading only. Blocks whose stored min and max show that none of their
+     * values are in [min, max] are not read. The part of the selection
+     * covered by those blocks is left unchanged in the user memory. For
+     * complex types min and max apply to the modulus.
+     * @param min lower bound of the values of interest, inclusive
+     * @param max upper bound of the values of interest, inclusive
+     */
+    void SetValueSelection(const typename TypeInfo<T>::ValueType &min,
+                           const typename TypeInfo<T>::ValueType &max);
+
+    /** Reading only. Removes the SetValueSelection filter, all blocks in
+     * the selection are read */
+    void RemoveValueSelection() noexcept;
+
 private:
     /** TODO: used for allocating memory from ADIOS2 */
     std::vector<T> m_AllocatedData;
@@ -13,6 +13,8 @@
 
 #include "Variable.h"
 
+#include <stdexcept> //std::invalid_argument
+
 #include "adios2/ADIOSMacros.h"
 #include "adios2/helper/adiosFunctions.h" //GetType<T>
 
@@ -28,7 +30,8 @@ namespace adios2
                           const bool debugMode)                                \
     : VariableBase(name, GetType<T>(), sizeof(T), shape, start, count,         \
                    constantDims, debugMode),                                   \
-      m_Data(data), m_Min(), m_Max(), m_Value()                                \
+      m_Data(data), m_Min(), m_Max(), m_Value(), m_ValueSelectionMin(),        \
+      m_ValueSelectionMax()                                                    \
     {                                                                          \
     }                                                                          \
                                                                                \
@@ -42,6 +45,28 @@ namespace adios2
     void Variable<T>::SetData(const T *data) noexcept                          \
     {                                                                          \
         m_Data = const_cast<T *>(data);                                        \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    void Variable<T>::SetValueSelection(                                       \
+        const typename TypeInfo<T>::ValueType &min,                            \
+        const typename TypeInfo<T>::ValueType &max)                            \
+    {                                                                          \
+        if (m_DebugMode && max < min)                                          \
+        {                                                                      \
+            throw std::invalid_argument(                                       \
+                "ERROR: min is larger than max for variable " + m_Name +       \
+                ", in call to SetValueSelection\n");                           \
+        }                                                                      \
+        m_ValueSelectionMin = min;                                             \
+        m_ValueSelectionMax = max;                                             \
+        m_HasValueSelection = true;                                            \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    void Variable<T>::RemoveValueSelection() noexcept                          \
+    {                                                                          \
+        m_HasValueSelection = false;                                           \
     }
 
 ADIOS2_FOREACH_TYPE_1ARG(declare_type)
@@ -148,12 +148,13 @@ void VariableBase::SetMemorySelection(const std::pair<Dims, Dims> &boxDims)
                                         ", in call to SetMemorySelection\n");
         }
 
-        if (m_Shape.size() != start.size() || m_Shape.size() != count.size())
+        if (start.size() != count.size() ||
+            (!count.empty() && m_Count.size() != count.size()))
         {
             throw std::invalid_argument(
                 "ERROR: selection Dims start, count sizes must be "
                 "the same as variable " +
-                m_Name + " m_Shape, in call to SetMemorySelction\n");
+                m_Name + " m_Count, in call to SetMemorySelection\n");
         }
     }
 
@@ -225,6 +226,29 @@ void VariableBase::CheckDimensions(const std::string hint) const
         }
     }
 
+    if (m_DebugMode && !m_MemoryCount.empty())
+    {
+        if (m_MemoryCount.size() != m_Count.size())
+        {
+            throw std::invalid_argument(
+                "ERROR: memory selection of variable " + m_Name +
+                " must have the same number of dimensions as count, in call "
+                "to " +
+                hint + "\n");
+        }
+
+        for (size_t d = 0; d < m_Count.size(); ++d)
+        {
+            if (m_MemoryStart[d] + m_Count[d] > m_MemoryCount[d])
+            {
+                throw std::invalid_argument(
+                    "ERROR: count of variable " + m_Name +
+                    " doesn't fit in its memory selection, in call to " +
+                    hint + "\n");
+            }
+        }
+    }
+
     CheckDimensionsCommon(hint);
     // TODO need to think more exceptions here
 }
@@ -57,6 +57,10 @@ public:
     Dims m_Start; ///< starting point (offsets) in global shape
     Dims m_Count; ///< dimensions from m_Start in global shape
 
+    /** memory selection, empty: user memory holds exactly m_Count */
+    Dims m_MemoryStart; ///< offset of m_Count in the user memory block
+    Dims m_MemoryCount; ///< user memory block dimensions (e.g. with ghosts)
+
     /** Global array was written as Joined array, so read accordingly */
     bool m_ReadAsJoined = false;
     /** Global array was written as Local value, so read accordingly */
@@ -123,9 +127,11 @@ public:
     void SetStepSelection(const Box<size_t> &boxSteps);
 
     /**
-     * Set the local dimension and global offset of the variable using a
-     * selection
+     * Describes user memory larger than the m_Count block passed to Put and
+     * Get, e.g. arrays with ghost cells. Engines copy only the m_Count block.
      * Only bounding boxes are allowed
+     * @param boxDims {start of m_Count in memory, memory block dimensions},
+     * empty dimensions remove the memory selection
      */
     void SetMemorySelection(const Box<Dims> &boxDims);
 
@@ -162,9 +168,6 @@ public:
 protected:
     const bool m_DebugMode = false;
 
-    Dims m_MemoryStart; ///< offset of memory selection
-    Dims m_MemoryCount; ///< subset of m_Shape (e.g. remove ghost points)
-
     unsigned int m_DeferredCounter = 0;
 
     void InitShapeType();
@@ -11,6 +11,12 @@
 #include "BPFileReader.h"
 #include "BPFileReader.tcc"
 
+#include <algorithm> //std::copy, std::min
+#include <chrono>
+#include <limits> //std::numeric_limits
+#include <memory> //std::unique_ptr
+#include <thread> //std::this_thread::sleep_for
+
 #include "adios2/helper/adiosFunctions.h" // MPI BroadcastVector
 
 namespace adios2
@@ -46,20 +52,25 @@ StepStatus BPFileReader::BeginStep(StepMode mode, const float timeoutSeconds)
         }
     }
 
-    if (m_FirstStep)
-    {
-        m_FirstStep = false;
-    }
-    else
-    {
-        ++m_CurrentStep;
-    }
+    const size_t step = m_FirstStep ? 0 : m_CurrentStep + 1;
 
-    if (m_CurrentStep >= m_BP3Deserializer.m_MetadataSet.StepsCount)
+    if (step >= m_BP3Deserializer.m_MetadataSet.StepsCount)
     {
-        return StepStatus::EndOfStream;
+        if (!m_IsStepMetadata)
+        {
+            return StepStatus::EndOfStream;
+        }
+
+        const StepStatus status = WaitStepMetadata(step, timeoutSeconds);
+        if (status != StepStatus::OK)
+        {
+            return status;
+        }
     }
 
+    m_FirstStep = false;
+    m_CurrentStep = step;
+
     const auto &variablesData = m_IO.GetVariablesDataMap();
 
     for (const auto &variableData : variablesData)
@@ -117,10 +128,17 @@ void BPFileReader::Init()
         }
     }
 
+    InitParameters();
     InitTransports();
     InitBuffer();
 }
 
+void BPFileReader::InitParameters()
+{
+    m_BP3Deserializer.m_ThreadPool = m_IO.m_ThreadPool;
+    m_BP3Deserializer.InitParameters(m_IO.m_Parameters);
+}
+
 void BPFileReader::InitTransports()
 {
     if (m_IO.m_TransportsParameters.empty())
@@ -133,17 +151,47 @@ void BPFileReader::InitTransports()
 
     if (m_BP3Deserializer.m_RankMPI == 0)
     {
-        const std::string metadataFile(
-            m_BP3Deserializer.GetBPMetadataFileName(m_Name));
-
         const bool profile = m_BP3Deserializer.m_Profiler.IsActive;
-        m_FileManager.OpenFiles({metadataFile}, adios2::Mode::Read,
-                                m_IO.m_TransportsParameters, profile);
+
+        // written per flush, available while the file is being written
+        const std::string stepMetadataIndexFile(
+            m_BP3Deserializer.GetBPStepMetadataIndexFileName(m_Name));
+
+        if (FileExists(stepMetadataIndexFile))
+        {
+            m_IsStepMetadata = true;
+
+            const Params stepMetadataParameters = {{"transport", "File"}};
+            m_FileManager.OpenFiles(
+                {m_BP3Deserializer.GetBPStepMetadataFileName(m_Name),
+                 stepMetadataIndexFile},
+                adios2::Mode::Read,
+                {stepMetadataParameters, stepMetadataParameters}, profile);
+        }
+        else
+        {
+            const std::string metadataFile(
+                m_BP3Deserializer.GetBPMetadataFileName(m_Name));
+
+            m_FileManager.OpenFiles({metadataFile}, adios2::Mode::Read,
+                                    m_IO.m_TransportsParameters, profile);
+        }
     }
+
+    m_IsStepMetadata = (BroadcastValue(static_cast<size_t>(m_IsStepMetadata),
+                                       m_MPIComm) == 1);
 }
 
 void BPFileReader::InitBuffer()
 {
+    if (m_IsStepMetadata)
+    {
+        // steps are added as their metadata blocks are read
+        m_BP3Deserializer.m_MetadataSet.StepsCount = 0;
+        ReadStepMetadata();
+        return;
+    }
+
     // Put all metadata in buffer
     if (m_BP3Deserializer.m_RankMPI == 0)
     {
@@ -162,6 +210,110 @@ void BPFileReader::InitBuffer()
     m_BP3Deserializer.ParseMetadata(m_BP3Deserializer.m_Metadata, m_IO);
 }
 
+void BPFileReader::ReadStepMetadata()
+{
+    // blocks are prefixed by their size
+    std::vector<char> blocks;
+
+    if (m_BP3Deserializer.m_RankMPI == 0)
+    {
+        // record: steps, block offset, block length
+        const size_t recordSize = 3 * sizeof(uint64_t);
+        // incomplete records are read in the next call
+        const size_t recordsCount = m_FileManager.GetFileSize(1) / recordSize;
+
+        while (!m_StepMetadataEnd && m_StepMetadataRecords < recordsCount)
+        {
+            uint64_t record[3];
+            m_FileManager.ReadFile(reinterpret_cast<char *>(record),
+                                   recordSize,
+                                   m_StepMetadataRecords * recordSize, 1);
+            ++m_StepMetadataRecords;
+
+            if (record[0] == std::numeric_limits<uint64_t>::max())
+            {
+                m_StepMetadataEnd = true;
+                break;
+            }
+
+            const size_t blockSize = static_cast<size_t>(record[2]);
+            size_t position = blocks.size();
+            blocks.resize(position + 8 + blockSize);
+            CopyToBuffer(blocks, position, &record[2]);
+            m_FileManager.ReadFile(&blocks[position], blockSize,
+                                   static_cast<size_t>(record[1]), 0);
+        }
+    }
+
+    BroadcastVector(blocks, m_MPIComm);
+    m_StepMetadataEnd = (BroadcastValue(static_cast<size_t>(m_StepMetadataEnd),
+                                        m_MPIComm) == 1);
+
+    auto &metadata = m_BP3Deserializer.m_Metadata;
+    size_t position = 0;
+
+    while (position < blocks.size())
+    {
+        const size_t blockSize =
+            static_cast<size_t>(ReadValue<uint64_t>(blocks, position));
+        const size_t blockStart = metadata.m_Buffer.size();
+
+        metadata.Resize(blockStart + blockSize,
+                        "appending step metadata block, in call to "
+                        "BPFileReader BeginStep");
+        std::copy(blocks.begin() + position,
+                  blocks.begin() + position + blockSize,
+                  metadata.m_Buffer.begin() + blockStart);
+        position += blockSize;
+
+        m_BP3Deserializer.ParseMetadata(metadata, m_IO, blockStart);
+    }
+}
+
+StepStatus BPFileReader::WaitStepMetadata(const size_t step,
+                                          const float timeoutSeconds)
+{
+    const auto &stepsCount = m_BP3Deserializer.m_MetadataSet.StepsCount;
+    const auto timeStart = std::chrono::steady_clock::now();
+
+    while (!m_StepMetadataEnd)
+    {
+        ReadStepMetadata();
+
+        if (step < stepsCount)
+        {
+            return StepStatus::OK;
+        }
+
+        if (m_StepMetadataEnd)
+        {
+            break;
+        }
+
+        // rank 0 decides so all ranks leave the loop together
+        size_t isTimeout = 0;
+        if (m_BP3Deserializer.m_RankMPI == 0)
+        {
+            const std::chrono::duration<float> elapsed =
+                std::chrono::steady_clock::now() - timeStart;
+
+            if (timeoutSeconds >= 0.f && elapsed.count() >= timeoutSeconds)
+            {
+                isTimeout = 1;
+            }
+        }
+
+        if (BroadcastValue(isTimeout, m_MPIComm) == 1)
+        {
+            return StepStatus::NotReady;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    return StepStatus::EndOfStream;
+}
+
 #define declare_type(T)                                                        \
     void BPFileReader::DoGetSync(Variable<T> &variable, T *data)               \
     {                                                                          \
@@ -183,45 +335,121 @@ void BPFileReader::ReadVariables(
 {
     const bool profile = m_BP3Deserializer.m_Profiler.IsActive;
 
-    // sequentially request bytes from transport manager
-    // threaded per variable?
-    for (const auto &variableNamePair : variablesSubFileInfo) // variable name
+    // sorted and merged reads per sub-file
+    const std::map<size_t, std::vector<format::BP3Deserializer::ReadRequest>>
+        subFilesRequests =
+            m_BP3Deserializer.GetReadRequests(variablesSubFileInfo);
+
+    // sub-files use the same library as the metadata file (e.g. mmap)
+    Params subFileParameters = m_IO.m_TransportsParameters.front();
+    subFileParameters["transport"] = "File";
+
+    // TransportMan is not thread-safe, open all sub-files first
+    std::vector<size_t> subFileIndices;
+    subFileIndices.reserve(subFilesRequests.size());
+
+    for (const auto &subFileRequestsPair : subFilesRequests)
     {
-        const std::string variableName(variableNamePair.first);
+        const size_t subFileIndex = subFileRequestsPair.first;
 
-        // or threaded per file?
-        for (const auto &subFileIndexPair : variableNamePair.second)
+        if (m_SubFileManager.m_Transports.count(subFileIndex) == 0)
         {
-            const size_t subFileIndex = subFileIndexPair.first;
+            const std::string subFile(
+                m_BP3Deserializer.GetBPSubFileName(m_Name, subFileIndex));
 
-            if (m_SubFileManager.m_Transports.count(subFileIndex) == 0)
-            {
-                const std::string subFile(
-                    m_BP3Deserializer.GetBPSubFileName(m_Name, subFileIndex));
+            m_SubFileManager.OpenFileID(subFile, subFileIndex, Mode::Read,
+                                        subFileParameters, profile);
+        }
+        subFileIndices.push_back(subFileIndex);
+    }
 
-                m_SubFileManager.OpenFileID(subFile, subFileIndex, Mode::Read,
-                                            {{"transport", "File"}}, profile);
-            }
+    // a sub-file transport is only used by one thread, thread t reads
+    // sub-files t, t + threads, ...
+    auto lf_ReadSubFiles = [&](const size_t first, const size_t stride) {
 
-            for (const auto &stepPair : subFileIndexPair.second) // step
+        // reused by all reads in this thread, not initialized: only the
+        // pages touched by runs are ever committed
+        std::unique_ptr<char[]> readMemory;
+        size_t readMemorySize = 0;
+        std::vector<char> preTransformMemory;
+
+        for (size_t i = first; i < subFileIndices.size(); i += stride)
+        {
+            const size_t subFileIndex = subFileIndices[i];
+
+            for (const auto &request : subFilesRequests.at(subFileIndex))
             {
-                for (const auto &blockInfo : stepPair.second)
+                const size_t readStart = request.Seeks.first;
+                const size_t readSize = request.Seeks.second - readStart;
+
+                // mapped sub-files are clipped in place, no intermediate copy
+                const char *readData = m_SubFileManager.GetFileData(
+                    readSize, readStart, subFileIndex);
+
+                if (readData == nullptr)
                 {
-                    const auto &seek = blockInfo.Seeks;
-                    const size_t blockStart = seek.first;
-                    const size_t blockSize = seek.second - seek.first;
-                    std::vector<char> contiguousMemory(blockSize);
-                    m_SubFileManager.ReadFile(contiguousMemory.data(),
-                                              blockSize, blockStart,
-                                              subFileIndex);
+                    if (readMemorySize < readSize)
+                    {
+                        readMemory.reset(new char[readSize]);
+                        readMemorySize = readSize;
+                    }
+
+                    // only the intersections, bytes between runs are unset
+                    for (const auto &run : request.Runs)
+                    {
+                        m_SubFileManager.ReadFile(
+                            readMemory.get() + run.first - readStart,
+                            run.second - run.first, run.first, subFileIndex);
+                    }
+                    readData = readMemory.get();
+                }
+
+                for (const auto &block : request.Blocks)
+                {
+                    const std::string &variableName = *block.first;
+                    const SubFileInfo &blockInfo = *block.second;
+
+                    const char *contiguousMemory =
+                        readData + blockInfo.Seeks.first - readStart;
+
+                    if (!blockInfo.TransformType.empty())
+                    {
+                        // whole transformed block was read
+                        m_BP3Deserializer.InverseTransform(
+                            variableName, m_IO, blockInfo, contiguousMemory,
+                            preTransformMemory);
+
+                        contiguousMemory = preTransformMemory.data() +
+                                           blockInfo.PreTransformSeeks.first;
+                    }
 
                     m_BP3Deserializer.ClipContiguousMemory(
                         variableName, m_IO, contiguousMemory,
                         blockInfo.BlockBox, blockInfo.IntersectionBox);
                 } // end block
-            }     // end step
+            }     // end request
         }         // end subfile
-    }             // end variable
+    };
+
+    const size_t threads =
+        std::min(static_cast<size_t>(m_BP3Deserializer.m_Threads),
+                 subFileIndices.size());
+
+    if (threads <= 1)
+    {
+        lf_ReadSubFiles(0, 1);
+        return;
+    }
+
+    // each task reads the sub-files t, t + threads, t + 2 * threads ...
+    m_BP3Deserializer.m_ThreadPool->ParallelFor(
+        threads, 1, static_cast<unsigned int>(threads),
+        [&](const size_t begin, const size_t end) {
+            for (size_t t = begin; t < end; ++t)
+            {
+                lf_ReadSubFiles(t, threads);
+            }
+        });
 }
 
 void BPFileReader::DoClose(const int transportIndex)
@@ -60,10 +60,38 @@ private:
     size_t m_CurrentStep = 0;
     bool m_FirstStep = true;
 
+    /** true: metadata is read in blocks from the step metadata file, steps
+     * still being written can be waited for in BeginStep */
+    bool m_IsStepMetadata = false;
+
+    /** number of records read from the step metadata index, rank 0 only */
+    size_t m_StepMetadataRecords = 0;
+
+    /** true: end of stream record found in the step metadata index */
+    bool m_StepMetadataEnd = false;
+
     void Init();
+    void InitParameters() final;
     void InitTransports();
     void InitBuffer();
 
+    /**
+     * Collective. Rank 0 reads all new complete records and their blocks
+     * from the step metadata files and broadcasts them, blocks are appended
+     * to the metadata buffer and parsed into m_IO.
+     */
+    void ReadStepMetadata();
+
+    /**
+     * Collective. Polls the step metadata files until step is available
+     * @param step to wait for
+     * @param timeoutSeconds < 0: wait until step or end of stream, 0: check
+     * once, > 0: poll up to timeoutSeconds
+     * @return OK: step is available, NotReady: timeout, EndOfStream: writer
+     * closed without reaching step
+     */
+    StepStatus WaitStepMetadata(const size_t step, const float timeoutSeconds);
+
 #define declare_type(T)                                                        \
     void DoGetSync(Variable<T> &, T *) final;                                  \
     void DoGetDeferred(Variable<T> &, T *) final;                              \
@@ -11,6 +11,9 @@
 #include "BPFileWriter.h"
 #include "BPFileWriter.tcc"
 
+#include <algorithm> //std::min
+#include <limits>    //std::numeric_limits
+
 #include "adios2/ADIOSMPI.h"
 #include "adios2/ADIOSMacros.h"
 #include "adios2/core/IO.h"
@@ -25,7 +28,8 @@ BPFileWriter::BPFileWriter(IO &io, const std::string &name, const Mode mode,
 : Engine("BPFileWriter", io, name, mode, mpiComm),
   m_BP3Serializer(mpiComm, m_DebugMode),
   m_FileDataManager(mpiComm, m_DebugMode),
-  m_FileMetadataManager(mpiComm, m_DebugMode)
+  m_FileMetadataManager(mpiComm, m_DebugMode),
+  m_FileStepMetadataManager(mpiComm, m_DebugMode)
 {
     m_EndMessage = " in call to IO Open BPFileWriter " + m_Name + "\n";
     Init();
@@ -47,8 +51,13 @@ size_t BPFileWriter::CurrentStep() const
 
 void BPFileWriter::PerformPuts()
 {
-    m_BP3Serializer.ResizeBuffer(m_BP3Serializer.m_DeferredVariablesDataSize,
-                                 "in call to PerformPuts");
+    // zero-copy payloads don't take buffer space, sized per variable
+    if (!m_ZeroCopyPuts)
+    {
+        m_BP3Serializer.ResizeBuffer(
+            m_BP3Serializer.m_DeferredVariablesDataSize,
+            "in call to PerformPuts");
+    }
 
     for (const auto &variableName : m_BP3Serializer.m_DeferredVariables)
     {
@@ -60,25 +69,31 @@ void BPFileWriter::PerformPuts()
 
 void BPFileWriter::EndStep()
 {
+    const size_t currentStep = CurrentStep();
+    const size_t flushStepsCount = m_BP3Serializer.m_FlushStepsCount;
+
     if (m_BP3Serializer.m_DeferredVariables.size() > 0)
     {
+        // deferred user memory is only valid until EndStep returns: it can
+        // be written in place if this step is written synchronously now
+        m_ZeroCopyPuts = m_BP3Serializer.m_ZeroCopy &&
+                         !m_BP3Serializer.m_AsyncWrite &&
+                         !m_BP3Serializer.m_Aggregator.m_IsActive &&
+                         currentStep % flushStepsCount == 0;
         PerformPuts();
+        m_ZeroCopyPuts = false;
     }
 
-    const size_t currentStep = CurrentStep();
-    const size_t flushStepsCount = m_BP3Serializer.m_FlushStepsCount;
-
     m_BP3Serializer.SerializeData(m_IO, true); // true: advances step
 
     // must be explicit
     if (currentStep % flushStepsCount == 0)
     {
-        const size_t dataSize = m_BP3Serializer.m_Data.m_Position;
+        const size_t dataSize = m_BP3Serializer.m_Data.GetDataSize();
         m_BP3Serializer.CloseStream(m_IO);
-        m_FileDataManager.WriteFiles(m_BP3Serializer.m_Data.m_Buffer.data(),
-                                     dataSize);
+        WriteData(dataSize);
         m_BP3Serializer.ResetBuffer(m_BP3Serializer.m_Data);
-        WriteCollectiveMetadataFile();
+        WriteStepMetadata();
 
         //        if (currentStep == 5)
         //        {
@@ -112,12 +127,20 @@ ADIOS2_FOREACH_TYPE_1ARG(declare_type)
 
 void BPFileWriter::InitParameters()
 {
+    m_BP3Serializer.m_ThreadPool = m_IO.m_ThreadPool;
     m_BP3Serializer.InitParameters(m_IO.m_Parameters);
+
+    // collective, freed in DoClose
+    if (m_BP3Serializer.m_SubStreams > 0)
+    {
+        m_BP3Serializer.m_Aggregator.Init(m_BP3Serializer.m_SubStreams,
+                                          m_MPIComm);
+        m_BP3Serializer.m_Processes = m_BP3Serializer.m_Aggregator.m_Size;
+    }
 }
 
 void BPFileWriter::InitTransports()
 {
-    // TODO need to add support for aggregators here later
     if (m_IO.m_TransportsParameters.empty())
     {
         Params defaultTransportParameters;
@@ -130,10 +153,27 @@ void BPFileWriter::InitTransports()
         m_FileDataManager.GetFilesBaseNames(m_Name,
                                             m_IO.m_TransportsParameters);
 
-    // /path/name.bp.dir/name.bp.rank
+    // /path/name.bp.dir/name.bp.rank or name.bp.substream if aggregating
     const std::vector<std::string> bpRankNames =
         m_BP3Serializer.GetBPRankNames(transportsNames);
 
+    // step metadata is appended at every flush so readers can follow
+    if (m_BP3Serializer.m_RankMPI == 0)
+    {
+        const Params stepMetadataParameters = {{"transport", "File"}};
+        m_FileStepMetadataManager.OpenFiles(
+            {m_BP3Serializer.GetBPStepMetadataFileName(m_Name),
+             m_BP3Serializer.GetBPStepMetadataIndexFileName(m_Name)},
+            Mode::Write, {stepMetadataParameters, stepMetadataParameters},
+            m_BP3Serializer.m_Profiler.IsActive);
+    }
+
+    // only consumers (aggregators) write sub-files
+    if (!m_BP3Serializer.m_Aggregator.m_IsConsumer)
+    {
+        return;
+    }
+
     m_FileDataManager.OpenFiles(bpRankNames, m_OpenMode,
                                 m_IO.m_TransportsParameters,
                                 m_BP3Serializer.m_Profiler.IsActive);
@@ -143,15 +183,78 @@ void BPFileWriter::InitBPBuffer()
 {
     if (m_OpenMode == Mode::Append)
     {
-        throw std::invalid_argument(
-            "ADIOS2: OpenMode Append hasn't been implemented, yet");
-        // TODO: Get last pg timestep and update timestep counter in
+        InitAppend();
+    }
+
+    // chunks are gathered at write, async and aggregated writes need a
+    // contiguous buffer
+    if (!m_BP3Serializer.m_AsyncWrite &&
+        !m_BP3Serializer.m_Aggregator.m_IsActive)
+    {
+        m_BP3Serializer.m_Data.m_ChunkSize = m_BP3Serializer.m_BufferChunkSize;
+    }
+
+    m_BP3Serializer.PutProcessGroupIndex(
+        m_IO.m_Name, m_IO.m_HostLanguage,
+        m_FileDataManager.GetTransportsTypes());
+}
+
+void BPFileWriter::InitAppend()
+{
+    auto &aggregator = m_BP3Serializer.m_Aggregator;
+    const std::string metadataFile(
+        m_BP3Serializer.GetBPMetadataFileName(m_Name));
+
+    size_t stepsCount = 0;
+
+    if (m_BP3Serializer.m_RankMPI == 0 && FileExists(metadataFile))
+    {
+        format::BP3Deserializer bp3Deserializer(m_MPIComm, m_DebugMode);
+        auto &metadata = bp3Deserializer.m_Metadata;
+
+        m_FileMetadataManager.OpenFiles({metadataFile}, Mode::Read,
+                                        {{{"transport", "File"}}},
+                                        m_BP3Serializer.m_Profiler.IsActive);
+        const size_t fileSize = m_FileMetadataManager.GetFileSize(0);
+        metadata.Resize(fileSize, "allocating existing metadata buffer, in "
+                                  "call to BPFileWriter Open in Append mode");
+        m_FileMetadataManager.ReadFile(metadata.m_Buffer.data(), fileSize);
+        m_FileMetadataManager.CloseFiles();
+
+        // scratch IO, only definitions are parsed, payloads are not read
+        IO io("BPFileWriterAppend", m_MPIComm, false, m_IO.m_HostLanguage,
+              m_DebugMode);
+        bp3Deserializer.ParseMetadata(metadata, io);
+        stepsCount = bp3Deserializer.m_MetadataSet.StepsCount;
+
+        m_BP3Serializer.AppendMetadataIndices(metadata.m_Buffer,
+                                              bp3Deserializer.m_Minifooter);
+
+        // existing steps are the first step metadata block
+        PublishStepMetadata(metadata.m_Buffer.data(), fileSize,
+                            static_cast<uint64_t>(stepsCount));
+    }
+
+    stepsCount = BroadcastValue(stepsCount, m_MPIComm);
+    m_BP3Serializer.m_MetadataSet.TimeStep =
+        static_cast<uint32_t>(stepsCount + 1);
+    m_BP3Serializer.m_MetadataSet.CurrentStep = stepsCount;
+
+    // new process groups start at the end of existing sub-files
+    size_t subFileSize = 0;
+    if (aggregator.m_IsConsumer)
+    {
+        subFileSize = m_FileDataManager.GetFileSize(0);
+    }
+
+    if (aggregator.m_IsActive)
+    {
+        aggregator.m_SubFileSize =
+            BroadcastValue(subFileSize, aggregator.m_Comm);
     }
     else
     {
-        m_BP3Serializer.PutProcessGroupIndex(
-            m_IO.m_Name, m_IO.m_HostLanguage,
-            m_FileDataManager.GetTransportsTypes());
+        m_BP3Serializer.m_Data.m_AbsolutePosition = subFileSize;
     }
 }
 
@@ -162,14 +265,41 @@ void BPFileWriter::DoClose(const int transportIndex)
         PerformPuts();
     }
 
-    // close bp buffer by serializing data and metadata
-    m_BP3Serializer.CloseData(m_IO);
-    // send data to corresponding transports
-    m_FileDataManager.WriteFiles(m_BP3Serializer.m_Data.m_Buffer.data(),
-                                 m_BP3Serializer.m_Data.m_Position,
-                                 transportIndex);
+    if (m_BP3Serializer.m_Aggregator.m_IsActive)
+    {
+        if (m_BP3Serializer.m_IsClosed)
+        {
+            return;
+        }
+        // sub-files are collective, all transports are closed at once
+        AggregateCloseData();
+        m_FileDataManager.CloseFiles();
+    }
+    else
+    {
+        // close bp buffer by serializing data and metadata
+        m_BP3Serializer.CloseData(m_IO);
+        // buffers in flight must land before the final one
+        WaitAsyncWrite();
+        // send data to corresponding transports
+        if (m_BP3Serializer.m_Data.m_Chunks.empty())
+        {
+            m_FileDataManager.WriteFiles(
+                m_BP3Serializer.m_Data.m_Buffer.data(),
+                m_BP3Serializer.m_Data.m_Position, transportIndex);
+        }
+        else
+        {
+            WriteDataV(m_BP3Serializer.m_Data.GetDataSize(), transportIndex);
+        }
+
+        m_FileDataManager.CloseFiles(transportIndex);
+    }
 
-    m_FileDataManager.CloseFiles(transportIndex);
+    if (m_FileDataManager.AllTransportsClosed())
+    {
+        WriteStepMetadata(true);
+    }
 
     if (m_BP3Serializer.m_Profiler.IsActive &&
         m_FileDataManager.AllTransportsClosed())
@@ -182,6 +312,8 @@ void BPFileWriter::DoClose(const int transportIndex)
     {
         WriteCollectiveMetadataFile();
     }
+
+    m_BP3Serializer.m_Aggregator.Close();
 }
 
 void BPFileWriter::WriteProfilingJSONFile()
@@ -220,7 +352,8 @@ void BPFileWriter::WriteCollectiveMetadataFile()
         const std::vector<std::string> bpMetadataFileNames =
             m_BP3Serializer.GetBPMetadataFileNames(transportsNames);
 
-        m_FileMetadataManager.OpenFiles(bpMetadataFileNames, m_OpenMode,
+        // always rewritten, also in Append mode
+        m_FileMetadataManager.OpenFiles(bpMetadataFileNames, Mode::Write,
                                         m_IO.m_TransportsParameters,
                                         m_BP3Serializer.m_Profiler.IsActive);
 
@@ -233,4 +366,220 @@ void BPFileWriter::WriteCollectiveMetadataFile()
     }
 }
 
+void BPFileWriter::WriteStepMetadata(const bool isFinal)
+{
+    m_BP3Serializer.AggregateCollectiveStepMetadata();
+    if (m_BP3Serializer.m_RankMPI != 0)
+    {
+        return;
+    }
+
+    auto &metadata = m_BP3Serializer.m_Metadata;
+    const uint64_t steps = static_cast<uint64_t>(CurrentStep());
+
+    // pending block's data landed before all ranks entered the aggregation
+    if (!m_PendingStepMetadata.empty())
+    {
+        PublishStepMetadata(m_PendingStepMetadata.data(),
+                            m_PendingStepMetadata.size(),
+                            m_PendingStepMetadataSteps);
+        m_PendingStepMetadata.clear();
+    }
+
+    // blocks without new process groups don't carry new steps
+    size_t position = 0;
+    const uint64_t pgCount = ReadValue<uint64_t>(metadata.m_Buffer, position);
+
+    if (pgCount > 0)
+    {
+        const bool isAsync = m_BP3Serializer.m_AsyncWrite &&
+                             !m_BP3Serializer.m_Aggregator.m_IsActive;
+
+        if (isAsync && !isFinal)
+        {
+            m_PendingStepMetadata.assign(metadata.m_Buffer.begin(),
+                                         metadata.m_Buffer.begin() +
+                                             metadata.m_Position);
+            m_PendingStepMetadataSteps = steps;
+        }
+        else
+        {
+            PublishStepMetadata(metadata.m_Buffer.data(), metadata.m_Position,
+                                steps);
+        }
+    }
+
+    if (isFinal)
+    {
+        const uint64_t endRecord[3] = {std::numeric_limits<uint64_t>::max(),
+                                       m_StepMetadataFileSize, 0};
+        m_FileStepMetadataManager.WriteFiles(
+            reinterpret_cast<const char *>(endRecord), sizeof(endRecord), 1);
+        m_FileStepMetadataManager.CloseFiles();
+    }
+
+    m_BP3Serializer.ResetBuffer(metadata, true);
+}
+
+void BPFileWriter::PublishStepMetadata(const char *block, const size_t size,
+                                       const uint64_t steps)
+{
+    // block must be visible before the record pointing to it
+    m_FileStepMetadataManager.WriteFiles(block, size, 0);
+    m_FileStepMetadataManager.FlushFiles(0);
+
+    const uint64_t record[3] = {steps, m_StepMetadataFileSize,
+                                static_cast<uint64_t>(size)};
+    m_FileStepMetadataManager.WriteFiles(
+        reinterpret_cast<const char *>(record), sizeof(record), 1);
+    m_FileStepMetadataManager.FlushFiles(1);
+
+    m_StepMetadataFileSize += static_cast<uint64_t>(size);
+}
+
+void BPFileWriter::WriteData(const size_t dataSize, const int transportIndex)
+{
+    auto &data = m_BP3Serializer.m_Data;
+    auto &aggregator = m_BP3Serializer.m_Aggregator;
+
+    if (!aggregator.m_IsActive)
+    {
+        if (m_BP3Serializer.m_AsyncWrite)
+        {
+            // at most one buffer in flight, the other one is being filled
+            WaitAsyncWrite();
+
+            // seal current buffer and hand it to the writing thread
+            m_AsyncBuffer.swap(data.m_Buffer);
+            data.m_Buffer.resize(m_AsyncBuffer.size());
+
+            m_AsyncWriteFuture = std::async(
+                std::launch::async, [this, dataSize, transportIndex]() {
+                    m_FileDataManager.WriteFiles(m_AsyncBuffer.data(),
+                                                 dataSize, transportIndex);
+                    m_FileDataManager.FlushFiles(transportIndex);
+                });
+            return;
+        }
+
+        if (!m_BP3Serializer.m_ExternalPayloads.empty() ||
+            !data.m_Chunks.empty())
+        {
+            WriteDataV(dataSize, transportIndex);
+            return;
+        }
+
+        m_FileDataManager.WriteFiles(data.m_Buffer.data(), dataSize,
+                                     transportIndex);
+        m_FileDataManager.FlushFiles(transportIndex);
+        return;
+    }
+
+    // aggregation uses MPI, always in the calling thread
+
+    // data buffer starts at this absolute position in the rank's own stream,
+    // but lands at subFileOffset in the sub-file
+    const size_t bufferOffset = data.m_AbsolutePosition - dataSize;
+    const size_t subFileOffset = aggregator.GetSubFileOffset(dataSize);
+    m_BP3Serializer.UpdateOffsetsInMetadata(
+        static_cast<uint64_t>(subFileOffset - bufferOffset));
+
+    aggregator.Gather(data.m_Buffer.data(), dataSize,
+                      [&](const char *buffer, const size_t size) {
+                          m_FileDataManager.WriteFiles(buffer, size,
+                                                       transportIndex);
+                      });
+
+    if (aggregator.m_IsConsumer)
+    {
+        m_FileDataManager.FlushFiles(transportIndex);
+    }
+}
+
+void BPFileWriter::WriteDataV(const size_t dataSize, const int transportIndex)
+{
+    auto &data = m_BP3Serializer.m_Data;
+    auto &externalPayloads = m_BP3Serializer.m_ExternalPayloads;
+
+    // buffer pieces between payloads, payloads from user memory
+    std::vector<Transport::IOVec> iov;
+    iov.reserve(2 * externalPayloads.size() + data.m_Chunks.size() + 1);
+
+    // adds data from position to end, split at the ends of sealed chunks
+    size_t chunk = 0;
+    size_t chunkStart = 0;
+    auto lf_AddData = [&](size_t position, const size_t end) {
+        while (position < end)
+        {
+            const bool isSealed = chunk < data.m_Chunks.size();
+            const size_t chunkEnd =
+                isSealed ? chunkStart + data.m_Chunks[chunk].second : end;
+            const char *chunkData = isSealed
+                                        ? data.m_Chunks[chunk].first.data()
+                                        : data.m_Buffer.data();
+
+            const size_t pieceEnd = std::min(end, chunkEnd);
+            iov.push_back({chunkData + position - chunkStart,
+                           pieceEnd - position});
+            position = pieceEnd;
+
+            if (position == chunkEnd && isSealed)
+            {
+                chunkStart = chunkEnd;
+                ++chunk;
+            }
+        }
+    };
+
+    size_t position = 0;
+    for (const auto &externalPayload : externalPayloads)
+    {
+        lf_AddData(position, externalPayload.Position);
+        iov.push_back({externalPayload.Data, externalPayload.Size});
+        position = externalPayload.Position;
+    }
+    lf_AddData(position, dataSize);
+
+    m_FileDataManager.WriteFilesV(iov.data(), iov.size(), transportIndex);
+    m_FileDataManager.FlushFiles(transportIndex);
+
+    externalPayloads.clear();
+}
+
+void BPFileWriter::WaitAsyncWrite()
+{
+    if (m_AsyncWriteFuture.valid())
+    {
+        m_AsyncWriteFuture.get();
+    }
+}
+
+void BPFileWriter::AggregateCloseData()
+{
+    auto &data = m_BP3Serializer.m_Data;
+    auto &aggregator = m_BP3Serializer.m_Aggregator;
+
+    if (m_BP3Serializer.m_MetadataSet.DataPGIsOpen)
+    {
+        m_BP3Serializer.SerializeData(m_IO);
+    }
+
+    // local footer is only used to set indices lengths, not written
+    const size_t dataSize = data.m_Position;
+    m_BP3Serializer.CloseStream(m_IO);
+    WriteData(dataSize);
+    m_BP3Serializer.ResetBuffer(data);
+
+    // sub-file footer from all ranks in the sub-stream
+    data.m_AbsolutePosition = aggregator.m_SubFileSize;
+    m_BP3Serializer.AggregateCollectiveMetadata(aggregator.m_Comm, data,
+                                                false);
+    if (aggregator.m_IsConsumer)
+    {
+        m_FileDataManager.WriteFiles(data.m_Buffer.data(), data.m_Position);
+    }
+
+    m_BP3Serializer.m_IsClosed = true;
+}
+
 } // end namespace adios2
@@ -11,6 +11,11 @@
 #ifndef ADIOS2_ENGINE_BP_BPFILEWRITER_H_
 #define ADIOS2_ENGINE_BP_BPFILEWRITER_H_
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <future>
+#include <vector>
+/// \endcond
+
 #include "adios2/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
 #include "adios2/toolkit/format/bp3/BP3.h"
@@ -49,6 +54,28 @@ private:
     /** Manages the optional collective metadata files */
     transportman::TransportMan m_FileMetadataManager;
 
+    /** Manages the step metadata file (0) and its index (1), rank 0 only */
+    transportman::TransportMan m_FileStepMetadataManager;
+
+    /** Current size of the step metadata file, offset of the next block */
+    uint64_t m_StepMetadataFileSize = 0;
+
+    /** AsyncWrite: latest step metadata block, waiting for its data */
+    std::vector<char> m_PendingStepMetadata;
+
+    /** AsyncWrite: steps written when the pending block was created */
+    uint64_t m_PendingStepMetadataSteps = 0;
+
+    /** AsyncWrite: sealed data buffer being written by m_AsyncWriteFuture */
+    std::vector<char> m_AsyncBuffer;
+
+    /** AsyncWrite: writes m_AsyncBuffer, at most one in flight */
+    std::future<void> m_AsyncWriteFuture;
+
+    /** ZeroCopy: true while EndStep performs deferred puts of a step that is
+     * written before EndStep returns, payloads stay in user memory */
+    bool m_ZeroCopyPuts = false;
+
     void Init() final;
 
     /** Parses parameters from IO SetParameters */
@@ -58,6 +85,12 @@ private:
     /** Allocates memory and starts a PG group */
     void InitBPBuffer();
 
+    /**
+     * Append mode: seeds metadata indices and steps from the existing
+     * collective metadata file, new data continues at the end of sub-files
+     */
+    void InitAppend();
+
 #define declare_type(T)                                                        \
     void DoPutSync(Variable<T> &, const T *) final;                            \
     void DoPutDeferred(Variable<T> &, const T *) final;                        \
@@ -83,6 +116,54 @@ private:
     void WriteProfilingJSONFile();
 
     void WriteCollectiveMetadataFile();
+
+    /**
+     * Collective. Aggregates the metadata added since the last call into a
+     * block that rank 0 appends to the step metadata file, followed by a
+     * record in the step metadata index. With AsyncWrite, a block is
+     * published at the next call, once its data has landed from all ranks.
+     * @param isFinal true: at Close, publishes all blocks and writes the end
+     * of stream record
+     */
+    void WriteStepMetadata(const bool isFinal = false);
+
+    /**
+     * Rank 0: appends a metadata block to the step metadata file and its
+     * record (steps, offset, length) to the step metadata index
+     * @param block aggregated metadata block
+     * @param size block size in bytes
+     * @param steps number of steps written when the block was created
+     */
+    void PublishStepMetadata(const char *block, const size_t size,
+                             const uint64_t steps);
+
+    /**
+     * Writes dataSize bytes from the data buffer to transports. If
+     * aggregating, it's collective within each sub-stream: the consumer
+     * writes the data of all its ranks to the sub-file, and metadata offsets
+     * are updated to sub-file offsets.
+     * @param dataSize bytes from the beginning of the data buffer
+     * @param transportIndex -1: all transports
+     */
+    void WriteData(const size_t dataSize, const int transportIndex = -1);
+
+    /**
+     * Used at DoClose if aggregating, writes remaining data and the sub-file
+     * footer with the merged metadata of all ranks in the sub-stream
+     */
+    void AggregateCloseData();
+
+    /**
+     * ZeroCopy or BufferChunkSize: single gather write of dataSize bytes from
+     * the data buffer chunks interleaved with the payloads left in user memory
+     * @param dataSize bytes from the beginning of the data buffer
+     * @param transportIndex -1: all transports
+     */
+    void WriteDataV(const size_t dataSize, const int transportIndex = -1);
+
+    /** AsyncWrite: blocks until the buffer in flight is written, rethrows
+     * exceptions from the background thread */
+    void WaitAsyncWrite();
 };
 
 } // end namespace adios2
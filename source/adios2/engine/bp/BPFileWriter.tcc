@@ -12,6 +12,8 @@
 
 #include "BPFileWriter.h"
 
+#include <type_traits> //std::is_same
+
 namespace adios2
 {
 
@@ -29,27 +31,51 @@ void BPFileWriter::PutSyncCommon(Variable<T> &variable, const T *values)
             m_FileDataManager.GetTransportsTypes());
     }
 
-    const size_t dataSize = variable.PayloadSize() +
-                            m_BP3Serializer.GetVariableBPIndexSize(
-                                variable.m_Name, variable.m_Count);
+    // strings and transformed payloads are always copied
+    const bool transformed =
+        m_BP3Serializer.GetCompressionOperator(variable) != nullptr;
+    const bool zeroCopy = m_ZeroCopyPuts && !transformed &&
+                          variable.m_MemoryCount.empty() &&
+                          !std::is_same<T, std::string>::value;
+
+    const size_t payloadSize =
+        zeroCopy ? 0 : m_BP3Serializer.GetPayloadMaxSize(variable);
+    const size_t dataSize =
+        payloadSize + m_BP3Serializer.GetVariableBPIndexSize(variable);
     format::BP3Base::ResizeResult resizeResult = m_BP3Serializer.ResizeBuffer(
         dataSize, "in call to variable " + variable.m_Name + " PutSync");
 
     if (resizeResult == format::BP3Base::ResizeResult::Flush)
     {
+        if (m_BP3Serializer.m_Aggregator.m_IsActive)
+        {
+            throw std::runtime_error(
+                "ERROR: buffer is full and flushing to sub-files is a "
+                "collective operation only allowed at EndStep, increase "
+                "MaxBufferSize, in call to variable " +
+                variable.m_Name + " PutSync\n");
+        }
+
         m_BP3Serializer.SerializeData(m_IO);
-        m_FileDataManager.WriteFiles(m_BP3Serializer.m_Data.m_Buffer.data(),
-                                     m_BP3Serializer.m_Data.m_Position);
+        WriteData(m_BP3Serializer.m_Data.GetDataSize());
         m_BP3Serializer.ResetBuffer(m_BP3Serializer.m_Data);
         // new group index for incoming variable
         m_BP3Serializer.PutProcessGroupIndex(
             m_IO.m_Name, m_IO.m_HostLanguage,
             m_FileDataManager.GetTransportsTypes());
+
+        // a released chunk might be too small for the variable
+        if (m_BP3Serializer.m_Data.m_ChunkSize > 0)
+        {
+            m_BP3Serializer.ResizeBuffer(dataSize, "in call to variable " +
+                                                       variable.m_Name +
+                                                       " PutSync");
+        }
     }
 
     // WRITE INDEX to data buffer and metadata structure (in memory)//
     m_BP3Serializer.PutVariableMetadata(variable);
-    m_BP3Serializer.PutVariablePayload(variable);
+    m_BP3Serializer.PutVariablePayload(variable, zeroCopy);
 }
 
 template <class T>
@@ -58,9 +84,8 @@ void BPFileWriter::PutDeferredCommon(Variable<T> &variable, const T *values)
     variable.SetData(values);
     m_BP3Serializer.m_DeferredVariables.push_back(variable.m_Name);
     m_BP3Serializer.m_DeferredVariablesDataSize +=
-        variable.PayloadSize() +
-        m_BP3Serializer.GetVariableBPIndexSize(variable.m_Name,
-                                               variable.m_Count);
+        m_BP3Serializer.GetPayloadMaxSize(variable) +
+        m_BP3Serializer.GetVariableBPIndexSize(variable);
 }
 
 } // end namespace adios2
@@ -59,20 +59,19 @@ void DataManReader::ReadThread(std::shared_ptr<transportman::DataMan> man)
     {
         format::BP3Deserializer deserializer(m_MPIComm, m_DebugMode);
 
+        deserializer.m_ThreadPool = m_IO.m_ThreadPool;
         deserializer.InitParameters(m_IO.m_Parameters);
 
         while (m_Listening)
         {
-            std::shared_ptr<std::vector<char>> buffer = man->ReadWAN();
+            // waits for a buffer, wakes up now and then to check m_Listening
+            std::shared_ptr<std::vector<char>> buffer = man->ReadWAN(100);
             if (buffer != nullptr)
             {
                 if (buffer->size() > 0)
                 {
-                    deserializer.m_Data.Resize(buffer->size(),
-                                               "in DataMan Streaming Listener");
-
-                    std::memcpy(deserializer.m_Data.m_Buffer.data(),
-                                buffer->data(), buffer->size());
+                    // parse in place, variables are views into buffer
+                    deserializer.m_Data.m_Buffer.swap(*buffer);
 
                     m_MutexIO.lock();
                     deserializer.ParseMetadata(deserializer.m_Data, m_IO);
@@ -140,8 +139,9 @@ v->PayloadSize());
             dmv->shape = v->m_Shape;                                           \
             dmv->start = v->m_Start;                                           \
             dmv->count = v->m_Count;                                           \
-            dmv->data.resize(v->PayloadSize());                                \
-            std::memcpy(dmv->data.data(), v->GetData(), v->PayloadSize());     \
+            dmv->buffer = buffer;                                              \
+            dmv->data = reinterpret_cast<const char *>(v->GetData());          \
+            dmv->size = v->PayloadSize();                                      \
             RunCallback(v->GetData(), "stream", var, type, v->m_Shape);        \
         }                                                                      \
     }
@@ -150,6 +150,8 @@ v->PayloadSize());
 
                         m_VariableMap[0][var] = dmv;
                     }
+                    // same heap storage, views remain valid
+                    deserializer.m_Data.m_Buffer.swap(*buffer);
                 }
             }
         }
@@ -221,18 +223,31 @@ void DataManReader::Init()
 
     // get parameters
     GetUIntParameter(m_IO.m_Parameters, "NChannels", m_NChannels);
+    GetUIntParameter(m_IO.m_Parameters, "NTransports", m_NChannels);
     GetStringParameter(m_IO.m_Parameters, "Format", m_UseFormat);
 
-    // initialize transports
+    // initialize transports, same channels as DataManWriter
 
     m_DataMan = std::make_shared<transportman::DataMan>(m_MPIComm, m_DebugMode);
 
-    size_t channels = m_IO.m_TransportsParameters.size();
+    auto &parameters = m_IO.m_TransportsParameters;
+    while (!parameters.empty() && parameters.size() < m_NChannels)
+    {
+        Params channel(parameters.back());
+        auto itPort = channel.find("Port");
+        if (itPort != channel.end())
+        {
+            itPort->second = std::to_string(std::stoi(itPort->second) + 1);
+        }
+        parameters.push_back(channel);
+    }
+
+    size_t channels = parameters.size();
     std::vector<std::string> names;
     for (size_t i = 0; i < channels; ++i)
     {
         names.push_back(m_Name + std::to_string(i));
-        m_IO.m_TransportsParameters[i]["Name"] = std::to_string(i);
+        parameters[i]["Name"] = std::to_string(i);
     }
 
     m_DataMan->OpenWANTransports(names, Mode::Read, m_IO.m_TransportsParameters,
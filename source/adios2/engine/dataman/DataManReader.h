@@ -62,9 +62,12 @@ private:
     bool m_DoMonitor = false;
     std::vector<adios2::Operator *> m_Callbacks;
 
+    /** view into a received step buffer, kept alive by buffer */
     struct DataManVar
     {
-        std::vector<char> data;
+        std::shared_ptr<std::vector<char>> buffer;
+        const char *data = nullptr;
+        size_t size = 0;
         std::string datatype;
         Dims shape;
         Dims start;
@@ -17,12 +17,40 @@
 namespace adios2
 {
 
+template <>
+inline void DataManReader::GetSyncCommon(Variable<std::string> &variable,
+	std::string *data)
+{
+	auto iter = m_VariableMap[0].find(variable.m_Name);
+	if( iter != m_VariableMap[0].end() ){
+		const DataManVar &dmv = *iter->second;
+		data->assign(dmv.data, dmv.size);
+		m_VariableMap[0].erase( iter );
+	}
+}
+
 template <class T>
 void DataManReader::GetSyncCommon(Variable<T> &variable, T *data)
 {
 	auto iter = m_VariableMap[0].find(variable.m_Name);
 	if( iter != m_VariableMap[0].end() ){
-		std::memcpy(data, iter->second->data.data(), iter->second->data.size());
+		const DataManVar &dmv = *iter->second;
+		if( variable.m_MemoryCount.empty() ){
+			std::memcpy(data, dmv.data, dmv.size);
+		}
+		else{
+			// scatter the received block into the memory selection
+			const bool isRowMajor = IsRowMajor(m_IO.m_HostLanguage);
+			const Box<Dims> memoryBox = StartEndBox(
+				Dims(variable.m_MemoryCount.size(), 0), variable.m_MemoryCount);
+			const Box<Dims> selectionBox =
+				StartEndBox(variable.m_MemoryStart, dmv.count);
+			const size_t memoryOffset =
+				LinearIndex(memoryBox, variable.m_MemoryStart, isRowMajor);
+			CopyMemoryBox(reinterpret_cast<char *>(data + memoryOffset),
+				memoryBox, isRowMajor, dmv.data, selectionBox,
+				isRowMajor, selectionBox, sizeof(T));
+		}
 		m_VariableMap[0].erase( iter );
 	}
 }
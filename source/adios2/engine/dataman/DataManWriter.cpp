@@ -111,10 +111,34 @@ void DataManWriter::InitParameters()
     GetBoolParameter(m_IO.m_Parameters, "Monitoring", m_DoMonitor);
     GetUIntParameter(m_IO.m_Parameters, "NTransports", m_NChannels);
 
+    // Striping=Segments (default) splits each buffer across all channels,
+    // Striping=Steps sends whole buffers round-robin
+    std::string striping("Segments");
+    GetStringParameter(m_IO.m_Parameters, "Striping", striping);
+    std::transform(striping.begin(), striping.end(), striping.begin(),
+                   ::tolower);
+    if (striping == "steps")
+    {
+        m_Man.SetStripeSteps(true);
+    }
+    else if (m_DebugMode && striping != "segments")
+    {
+        throw std::invalid_argument("ERROR: Striping=" + striping +
+                                    " must be Segments or Steps" +
+                                    m_EndMessage);
+    }
+
+    unsigned int segmentSize = 0;
+    if (GetUIntParameter(m_IO.m_Parameters, "SegmentSize", segmentSize))
+    {
+        m_Man.SetSegmentSize(segmentSize);
+    }
+
     // Check if using BP Format and initialize buffer
     GetStringParameter(m_IO.m_Parameters, "Format", m_UseFormat);
     if (m_UseFormat == "BP" || m_UseFormat == "bp")
     {
+        m_BP3Serializer.m_ThreadPool = m_IO.m_ThreadPool;
         m_BP3Serializer.InitParameters(m_IO.m_Parameters);
         m_BP3Serializer.PutProcessGroupIndex(m_IO.m_Name, m_IO.m_HostLanguage,
                                              {"WAN_Zmq"});
@@ -123,16 +147,27 @@ void DataManWriter::InitParameters()
 
 void DataManWriter::InitTransports()
 {
+    // NTransports beyond AddTransport calls are copies of the last one
+    std::vector<Params> parameters(m_IO.m_TransportsParameters);
+    while (!parameters.empty() && parameters.size() < m_NChannels)
+    {
+        Params channel(parameters.back());
+        auto itPort = channel.find("Port");
+        if (itPort != channel.end())
+        {
+            itPort->second = std::to_string(std::stoi(itPort->second) + 1);
+        }
+        parameters.push_back(channel);
+    }
 
-    size_t channels = m_IO.m_TransportsParameters.size();
+    size_t channels = parameters.size();
     std::vector<std::string> names;
     for (size_t i = 0; i < channels; ++i)
     {
         names.push_back(m_Name + std::to_string(i));
     }
 
-    m_Man.OpenWANTransports(names, Mode::Write, m_IO.m_TransportsParameters,
-                            true);
+    m_Man.OpenWANTransports(names, Mode::Write, parameters, true);
 }
 
 void DataManWriter::Init()
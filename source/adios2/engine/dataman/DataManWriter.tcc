@@ -82,9 +82,8 @@ void DataManWriter::PutSyncCommonBP(Variable<T> &variable, const T *values)
                                              {"WAN_Zmq"});
     }
 
-    const size_t dataSize = variable.PayloadSize() +
-                            m_BP3Serializer.GetVariableBPIndexSize(
-                                variable.m_Name, variable.m_Count);
+    const size_t dataSize = m_BP3Serializer.GetPayloadMaxSize(variable) +
+                            m_BP3Serializer.GetVariableBPIndexSize(variable);
     format::BP3Base::ResizeResult resizeResult = m_BP3Serializer.ResizeBuffer(
         dataSize, "in call to variable " + variable.m_Name + " PutSync");
 
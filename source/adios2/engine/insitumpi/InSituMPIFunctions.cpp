@@ -13,6 +13,8 @@
 
 #include "InSituMPIFunctions.h"
 
+#include "adios2/helper/adiosMath.h" //LinearIndex, GetTotalSize
+
 #include <chrono>
 #include <fstream>
 #include <iostream>
@@ -201,6 +203,75 @@ int ConnectDirectPeers(const MPI_Comm commWorld, const bool IAmSender,
     return writeRootGlobalRank;
 }
 
+MPI_Datatype GetBoxDatatype(const Box<Dims> &memoryBox, const Box<Dims> &box,
+                            const bool isRowMajor, const size_t elementSize,
+                            size_t &offset, int &count)
+{
+    const size_t ndims = box.first.size();
+    Dims memoryCount(ndims);
+    Dims boxCount(ndims);
+    for (size_t d = 0; d < ndims; ++d)
+    {
+        memoryCount[d] = memoryBox.second[d] - memoryBox.first[d] + 1;
+        boxCount[d] = box.second[d] - box.first[d] + 1;
+    }
+
+    // contiguous: dimensions faster than the first partial one are whole,
+    // the slower ones have a single element
+    bool isContiguous = true;
+    bool isPartial = false;
+    for (size_t i = 0; i < ndims; ++i)
+    {
+        const size_t d = isRowMajor ? ndims - 1 - i : i;
+        if (isPartial && boxCount[d] > 1)
+        {
+            isContiguous = false;
+            break;
+        }
+        if (boxCount[d] != memoryCount[d])
+        {
+            isPartial = true;
+        }
+    }
+
+    if (isContiguous)
+    {
+        offset = 0;
+        if (ndims > 0)
+        {
+            offset =
+                LinearIndex(memoryBox, box.first, isRowMajor) * elementSize;
+        }
+        count = static_cast<int>(GetTotalSize(boxCount) * elementSize);
+        return MPI_CHAR;
+    }
+
+    std::vector<int> sizes(ndims);
+    std::vector<int> subsizes(ndims);
+    std::vector<int> starts(ndims);
+    for (size_t d = 0; d < ndims; ++d)
+    {
+        sizes[d] = static_cast<int>(memoryCount[d]);
+        subsizes[d] = static_cast<int>(boxCount[d]);
+        starts[d] = static_cast<int>(box.first[d] - memoryBox.first[d]);
+    }
+
+    MPI_Datatype elementType;
+    MPI_Type_contiguous(static_cast<int>(elementSize), MPI_CHAR, &elementType);
+
+    MPI_Datatype boxType;
+    MPI_Type_create_subarray(static_cast<int>(ndims), sizes.data(),
+                             subsizes.data(), starts.data(),
+                             isRowMajor ? MPI_ORDER_C : MPI_ORDER_FORTRAN,
+                             elementType, &boxType);
+    MPI_Type_commit(&boxType);
+    MPI_Type_free(&elementType);
+
+    offset = 0;
+    count = 1;
+    return boxType;
+}
+
 } // end namespace insitumpi
 
 } // end namespace adios2
@@ -18,6 +18,8 @@
 #include <string>
 #include <vector>
 
+#include "adios2/ADIOSTypes.h"
+
 namespace adios2
 {
 
@@ -63,6 +65,17 @@ int ConnectDirectPeers(const MPI_Comm commWorld, const bool IAmSender,
                        const bool IAmWriterRoot, const int globalRank,
                        const std::vector<int> &peers);
 
+// Describes the elements of box inside a memory block for one send or
+// receive, so only the requested elements cross the network.
+// memoryBox and box are {start, end} in global coordinates, box is inside
+// memoryBox. If box is contiguous in memory, returns MPI_CHAR with offset
+// the bytes to its first element and count its bytes. Otherwise returns a
+// committed subarray datatype with offset 0 and count 1, that the caller
+// frees with MPI_Type_free once the request is posted.
+MPI_Datatype GetBoxDatatype(const Box<Dims> &memoryBox, const Box<Dims> &box,
+                            const bool isRowMajor, const size_t elementSize,
+                            size_t &offset, int &count);
+
 } // end namespace insitumpi
 
 } // end namespace adios2
@@ -220,6 +220,11 @@ void InSituMPIReader::PerformGets()
         // Make the receive requests for each variable
         AsyncRecvAllVariables();
     }
+    else
+    {
+        // Same schedule, into the user pointers of this step
+        AsyncRecvAllVariables();
+    }
 
     ProcessReceives();
 
@@ -264,7 +269,8 @@ void InSituMPIReader::SendReadSchedule(
         insitumpi::SerializeLocalReadSchedule(m_RankAllPeers.size(),
                                               variablesSubFileInfo);
 
-    std::vector<MPI_Request> request(m_RankAllPeers.size());
+    // length and schedule requests per writer
+    std::vector<MPI_Request> request(2 * m_RankAllPeers.size());
     std::vector<int> mdLen(m_RankAllPeers.size());
     for (int i = 0; i < m_RankAllPeers.size(); i++)
     {
@@ -278,13 +284,13 @@ void InSituMPIReader::SendReadSchedule(
         }
         MPI_Isend(&(mdLen[i]), 1, MPI_INT, m_RankAllPeers[i],
                   insitumpi::MpiTags::ReadScheduleLength, m_CommWorld,
-                  &(request[i]));
+                  &(request[2 * i]));
         MPI_Isend(serializedSchedules[i].data(), mdLen[i], MPI_CHAR,
                   m_RankAllPeers[i], insitumpi::MpiTags::ReadSchedule,
-                  m_CommWorld, &(request[i]));
+                  m_CommWorld, &(request[2 * i + 1]));
     }
-    std::vector<MPI_Status> status(m_RankAllPeers.size());
-    MPI_Waitall(m_RankAllPeers.size(), request.data(), status.data());
+    std::vector<MPI_Status> status(request.size());
+    MPI_Waitall(request.size(), request.data(), status.data());
 }
 
 void InSituMPIReader::AsyncRecvAllVariables()
@@ -339,8 +345,9 @@ void InSituMPIReader::ProcessReceives()
                     const std::string *name =
                         m_OngoingReceives[index].varNamePointer;
 
+                    // the intersection arrives packed
                     m_BP3Deserializer.ClipContiguousMemory(
-                        *name, m_IO, rawData, sfi->BlockBox,
+                        *name, m_IO, rawData, sfi->IntersectionBox,
                         sfi->IntersectionBox);
                 }
                 // MPI_Request_free(&m_MPIRequests[index]); // not required???
@@ -53,15 +53,9 @@ void InSituMPIReader::GetDeferredCommon(Variable<T> &variable, T *data)
     }
     if (m_FixedSchedule && m_CurrentStep > 0)
     {
-        // Create the async send for the variable now
-        const SubFileInfoMap &sfim =
-            m_BP3Deserializer.GetSubFileInfoMap(variable.m_Name);
-        /* FIXME: this only works if there is only one block read for each
-         * variable.
-         * SubFileInfoMap contains ALL read schedules for the variable.
-         * We should do this call per SubFileInfo that matches the request
-         */
-        AsyncRecvVariable(variable, sfim);
+        // The receives are posted in PerformGets() in schedule order, the
+        // order the writers send in
+        variable.SetData(data);
         m_BP3Deserializer.m_PerformedGets = false;
     }
     else
@@ -100,50 +94,76 @@ void InSituMPIReader::AsyncRecvVariable(const Variable<T> &variable,
                     std::cout << std::endl;
                 }
 
-                const auto &seek = sfi.Seeks;
-                const size_t blockStart = seek.first;
-                const size_t blockSize = seek.second - seek.first;
+                // writers send only the intersection, in their layout
+                const Box<Dims> &intersection = sfi.IntersectionBox;
+                size_t intersectionSize = sizeof(T);
+                for (size_t d = 0; d < intersection.first.size(); ++d)
+                {
+                    intersectionSize *=
+                        intersection.second[d] - intersection.first[d] + 1;
+                }
                 m_MPIRequests.emplace_back();
                 const int index = m_MPIRequests.size() - 1;
-                size_t elementOffset, dummy;
 
-                // Do we read a contiguous piece from the source?
-                // and do we write a contiguous piece into the user data?
-                if (IsIntersectionContiguousSubarray(
-                        sfi.BlockBox, sfi.IntersectionBox, dummy) &&
-                    IsIntersectionContiguousSubarray(
-                        StartEndBox(variable.m_Start, variable.m_Count),
-                        sfi.IntersectionBox, elementOffset))
+                if (!m_BP3Deserializer.m_ReverseDimensions)
                 {
-                    // Receive in place (of user data pointer)
-                    // const size_t startOffset =
-                    //    elementOffset * variable.m_ElementSize;
-                    T *inPlacePointer = variable.GetData() + elementOffset;
-                    T *ptrT = const_cast<T *>(inPlacePointer);
-                    char *ptr = reinterpret_cast<char *>(ptrT);
+                    // Receive in place, into the selection or the memory
+                    // selection of the user data
+                    Box<Dims> memoryBox;
+                    if (variable.m_MemoryCount.empty())
+                    {
+                        memoryBox =
+                            StartEndBox(variable.m_Start, variable.m_Count);
+                    }
+                    else
+                    {
+                        // start may wrap around, only differences are used
+                        Dims memoryStart(variable.m_Start);
+                        for (size_t d = 0; d < memoryStart.size(); ++d)
+                        {
+                            memoryStart[d] -= variable.m_MemoryStart[d];
+                        }
+                        memoryBox =
+                            StartEndBox(memoryStart, variable.m_MemoryCount);
+                    }
+
+                    size_t offset;
+                    int count;
+                    MPI_Datatype datatype = insitumpi::GetBoxDatatype(
+                        memoryBox, sfi.IntersectionBox,
+                        m_BP3Deserializer.m_IsRowMajor, sizeof(T), offset,
+                        count);
+
+                    char *ptr = reinterpret_cast<char *>(
+                                    const_cast<T *>(variable.GetData())) +
+                                offset;
                     m_OngoingReceives.emplace_back(&sfi, &variable.m_Name, ptr);
-                    MPI_Irecv(m_OngoingReceives[index].inPlaceDataArray,
-                              blockSize, MPI_CHAR, m_RankAllPeers[writerRank],
+                    MPI_Irecv(m_OngoingReceives[index].inPlaceDataArray, count,
+                              datatype, m_RankAllPeers[writerRank],
                               insitumpi::MpiTags::Data, m_CommWorld,
                               m_MPIRequests.data() + index);
+                    if (datatype != MPI_CHAR)
+                    {
+                        MPI_Type_free(&datatype);
+                    }
                     if (m_Verbosity == 5)
                     {
-                        std::cout
-                            << "InSituMPI Reader " << m_ReaderRank
-                            << " requested in-place receive to element offset "
-                            << elementOffset << std::endl;
+                        std::cout << "InSituMPI Reader " << m_ReaderRank
+                                  << " requested in-place receive to byte "
+                                     "offset "
+                                  << offset << std::endl;
                     }
-                    m_BytesReceivedInPlace += blockSize;
+                    m_BytesReceivedInPlace += intersectionSize;
                 }
                 else
                 {
                     // Receive in temporary array and copy in later
                     m_OngoingReceives.emplace_back(&sfi, &variable.m_Name);
                     m_OngoingReceives[index].temporaryDataArray.resize(
-                        blockSize);
+                        intersectionSize);
                     MPI_Irecv(
                         m_OngoingReceives[index].temporaryDataArray.data(),
-                        blockSize, MPI_CHAR, m_RankAllPeers[writerRank],
+                        intersectionSize, MPI_CHAR, m_RankAllPeers[writerRank],
                         insitumpi::MpiTags::Data, m_CommWorld,
                         m_MPIRequests.data() + index);
                     if (m_Verbosity == 5)
@@ -152,7 +172,7 @@ void InSituMPIReader::AsyncRecvVariable(const Variable<T> &variable,
                                   << " requested receive into temporary area"
                                   << std::endl;
                     }
-                    m_BytesReceivedInTemporary += blockSize;
+                    m_BytesReceivedInTemporary += intersectionSize;
                 }
             }
             break; // there is only one step here
@@ -18,6 +18,7 @@
 #include "InSituMPIWriter.h"
 #include "InSituMPIWriter.tcc"
 
+#include <algorithm> //std::find_if
 #include <iostream>
 
 namespace adios2
@@ -30,6 +31,7 @@ InSituMPIWriter::InSituMPIWriter(IO &io, const std::string &name,
 {
     m_EndMessage = " in call to InSituMPIWriter " + m_Name + " Open\n";
     Init();
+    m_BP3Serializer.m_ThreadPool = m_IO.m_ThreadPool;
     m_BP3Serializer.InitParameters(m_IO.m_Parameters);
 
     m_RankAllPeers = insitumpi::FindPeers(mpiComm, m_Name, true, m_CommWorld);
@@ -76,15 +78,17 @@ StepStatus InSituMPIWriter::BeginStep(StepMode mode, const float timeoutSeconds)
                   << std::endl;
     }
     // Send the step to all reader peers, asynchronously
-    // we don't care about keeping these requests
-    MPI_Request request;
+    // m_CurrentStep doesn't change until these complete in EndStep()
     for (auto peerRank : m_RankDirectPeers)
     {
+        m_MPIRequests.emplace_back();
         MPI_Isend(&m_CurrentStep, 1, MPI_INT, peerRank,
-                  insitumpi::MpiTags::Step, m_CommWorld, &request);
+                  insitumpi::MpiTags::Step, m_CommWorld,
+                  &m_MPIRequests.back());
     }
 
     m_NCallsPerformPuts = 0;
+    m_NextReaderRequest.assign(m_ReaderRequests.size(), 0);
     m_BP3Serializer.m_DeferredVariables.clear();
     m_BP3Serializer.m_DeferredVariablesDataSize = 0;
 
@@ -124,12 +128,10 @@ void InSituMPIWriter::PerformPuts()
         m_BP3Serializer.AggregateCollectiveMetadata();
 
         // store length long enough to survive Isend() completion
-        // so don't move this into the next if branch
-        unsigned long mdLen = m_BP3Serializer.m_Metadata.m_Position;
+        m_MetadataLength = m_BP3Serializer.m_Metadata.m_Position;
 
-        // Send the metadata to all reader peers, asynchronously
-        // we don't care about keeping these requests because
-        // we will wait next for response from all readers
+        // Send the metadata to the reader root, asynchronously, the
+        // requests and the metadata buffer are kept until EndStep()
         if (m_BP3Serializer.m_RankMPI == 0)
         {
             if (m_Verbosity == 5)
@@ -137,11 +139,12 @@ void InSituMPIWriter::PerformPuts()
                 std::cout << "InSituMPI Writer " << m_WriterRank
                           << " Metadata has = "
                           << m_BP3Serializer.m_MetadataSet.DataPGVarsCount
-                          << " variables. size = "
-                          << m_BP3Serializer.m_Metadata.m_Position << std::endl;
+                          << " variables. size = " << m_MetadataLength
+                          << std::endl;
             }
 
-            // FIXME: Which reader is actually listening for this request?
+            // the reader root is the first direct peer of the writer root,
+            // it broadcasts the metadata to the other readers
             if (m_Verbosity == 5)
             {
                 std::cout << "InSituMPI Writer " << m_WriterRank
@@ -149,100 +152,166 @@ void InSituMPIWriter::PerformPuts()
                           << " sends metadata to Reader World rank = "
                           << m_RankDirectPeers[0] << std::endl;
             }
-            MPI_Request request;
-            // for (auto peerRank : m_RankDirectPeers)
-            auto peerRank = m_RankDirectPeers[0];
-            MPI_Isend(&mdLen, 1, MPI_UNSIGNED_LONG, peerRank,
+            const int peerRank = m_RankDirectPeers[0];
+            m_MPIRequests.emplace_back();
+            MPI_Isend(&m_MetadataLength, 1, MPI_UNSIGNED_LONG, peerRank,
                       insitumpi::MpiTags::MetadataLength, m_CommWorld,
-                      &request);
-            MPI_Isend(m_BP3Serializer.m_Metadata.m_Buffer.data(), mdLen,
-                      MPI_CHAR, peerRank, insitumpi::MpiTags::Metadata,
-                      m_CommWorld, &request);
+                      &m_MPIRequests.back());
+            m_MPIRequests.emplace_back();
+            MPI_Isend(m_BP3Serializer.m_Metadata.m_Buffer.data(),
+                      m_MetadataLength, MPI_CHAR, peerRank,
+                      insitumpi::MpiTags::Metadata, m_CommWorld,
+                      &m_MPIRequests.back());
         }
 
-        // Collect the read requests from ALL readers
-        // FIXME: How do we make this Irecv from all readers
-        // std::vector<MPI_Request> requests(m_RankAllPeers.size());
-        std::vector<MPI_Status> statuses(m_RankAllPeers.size());
-        std::vector<std::vector<char>> serializedSchedules(
-            m_RankAllPeers.size());
-        for (int peerID = 0; peerID < m_RankAllPeers.size(); peerID++)
+        // Collect the read requests from ALL readers asynchronously, the
+        // variables are sent to each reader as soon as its schedule arrives
+        m_WriteScheduleMap.clear();
+        PostReadScheduleReceives();
+        ProcessReadSchedules(false);
+    }
+}
+
+void InSituMPIWriter::PostReadScheduleReceives()
+{
+    const size_t nReaders = m_RankAllPeers.size();
+    m_ReadScheduleLengths.assign(nReaders, 0);
+    m_SerializedSchedules.assign(nReaders, std::vector<char>());
+    m_ScheduleRequests.assign(nReaders, MPI_REQUEST_NULL);
+    m_ScheduleLengthReceived.assign(nReaders, false);
+    m_ReaderRequests.assign(nReaders, {});
+    m_NextReaderRequest.assign(nReaders, 0);
+
+    for (size_t peerID = 0; peerID < nReaders; ++peerID)
+    {
+        MPI_Irecv(&m_ReadScheduleLengths[peerID], 1, MPI_INT,
+                  m_RankAllPeers[peerID],
+                  insitumpi::MpiTags::ReadScheduleLength, m_CommWorld,
+                  &m_ScheduleRequests[peerID]);
+    }
+}
+
+void InSituMPIWriter::ProcessReadSchedules(const bool wait)
+{
+    while (true)
+    {
+        int peerID = MPI_UNDEFINED;
+        int completed = 0;
+        MPI_Status status;
+
+        if (wait)
         {
-            int rsLen;
-            MPI_Recv(&rsLen, 1, MPI_INT, m_RankAllPeers[peerID],
-                     insitumpi::MpiTags::ReadScheduleLength, m_CommWorld,
-                     &statuses[peerID]);
-            serializedSchedules[peerID].resize(rsLen);
-            MPI_Recv(serializedSchedules[peerID].data(), rsLen, MPI_CHAR,
-                     m_RankAllPeers[peerID], insitumpi::MpiTags::ReadSchedule,
-                     m_CommWorld, &statuses[peerID]);
-            if (m_Verbosity == 5)
-            {
-                std::cout << "InSituMPI Writer " << m_WriterRank
-                          << " received read schedule from Reader  " << peerID
-                          << " global rank " << m_RankAllPeers[peerID]
-                          << " length = " << rsLen << std::endl;
-            }
+            MPI_Waitany(static_cast<int>(m_ScheduleRequests.size()),
+                        m_ScheduleRequests.data(), &peerID, &status);
+            completed = (peerID != MPI_UNDEFINED);
+        }
+        else
+        {
+            MPI_Testany(static_cast<int>(m_ScheduleRequests.size()),
+                        m_ScheduleRequests.data(), &peerID, &completed,
+                        &status);
+            completed = completed && (peerID != MPI_UNDEFINED);
         }
 
-        // build (and remember for fixed schedule) the read request table
-        // std::map<std::string, std::map<size_t, std::vector<SubFileInfo>>>
-        // map
-        m_WriteScheduleMap.clear();
-        m_WriteScheduleMap =
-            insitumpi::DeserializeReadSchedule(serializedSchedules);
-        if (m_Verbosity == 5)
+        if (!completed)
         {
-            std::cout << "InSituMPI Writer " << m_WriterRank << " schedule:  ";
-            insitumpi::PrintReadScheduleMap(m_WriteScheduleMap);
-            std::cout << std::endl;
+            break;
         }
 
-        const int nRequests = insitumpi::GetNumberOfRequestsInWriteScheduleMap(
-            m_WriteScheduleMap);
-        m_MPIRequests.reserve(nRequests);
+        if (!m_ScheduleLengthReceived[peerID])
+        {
+            // length arrived, receive the schedule in the same slot
+            m_ScheduleLengthReceived[peerID] = true;
+            const int rsLen = m_ReadScheduleLengths[peerID];
+            m_SerializedSchedules[peerID].resize(rsLen);
+            MPI_Irecv(m_SerializedSchedules[peerID].data(), rsLen, MPI_CHAR,
+                      m_RankAllPeers[peerID], insitumpi::MpiTags::ReadSchedule,
+                      m_CommWorld, &m_ScheduleRequests[peerID]);
+            continue;
+        }
 
-        // Make the send requests for each variable for each matching peer
-        // request
-        for (const auto &variableName : m_BP3Serializer.m_DeferredVariables)
+        if (m_Verbosity == 5)
         {
-            // Create the async send for the variable
-            AsyncSendVariable(variableName);
+            std::cout << "InSituMPI Writer " << m_WriterRank
+                      << " received read schedule from Reader  " << peerID
+                      << " global rank " << m_RankAllPeers[peerID]
+                      << " length = " << m_ReadScheduleLengths[peerID]
+                      << std::endl;
         }
-    }
 
-    m_BP3Serializer.m_DeferredVariables.clear();
-    if (m_CurrentStep == 0 || !m_FixedSchedule)
-    {
-        m_BP3Serializer.ResetBuffer(m_BP3Serializer.m_Data, true);
-        m_BP3Serializer.ResetBuffer(m_BP3Serializer.m_Metadata, true);
-        // FIXME: Somehow m_MetadataSet should be clean up too
+        // add this reader to (and remember for fixed schedule) the read
+        // request table
+        const insitumpi::LocalReadScheduleMap localSchedule =
+            insitumpi::DeserializeReadSchedule(m_SerializedSchedules[peerID]);
+        for (const auto &variableSchedule : localSchedule)
+        {
+            std::vector<SubFileInfo> &sfis =
+                m_WriteScheduleMap[variableSchedule.first][peerID];
+            sfis = variableSchedule.second;
+
+            for (const auto &sfi : sfis)
+            {
+                m_ReaderRequests[peerID].emplace_back(variableSchedule.first,
+                                                      &sfi);
+            }
+        }
+        m_SerializedSchedules[peerID].clear();
+
+        // Make the send requests for the blocks requested by this reader
+        AsyncSendRequests(peerID);
     }
 }
 
-void InSituMPIWriter::AsyncSendVariable(std::string variableName)
+void InSituMPIWriter::AsyncSendRequests(const size_t peerID)
 {
-    const std::string type(m_IO.InquireVariableType(variableName));
+    const bool isRowMajor = IsRowMajor(m_IO.m_HostLanguage);
+    const auto &requests = m_ReaderRequests[peerID];
+    size_t &next = m_NextReaderRequest[peerID];
 
-    if (type == "compound")
+    for (; next < requests.size(); ++next)
     {
-        // not supported
-    }
-#define declare_template_instantiation(T)                                      \
-    else if (type == adios2::GetType<T>())                                     \
-    {                                                                          \
-        Variable<T> *variable = m_IO.InquireVariable<T>(variableName);         \
-        if (m_DebugMode && variable == nullptr)                                \
-        {                                                                      \
-            throw std::invalid_argument(                                       \
-                "ERROR: variable " + variableName +                            \
-                " not found, in call to AsyncSendVariable\n");                 \
-        }                                                                      \
-        AsyncSendVariable<T>(*variable);                                       \
-    }
+        const std::string &variableName = requests[next].first;
+        const SubFileInfo &sfi = *requests[next].second;
+
+        auto itBlock = std::find_if(
+            m_PutBlocks.begin(), m_PutBlocks.end(),
+            [&](const PutBlock &block) {
+                return block.VariableName == variableName &&
+                       IdenticalBoxes(block.BlockBox, sfi.BlockBox);
+            });
+        if (itBlock == m_PutBlocks.end())
+        {
+            break;
+        }
+        const PutBlock &block = *itBlock;
+
+        if (m_Verbosity == 5)
+        {
+            std::cout << "InSituMPI Writer " << m_WriterRank
+                      << " async send var = " << variableName << " to reader "
+                      << peerID << " block=";
+            insitumpi::PrintBox(block.BlockBox);
+            std::cout << " info = ";
+            insitumpi::PrintSubFileInfo(sfi);
+            std::cout << std::endl;
+        }
+
+        size_t offset;
+        int count;
+        MPI_Datatype datatype = insitumpi::GetBoxDatatype(
+            block.MemoryBox, sfi.IntersectionBox, isRowMajor,
+            block.ElementSize, offset, count);
 
-    ADIOS2_FOREACH_TYPE_1ARG(declare_template_instantiation)
-#undef declare_template_instantiation
+        m_MPIRequests.emplace_back();
+        MPI_Isend(block.Data + offset, count, datatype, m_RankAllPeers[peerID],
+                  insitumpi::MpiTags::Data, m_CommWorld,
+                  &m_MPIRequests.back());
+
+        if (datatype != MPI_CHAR)
+        {
+            MPI_Type_free(&datatype);
+        }
+    }
 }
 
 void InSituMPIWriter::EndStep()
@@ -251,12 +320,42 @@ void InSituMPIWriter::EndStep()
     {
         std::cout << "InSituMPI Writer " << m_WriterRank << " EndStep()\n";
     }
-    if (m_BP3Serializer.m_DeferredVariables.size() > 0)
+    if (m_NCallsPerformPuts == 0 &&
+        m_BP3Serializer.m_DeferredVariables.size() > 0)
     {
         PerformPuts();
     }
 
-    // TODO: Blocking wait for all data transfers to finish
+    // serve the readers in the order their schedules arrive
+    if (m_CurrentStep == 0 || !m_FixedSchedule)
+    {
+        ProcessReadSchedules(true);
+        if (m_Verbosity == 5)
+        {
+            std::cout << "InSituMPI Writer " << m_WriterRank << " schedule:  ";
+            insitumpi::PrintReadScheduleMap(m_WriteScheduleMap);
+            std::cout << std::endl;
+        }
+    }
+
+    // sends to a reader stop at the first requested block that was not put,
+    // the reader would wait forever for it and the blocks after it
+    for (size_t peerID = 0; peerID < m_ReaderRequests.size(); ++peerID)
+    {
+        const size_t next = m_NextReaderRequest[peerID];
+        if (next < m_ReaderRequests[peerID].size())
+        {
+            throw std::runtime_error(
+                "ERROR: InSituMPI Writer " + std::to_string(m_WriterRank) +
+                " did not put the block of variable " +
+                m_ReaderRequests[peerID][next].first +
+                " requested by reader " + std::to_string(peerID) +
+                " in step " + std::to_string(m_CurrentStep) +
+                ", in call to EndStep\n");
+        }
+    }
+
+    // Blocking wait for all step, metadata and data transfers to finish
     const int nRequests = m_MPIRequests.size();
     std::vector<MPI_Status> statuses(nRequests);
     int ierr;
@@ -285,6 +384,15 @@ void InSituMPIWriter::EndStep()
     }
 
     m_MPIRequests.clear();
+    m_PutBlocks.clear();
+
+    m_BP3Serializer.m_DeferredVariables.clear();
+    if (m_CurrentStep == 0 || !m_FixedSchedule)
+    {
+        m_BP3Serializer.ResetBuffer(m_BP3Serializer.m_Data, true);
+        m_BP3Serializer.ResetBuffer(m_BP3Serializer.m_Metadata, true);
+        // FIXME: Somehow m_MetadataSet should be clean up too
+    }
 }
 
 // PRIVATE
@@ -350,13 +458,15 @@ void InSituMPIWriter::DoClose(const int transportIndex)
                   << ")\n";
     }
     m_CurrentStep = -1; // -1 will indicate end of stream
-    // Send -1 to all reader peers, asynchronously
-    MPI_Request request;
-    for (auto peerRank : m_RankDirectPeers)
+    // Send -1 to all reader peers, m_CurrentStep must outlive the sends
+    std::vector<MPI_Request> requests(m_RankDirectPeers.size());
+    for (size_t i = 0; i < m_RankDirectPeers.size(); ++i)
     {
-        MPI_Isend(&m_CurrentStep, 1, MPI_INT, peerRank,
-                  insitumpi::MpiTags::Step, m_CommWorld, &request);
+        MPI_Isend(&m_CurrentStep, 1, MPI_INT, m_RankDirectPeers[i],
+                  insitumpi::MpiTags::Step, m_CommWorld, &requests[i]);
     }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+                MPI_STATUSES_IGNORE);
 }
 
 } // end namespace adios2
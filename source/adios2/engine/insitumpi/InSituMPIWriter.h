@@ -70,7 +70,43 @@ private:
      */
     insitumpi::WriteScheduleMap m_WriteScheduleMap;
 
-    std::vector<MPI_Request> m_MPIRequests; // for MPI_Waitall in EndStep()
+    /** step, metadata and data sends, for MPI_Waitall in EndStep() */
+    std::vector<MPI_Request> m_MPIRequests;
+
+    /** A block put in the current step, any number per variable */
+    struct PutBlock
+    {
+        std::string VariableName;
+        /** start and end of the block in the global array */
+        Box<Dims> BlockBox;
+        /** start and end of the memory holding the block, larger than
+         * BlockBox with a memory selection, start may wrap around */
+        Box<Dims> MemoryBox;
+        const char *Data;
+        size_t ElementSize;
+    };
+
+    /** blocks put in the current step */
+    std::vector<PutBlock> m_PutBlocks;
+
+    /** per reader, variable and request in the order the reader posts its
+     * receives, messages match in this order. Requests point into
+     * m_WriteScheduleMap */
+    std::vector<std::vector<std::pair<std::string, const SubFileInfo *>>>
+        m_ReaderRequests;
+
+    /** per reader, index of the next request in m_ReaderRequests to send */
+    std::vector<size_t> m_NextReaderRequest;
+
+    /** metadata length sent to the reader root, must outlive the send */
+    unsigned long m_MetadataLength = 0;
+
+    /** Read schedule exchange, one entry per reader in m_RankAllPeers.
+     * A request is the length receive first, then the schedule receive */
+    std::vector<MPI_Request> m_ScheduleRequests;
+    std::vector<int> m_ReadScheduleLengths;
+    std::vector<std::vector<char>> m_SerializedSchedules;
+    std::vector<bool> m_ScheduleLengthReceived;
 
     void Init() final;
     void InitParameters() final;
@@ -102,14 +138,28 @@ private:
     template <class T>
     void PutDeferredCommon(Variable<T> &variable, const T *values);
 
-    /** Send data asynchronously of a variable to all readers that
-     * has requested a piece
-     * void AsyncSendVariable(const std::string &varName);
-     */
     template <class T>
-    void AsyncSendVariable(Variable<T> &);
+    PutBlock GetPutBlock(const Variable<T> &variable) const;
+
+    /**
+     * Sends asynchronously, in order, the requests of a reader whose blocks
+     * were put, stops at the first request whose block is not put yet.
+     * Only the requested elements of a block are sent.
+     * @param peerID index in m_RankAllPeers
+     */
+    void AsyncSendRequests(const size_t peerID);
 
-    void AsyncSendVariable(std::string variableName);
+    /** Posts the read schedule length receives from all readers */
+    void PostReadScheduleReceives();
+
+    /**
+     * Handles the read schedule receives in completion order, a complete
+     * schedule is added to m_WriteScheduleMap and the blocks already put
+     * are sent to that reader right away
+     * @param wait true: until all schedules arrived, false: only the
+     * receives already completed
+     */
+    void ProcessReadSchedules(const bool wait);
 };
 
 } // end namespace adios2
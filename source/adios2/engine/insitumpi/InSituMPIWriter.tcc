@@ -36,8 +36,7 @@ void InSituMPIWriter::PutDeferredCommon(Variable<T> &variable, const T *values)
                   << variable.m_Name << ")\n";
     }
 
-    const size_t dataSize = m_BP3Serializer.GetVariableBPIndexSize(
-        variable.m_Name, variable.m_Count);
+    const size_t dataSize = m_BP3Serializer.GetVariableBPIndexSize(variable);
     format::BP3Base::ResizeResult resizeResult = m_BP3Serializer.ResizeBuffer(
         dataSize, "in call to variable " + variable.m_Name + " PutSync");
 
@@ -53,59 +52,47 @@ void InSituMPIWriter::PutDeferredCommon(Variable<T> &variable, const T *values)
     // function call
     m_BP3Serializer.PutVariableMetadata(variable);
 
+    m_PutBlocks.push_back(GetPutBlock(variable));
+
     if (m_FixedSchedule && m_CurrentStep > 0)
     {
-        // Create the async send for the variable now
-        AsyncSendVariable(variable);
+        // Create the async sends that wait for this block now
+        for (size_t peerID = 0; peerID < m_ReaderRequests.size(); ++peerID)
+        {
+            AsyncSendRequests(peerID);
+        }
     }
     else
     {
-        // Remember this variable to make the send request in PerformPuts()
+        // Remember this variable to make the send requests in PerformPuts()
         m_BP3Serializer.m_DeferredVariables.push_back(variable.m_Name);
     }
 }
 
 template <class T>
-void InSituMPIWriter::AsyncSendVariable(Variable<T> &variable)
+InSituMPIWriter::PutBlock
+InSituMPIWriter::GetPutBlock(const Variable<T> &variable) const
 {
-    const auto it = m_WriteScheduleMap.find(variable.m_Name);
-    if (it != m_WriteScheduleMap.end())
+    PutBlock block;
+    block.VariableName = variable.m_Name;
+    block.BlockBox = StartEndBox(variable.m_Start, variable.m_Count);
+    block.Data = reinterpret_cast<const char *>(variable.GetData());
+    block.ElementSize = sizeof(T);
+
+    if (variable.m_MemoryCount.empty())
+    {
+        block.MemoryBox = block.BlockBox;
+    }
+    else
     {
-        std::map<size_t, std::vector<SubFileInfo>> requests = it->second;
-        Box<Dims> mybox = StartEndBox(variable.m_Start, variable.m_Count);
-        for (const auto &readerPair : requests)
+        Dims memoryStart(variable.m_Start);
+        for (size_t d = 0; d < memoryStart.size(); ++d)
         {
-            for (const auto &sfi : readerPair.second)
-            {
-                if (IdenticalBoxes(mybox, sfi.BlockBox))
-                {
-                    if (m_Verbosity == 5)
-                    {
-                        std::cout << "InSituMPI Writer " << m_WriterRank
-                                  << " async send var = " << variable.m_Name
-                                  << " to reader " << readerPair.first
-                                  << " block=";
-                        insitumpi::PrintBox(mybox);
-                        std::cout << " info = ";
-                        insitumpi::PrintSubFileInfo(sfi);
-                        std::cout << std::endl;
-                    }
-
-                    m_MPIRequests.emplace_back();
-                    const int index = m_MPIRequests.size() - 1;
-
-                    const auto &seek = sfi.Seeks;
-                    const size_t blockStart = seek.first;
-                    const size_t blockSize = seek.second - seek.first;
-
-                    MPI_Isend(variable.GetData() + blockStart, blockSize,
-                              MPI_CHAR, m_RankAllPeers[readerPair.first],
-                              insitumpi::MpiTags::Data, m_CommWorld,
-                              m_MPIRequests.data() + index);
-                }
-            }
+            memoryStart[d] -= variable.m_MemoryStart[d];
         }
+        block.MemoryBox = StartEndBox(memoryStart, variable.m_MemoryCount);
     }
+    return block;
 }
 
 } // end namespace adios2
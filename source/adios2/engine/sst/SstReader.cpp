@@ -10,6 +10,7 @@
 
 #include "adios2/helper/adiosFunctions.h"
 #include <cstring>
+#include <stdexcept> //std::invalid_argument, std::runtime_error
 #include <string>
 
 #include "SstReader.h"
@@ -25,7 +26,30 @@ SstReader::SstReader(IO &io, const std::string &name, const Mode mode,
     char *cstr = new char[name.length() + 1];
     std::strcpy(cstr, name.c_str());
 
-    m_Input = SstReaderOpen(cstr, NULL, mpiComm);
+    // control plane parameters, as comma separated Key=Value pairs
+    std::string params;
+    for (const auto &parameter : m_IO.m_Parameters)
+    {
+        params += parameter.first + "=" + parameter.second + ",";
+    }
+
+    m_Input = SstReaderOpen(cstr, params.c_str(), mpiComm);
+    if (m_Input == nullptr)
+    {
+        delete[] cstr;
+        throw std::invalid_argument("ERROR: SstReader failed to open stream " +
+                                    m_Name + ", check DataTransport "
+                                             "parameter, in call to Open\n");
+    }
+    if (SstReaderMarshalMethod(m_Input) == SstMarshalBP)
+    {
+        SstReaderClose(m_Input);
+        delete[] cstr;
+        throw std::invalid_argument("ERROR: SstReader stream " + m_Name +
+                                    " is written with MarshalMethod=BP, "
+                                    "BP marshaling not supported, in call "
+                                    "to Open\n");
+    }
     auto varCallback = [](void *reader, const char *variableName,
                           const char *type, void *data) {
         std::string Type(type);
@@ -118,8 +142,14 @@ size_t SstReader::CurrentStep() const { return m_CurrentStep; }
 
 void SstReader::EndStep()
 {
-    SstPerformGets(m_Input);
+    const SstStatusValue result = SstPerformGets(m_Input);
     SstReleaseStep(m_Input);
+    if (result != SstSuccess)
+    {
+        throw std::runtime_error("ERROR: SstReader failed to read data of "
+                                 "stream " +
+                                 m_Name + ", in call to EndStep\n");
+    }
 }
 
 // PRIVATE
@@ -134,7 +164,12 @@ void SstReader::Init()
         SstGetDeferred(m_Input, (void *)&variable, variable.m_Name.c_str(),    \
                        variable.m_Start.size(), variable.m_Start.data(),       \
                        variable.m_Count.data(), data);                         \
-        SstPerformGets(m_Input);                                               \
+        if (SstPerformGets(m_Input) != SstSuccess)                             \
+        {                                                                      \
+            throw std::runtime_error("ERROR: SstReader failed to read " +      \
+                                     variable.m_Name + " from stream " +       \
+                                     m_Name + ", in call to GetSync\n");       \
+        }                                                                      \
     }                                                                          \
     void SstReader::DoGetDeferred(Variable<T> &variable, T *data)              \
     {                                                                          \
@@ -151,7 +186,15 @@ void SstReader::Init()
 ADIOS2_FOREACH_TYPE_1ARG(declare_type)
 #undef declare_type
 
-void SstReader::PerformGets() { SstPerformGets(m_Input); }
+void SstReader::PerformGets()
+{
+    if (SstPerformGets(m_Input) != SstSuccess)
+    {
+        throw std::runtime_error("ERROR: SstReader failed to read data of "
+                                 "stream " +
+                                 m_Name + ", in call to PerformGets\n");
+    }
+}
 
 void SstReader::DoClose(const int transportIndex) { SstReaderClose(m_Input); }
 
@@ -10,6 +10,9 @@
 
 #include <mpi.h>
 
+#include <cstdlib>   //std::malloc
+#include <stdexcept> //std::invalid_argument
+
 #include "SstWriter.h"
 #include "SstWriter.tcc"
 
@@ -20,28 +23,38 @@ namespace adios2
 
 SstWriter::SstWriter(IO &io, const std::string &name, const Mode mode,
                      MPI_Comm mpiComm)
-: Engine("SstWriter", io, name, mode, mpiComm)
+: Engine("SstWriter", io, name, mode, mpiComm),
+  m_BP3Serializer(mpiComm, m_DebugMode)
 {
+    Init();
+
     char *cstr = new char[name.length() + 1];
     strcpy(cstr, name.c_str());
 
-    m_Output = SstWriterOpen(cstr, NULL, mpiComm);
-    Init();
+    // control plane parameters, as comma separated Key=Value pairs, the
+    // last MarshalMethod wins and is announced to readers
+    std::string params;
+    for (const auto &parameter : m_IO.m_Parameters)
+    {
+        params += parameter.first + "=" + parameter.second + ",";
+    }
+    params += m_FFSmarshal ? "MarshalMethod=FFS" : "MarshalMethod=BP";
+
+    m_Output = SstWriterOpen(cstr, params.c_str(), mpiComm);
+    if (m_Output == nullptr)
+    {
+        delete[] cstr;
+        throw std::invalid_argument("ERROR: SstWriter failed to open stream " +
+                                    m_Name + ", check DataTransport "
+                                             "parameter, in call to Open\n");
+    }
     delete[] cstr;
 }
 
 StepStatus SstWriter::BeginStep(StepMode mode, const float timeout_sec)
 {
-    if (m_FFSmarshal)
-    {
-        return (StepStatus)SstWriterBeginStep(m_Output, (int)mode, timeout_sec);
-    }
-    else
-    {
-        // When BP marshalling/unmarshaling complete, this should call
-        // SstProvideTimestep and clean up at this level
-    }
-    return StepStatus::OK;
+    ++m_WriterStep;
+    return (StepStatus)SstWriterBeginStep(m_Output, (int)mode, timeout_sec);
 }
 
 void SstWriter::EndStep()
@@ -52,8 +65,7 @@ void SstWriter::EndStep()
     }
     else
     {
-        // When BP marshalling/unmarshaling complete, this should call
-        // SstProvideTimestep and clean up at this level
+        EndStepBP();
     }
 }
 
@@ -78,6 +90,119 @@ void SstWriter::Init()
         }
     };
     lf_SetBoolParameter("FFSmarshal", m_FFSmarshal);
+
+    auto itMarshalMethod = m_IO.m_Parameters.find("MarshalMethod");
+    if (itMarshalMethod != m_IO.m_Parameters.end())
+    {
+        if (itMarshalMethod->second == "BP" || itMarshalMethod->second == "bp")
+        {
+            m_FFSmarshal = false;
+        }
+        else if (itMarshalMethod->second == "FFS" ||
+                 itMarshalMethod->second == "ffs")
+        {
+            m_FFSmarshal = true;
+        }
+        else if (m_DebugMode)
+        {
+            throw std::invalid_argument(
+                "ERROR: MarshalMethod=" + itMarshalMethod->second +
+                " must be FFS (default) or BP, in call to Open\n");
+        }
+    }
+
+    auto itVerbosity = m_IO.m_Parameters.find("verbose");
+    if (itVerbosity != m_IO.m_Parameters.end())
+    {
+        m_Verbosity = std::stoi(itVerbosity->second);
+        if (m_DebugMode)
+        {
+            if (m_Verbosity < 0 || m_Verbosity > 5)
+                throw std::invalid_argument(
+                    "ERROR: Method verbose argument must be an "
+                    "integer in the range [0,5], in call to "
+                    "Open or Engine constructor\n");
+        }
+    }
+
+    if (!m_FFSmarshal)
+    {
+        m_BP3Serializer.m_ThreadPool = m_IO.m_ThreadPool;
+        m_BP3Serializer.InitParameters(m_IO.m_Parameters);
+        // SST blocks point into one contiguous buffer with all payloads
+        m_BP3Serializer.m_ZeroCopy = false;
+        m_BP3Serializer.m_BufferChunkSize = 0;
+        m_BP3Serializer.m_Data.m_ChunkSize = 0;
+    }
+}
+
+void SstWriter::EndStepBP()
+{
+    if (!m_BP3Serializer.m_MetadataSet.DataPGIsOpen)
+    {
+        m_BP3Serializer.PutProcessGroupIndex(m_IO.m_Name, m_IO.m_HostLanguage,
+                                             {"SST"});
+    }
+
+    auto &bufferSTL = m_BP3Serializer.m_Data;
+    m_BP3Serializer.SerializeData(m_IO, true);
+    const size_t dataSize = bufferSTL.m_Position;
+    m_BP3Serializer.SerializeMetadataInData(false);
+    const size_t metadataSize = bufferSTL.m_Position - dataSize;
+
+    // the step keeps the serialized bytes, the serializer continues in a
+    // buffer released by an earlier step, or a new one of the same size
+    BPTimestep *timestep = new BPTimestep{m_BPBufferPool, {}};
+    {
+        std::lock_guard<std::mutex> lock(m_BPBufferPool->Mutex);
+        if (!m_BPBufferPool->Buffers.empty())
+        {
+            timestep->Buffer.swap(m_BPBufferPool->Buffers.back());
+            m_BPBufferPool->Buffers.pop_back();
+        }
+    }
+    if (timestep->Buffer.empty())
+    {
+        timestep->Buffer.resize(bufferSTL.m_Buffer.size());
+    }
+    else
+    {
+        // ResizeBuffer checks the capacity, all of it must be usable
+        timestep->Buffer.resize(timestep->Buffer.capacity());
+    }
+    timestep->Buffer.swap(bufferSTL.m_Buffer);
+    std::vector<char> &buffer = timestep->Buffer;
+    bufferSTL.m_Position = 0;
+    bufferSTL.m_AbsolutePosition = 0;
+    m_BP3Serializer.ResetIndices();
+
+    // records are released by SST with free
+    SstData data = static_cast<SstData>(std::malloc(sizeof(*data)));
+    SstData metadata = static_cast<SstData>(std::malloc(sizeof(*metadata)));
+    data->DataSize = dataSize;
+    data->block = buffer.data();
+    metadata->DataSize = metadataSize;
+    metadata->block = buffer.data() + dataSize;
+
+    if (m_Verbosity == 5)
+    {
+        std::cout << "SstWriter step " << m_WriterStep << " BP metadata "
+                  << metadataSize << " bytes, data " << dataSize
+                  << " bytes\n";
+    }
+
+    SstProvideTimestep(m_Output, metadata, data, m_WriterStep,
+                       &SstWriter::FreeTimestepBP, timestep);
+}
+
+void SstWriter::FreeTimestepBP(void *timestep)
+{
+    BPTimestep *released = static_cast<BPTimestep *>(timestep);
+    {
+        std::lock_guard<std::mutex> lock(released->Pool->Mutex);
+        released->Pool->Buffers.push_back(std::move(released->Buffer));
+    }
+    delete released;
 }
 
 #define declare_type(T)                                                        \
@@ -12,7 +12,10 @@
 #define ADIOS2_ENGINE_SST_SST_WRITER_H_
 
 #include <iostream> //std::cout must be removed, only used for hello example
+#include <memory>   //std::shared_ptr
+#include <mutex>
 #include <unistd.h> //sleep must be removed
+#include <vector>
 
 #include <mpi.h>
 
@@ -20,6 +23,7 @@
 
 #include "adios2/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
+#include "adios2/toolkit/format/bp3/BP3.h"
 
 namespace adios2
 {
@@ -54,8 +58,42 @@ private:
     template <class T>
     void PutDeferredCommon(Variable<T> &variable, const T *values);
 
+    /** MarshalMethod=BP: puts variable in the current step BP buffer */
+    template <class T>
+    void PutSyncCommonBP(Variable<T> &variable, const T *values);
+
+    /** MarshalMethod=BP: serializes the step and gives its BP buffer to
+     * SST, data and metadata blocks point into the buffer */
+    void EndStepBP();
+
+    /** BP step buffers released by SST, reused by later steps, shared
+     * with the timesteps as SST may release them from its own thread */
+    struct BPBufferPool
+    {
+        std::mutex Mutex;
+        std::vector<std::vector<char>> Buffers;
+    };
+
+    /** SstFreeFunc client data of a BP timestep */
+    struct BPTimestep
+    {
+        std::shared_ptr<BPBufferPool> Pool;
+        std::vector<char> Buffer;
+    };
+
+    /** SstFreeFunc for BP timesteps, returns the step buffer to its pool */
+    static void FreeTimestepBP(void *timestep);
+
     SstStream m_Output;
+    /** MarshalMethod=FFS (default, true) or BP (false) */
     bool m_FFSmarshal = true;
+    format::BP3Serializer m_BP3Serializer;
+    std::shared_ptr<BPBufferPool> m_BPBufferPool =
+        std::make_shared<BPBufferPool>();
+    /** SST timestep, advanced in BeginStep */
+    long m_WriterStep = -1;
+    /** verbose=5 prints every Put */
+    int m_Verbosity = 0;
 
     void DoClose(const int transportIndex = -1) final;
 };
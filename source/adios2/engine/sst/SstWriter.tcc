@@ -24,8 +24,6 @@ void SstWriter::PutSyncCommon(Variable<T> &variable, const T *values)
 {
     variable.SetData(values);
 
-    // This part will go away, this is just to monitor variables per rank
-
     if (variable.m_Count.empty())
     {
         variable.m_Count = variable.m_Shape;
@@ -35,44 +33,51 @@ void SstWriter::PutSyncCommon(Variable<T> &variable, const T *values)
         variable.m_Start.assign(variable.m_Count.size(), 0);
     }
 
-    std::cout << "Variable " << variable.m_Name << "\n";
-    std::cout << "Shape ID ";
-    switch (variable.m_ShapeID)
-    {
-    case ShapeID::GlobalValue:
-        std::cout << "GlobalValue : ";
-        break;
-    case ShapeID::GlobalArray:
-        std::cout << "GlobalArray : ";
-        break;
-    case ShapeID::JoinedArray:
-        std::cout << "JoinedArray : ";
-        break;
-    case ShapeID::LocalValue:
-        std::cout << "LocalValue : ";
-        break;
-    case ShapeID::LocalArray:
-        std::cout << "LocalArray : ";
-        break;
-    }
-    std::cout << "putshape ";
-    for (auto it = variable.m_Count.begin(); it != variable.m_Count.end(); ++it)
-    {
-        std::cout << ' ' << *it;
-    }
-    std::cout << '\n';
-    std::cout << "varshape ";
-    for (auto it = variable.m_Shape.begin(); it != variable.m_Shape.end(); ++it)
+    if (m_Verbosity == 5)
     {
-        std::cout << ' ' << *it;
+        std::cout << "Variable " << variable.m_Name << "\n";
+        std::cout << "Shape ID ";
+        switch (variable.m_ShapeID)
+        {
+        case ShapeID::GlobalValue:
+            std::cout << "GlobalValue : ";
+            break;
+        case ShapeID::GlobalArray:
+            std::cout << "GlobalArray : ";
+            break;
+        case ShapeID::JoinedArray:
+            std::cout << "JoinedArray : ";
+            break;
+        case ShapeID::LocalValue:
+            std::cout << "LocalValue : ";
+            break;
+        case ShapeID::LocalArray:
+            std::cout << "LocalArray : ";
+            break;
+        }
+        std::cout << "putshape ";
+        for (auto it = variable.m_Count.begin(); it != variable.m_Count.end();
+             ++it)
+        {
+            std::cout << ' ' << *it;
+        }
+        std::cout << '\n';
+        std::cout << "varshape ";
+        for (auto it = variable.m_Shape.begin(); it != variable.m_Shape.end();
+             ++it)
+        {
+            std::cout << ' ' << *it;
+        }
+        std::cout << '\n';
+        std::cout << "offsets ";
+        for (auto it = variable.m_Start.begin(); it != variable.m_Start.end();
+             ++it)
+        {
+            std::cout << ' ' << *it;
+        }
+        std::cout << '\n';
     }
-    std::cout << '\n';
-    std::cout << "offsets ";
-    for (auto it = variable.m_Start.begin(); it != variable.m_Start.end(); ++it)
-    {
-        std::cout << ' ' << *it;
-    }
-    std::cout << '\n';
+
     if (m_FFSmarshal)
     {
         SstMarshal(m_Output, (void *)&variable, variable.m_Name.c_str(),
@@ -82,10 +87,37 @@ void SstWriter::PutSyncCommon(Variable<T> &variable, const T *values)
     }
     else
     {
-        // Do BP marshaling
+        PutSyncCommonBP(variable, values);
     }
 }
 
+template <class T>
+void SstWriter::PutSyncCommonBP(Variable<T> &variable, const T *values)
+{
+    if (!m_BP3Serializer.m_MetadataSet.DataPGIsOpen)
+    {
+        m_BP3Serializer.PutProcessGroupIndex(m_IO.m_Name, m_IO.m_HostLanguage,
+                                             {"SST"});
+    }
+
+    const size_t dataSize = m_BP3Serializer.GetPayloadMaxSize(variable) +
+                            m_BP3Serializer.GetVariableBPIndexSize(variable);
+    const format::BP3Base::ResizeResult resizeResult =
+        m_BP3Serializer.ResizeBuffer(dataSize, "in call to variable " +
+                                                   variable.m_Name + " Put");
+
+    // a step is a single SST timestep, it can't be flushed in parts
+    if (resizeResult == format::BP3Base::ResizeResult::Flush)
+    {
+        throw std::runtime_error(
+            "ERROR: step buffer exceeds MaxBufferSize when putting variable " +
+            variable.m_Name + ", increase MaxBufferSize, in SstWriter Put\n");
+    }
+
+    m_BP3Serializer.PutVariableMetadata(variable);
+    m_BP3Serializer.PutVariablePayload(variable);
+}
+
 } // end namespace adios2
 
 #endif /* ADIOS2_ENGINE_SST_SST_WRITER_H_ */
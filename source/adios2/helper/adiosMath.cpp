@@ -12,13 +12,25 @@
 
 #include <algorithm> //std::transform, std::reverse
 #include <cmath>
+#include <cstdint>
 #include <functional> //std::minus<T>
 #include <iterator>   //std::back_inserter
 #include <numeric>    //std::accumulate
-#include <utility>    //std::pair
+#include <type_traits>
+#include <utility> //std::pair
 
+#include "adios2/ADIOSMacros.h"
 #include "adios2/helper/adiosString.h" //DimsToString
 
+// x86 kernels are compiled for AVX2 and AVX-512 with function attributes and
+// selected at runtime, the library itself doesn't require these extensions
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ADIOS2_MATH_X86_KERNELS
+#include <immintrin.h>
+#define ADIOS2_TARGET_AVX2 __attribute__((target("avx2")))
+#define ADIOS2_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
 namespace adios2
 {
 
@@ -212,7 +224,7 @@ size_t LinearIndex(const Box<Dims> &localBox, const Dims &point,
         for (size_t p = 1; p < countSize; ++p)
         {
             linearIndex += (normalizedPoint[countSize - p]) * product;
-            product /= count[countSize - p];
+            product /= count[countSize - p - 1];
         }
         linearIndex += normalizedPoint[0]; // fastest
         return linearIndex;
@@ -249,4 +261,782 @@ size_t LinearIndex(const Box<Dims> &localBox, const Dims &point,
     return linearIndex;
 }
 
+namespace
+{
+
+/** Fixed width integer with the same size and signedness as an integral type,
+ * long and long long (or char and signed char) share the same kernels */
+template <size_t Size, bool IsSigned>
+struct FixedInteger;
+
+template <>
+struct FixedInteger<1, true>
+{
+    using Type = int8_t;
+};
+template <>
+struct FixedInteger<1, false>
+{
+    using Type = uint8_t;
+};
+template <>
+struct FixedInteger<2, true>
+{
+    using Type = int16_t;
+};
+template <>
+struct FixedInteger<2, false>
+{
+    using Type = uint16_t;
+};
+template <>
+struct FixedInteger<4, true>
+{
+    using Type = int32_t;
+};
+template <>
+struct FixedInteger<4, false>
+{
+    using Type = uint32_t;
+};
+template <>
+struct FixedInteger<8, true>
+{
+    using Type = int64_t;
+};
+template <>
+struct FixedInteger<8, false>
+{
+    using Type = uint64_t;
+};
+
+template <class T, bool IsIntegral = std::is_integral<T>::value>
+struct KernelType
+{
+    using Type = T;
+};
+
+template <class T>
+struct KernelType<T, true>
+{
+    using Type =
+        typename FixedInteger<sizeof(T), std::is_signed<T>::value>::Type;
+};
+
+// Scalar fallbacks, also used for tails and reductions. NaN values are
+// skipped, as in the vector kernels, bounds are NaN only if all values are.
+// (x != x) is false for integers and optimized out.
+
+template <class T>
+void MinMaxScalar(const T *values, const size_t size, T &min, T &max) noexcept
+{
+    min = values[0];
+    max = values[0];
+    for (size_t i = 1; i < size; ++i)
+    {
+        const T value = values[i];
+        min = (value < min || min != min) ? value : min;
+        max = (max < value || max != max) ? value : max;
+    }
+}
+
+template <class T>
+void MinMaxNormScalar(const std::complex<T> *values, const size_t size,
+                      T &min, T &max) noexcept
+{
+    min = std::norm(values[0]);
+    max = min;
+    for (size_t i = 1; i < size; ++i)
+    {
+        const T norm = std::norm(values[i]);
+        min = (norm < min || min != min) ? norm : min;
+        max = (max < norm || max != max) ? norm : max;
+    }
+}
+
+template <class T>
+void SumsScalar(const T *values, const size_t size, double &sum,
+                double &sumSquare) noexcept
+{
+    // independent accumulators break the dependency chain
+    double sums[4] = {0., 0., 0., 0.};
+    double squares[4] = {0., 0., 0., 0.};
+
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            const double value = static_cast<double>(values[i + j]);
+            sums[j] += value;
+            squares[j] += value * value;
+        }
+    }
+    for (; i < size; ++i)
+    {
+        const double value = static_cast<double>(values[i]);
+        sums[0] += value;
+        squares[0] += value * value;
+    }
+
+    sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    sumSquare = (squares[0] + squares[1]) + (squares[2] + squares[3]);
+}
+
+template <class T>
+void SumsNormScalar(const std::complex<T> *values, const size_t size,
+                    double &sum, double &sumSquare) noexcept
+{
+    sum = 0.;
+    sumSquare = 0.;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double norm = static_cast<double>(std::norm(values[i]));
+        sum += std::sqrt(norm);
+        sumSquare += norm;
+    }
+}
+
+#ifdef ADIOS2_MATH_X86_KERNELS
+
+enum class SIMDLevel
+{
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+/** Widest instruction set supported by the CPU and OS, detected once */
+SIMDLevel GetSIMDLevel() noexcept
+{
+    static const SIMDLevel level = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return SIMDLevel::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return SIMDLevel::AVX2;
+        }
+        return SIMDLevel::Scalar;
+    }();
+    return level;
+}
+
+/** AVX2 min/max operations, only specialized for supported types */
+template <class T>
+struct AVX2
+{
+    static constexpr bool IsAvailable = false;
+};
+
+struct AVX2Integer
+{
+    static constexpr bool IsAvailable = true;
+    using Vector = __m256i;
+
+    template <class T>
+    ADIOS2_TARGET_AVX2 static Vector Load(const T *values) noexcept
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+    }
+
+    template <class T>
+    ADIOS2_TARGET_AVX2 static void Store(T *values, const Vector v) noexcept
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values), v);
+    }
+};
+
+#define ADIOS2_AVX2_INTEGER(T, MIN, MAX)                                       \
+    template <>                                                                \
+    struct AVX2<T> : public AVX2Integer                                        \
+    {                                                                          \
+        ADIOS2_TARGET_AVX2 static Vector Min(const Vector a,                   \
+                                             const Vector b) noexcept          \
+        {                                                                      \
+            return MIN(a, b);                                                  \
+        }                                                                      \
+        ADIOS2_TARGET_AVX2 static Vector Max(const Vector a,                   \
+                                             const Vector b) noexcept          \
+        {                                                                      \
+            return MAX(a, b);                                                  \
+        }                                                                      \
+    };
+
+ADIOS2_AVX2_INTEGER(int8_t, _mm256_min_epi8, _mm256_max_epi8)
+ADIOS2_AVX2_INTEGER(uint8_t, _mm256_min_epu8, _mm256_max_epu8)
+ADIOS2_AVX2_INTEGER(int16_t, _mm256_min_epi16, _mm256_max_epi16)
+ADIOS2_AVX2_INTEGER(uint16_t, _mm256_min_epu16, _mm256_max_epu16)
+ADIOS2_AVX2_INTEGER(int32_t, _mm256_min_epi32, _mm256_max_epi32)
+ADIOS2_AVX2_INTEGER(uint32_t, _mm256_min_epu32, _mm256_max_epu32)
+#undef ADIOS2_AVX2_INTEGER
+
+// AVX2 has no 64-bit min/max, select with a signed compare, unsigned values
+// are compared with their sign bit flipped
+template <>
+struct AVX2<int64_t> : public AVX2Integer
+{
+    ADIOS2_TARGET_AVX2 static Vector Min(const Vector a,
+                                         const Vector b) noexcept
+    {
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+    }
+    ADIOS2_TARGET_AVX2 static Vector Max(const Vector a,
+                                         const Vector b) noexcept
+    {
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a));
+    }
+};
+
+template <>
+struct AVX2<uint64_t> : public AVX2Integer
+{
+    ADIOS2_TARGET_AVX2 static Vector Greater(const Vector a,
+                                             const Vector b) noexcept
+    {
+        const Vector sign = _mm256_set1_epi64x(
+            static_cast<long long>(0x8000000000000000ULL));
+        return _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign),
+                                  _mm256_xor_si256(b, sign));
+    }
+    ADIOS2_TARGET_AVX2 static Vector Min(const Vector a,
+                                         const Vector b) noexcept
+    {
+        return _mm256_blendv_epi8(a, b, Greater(a, b));
+    }
+    ADIOS2_TARGET_AVX2 static Vector Max(const Vector a,
+                                         const Vector b) noexcept
+    {
+        return _mm256_blendv_epi8(a, b, Greater(b, a));
+    }
+};
+
+template <>
+struct AVX2<float>
+{
+    static constexpr bool IsAvailable = true;
+    using Vector = __m256;
+
+    ADIOS2_TARGET_AVX2 static Vector Load(const float *values) noexcept
+    {
+        return _mm256_loadu_ps(values);
+    }
+    ADIOS2_TARGET_AVX2 static void Store(float *values,
+                                         const Vector v) noexcept
+    {
+        _mm256_storeu_ps(values, v);
+    }
+    /** min_ps returns its second operand if either is NaN, NaN lanes of
+     * a are then replaced by b, so NaN values are skipped as in MinMaxScalar */
+    ADIOS2_TARGET_AVX2 static Vector Min(const Vector a,
+                                         const Vector b) noexcept
+    {
+        return _mm256_blendv_ps(_mm256_min_ps(b, a), b,
+                                  _mm256_cmp_ps(a, a, _CMP_UNORD_Q));
+    }
+    ADIOS2_TARGET_AVX2 static Vector Max(const Vector a,
+                                         const Vector b) noexcept
+    {
+        return _mm256_blendv_ps(_mm256_max_ps(b, a), b,
+                                  _mm256_cmp_ps(a, a, _CMP_UNORD_Q));
+    }
+};
+
+template <>
+struct AVX2<double>
+{
+    static constexpr bool IsAvailable = true;
+    using Vector = __m256d;
+
+    ADIOS2_TARGET_AVX2 static Vector Load(const double *values) noexcept
+    {
+        return _mm256_loadu_pd(values);
+    }
+    ADIOS2_TARGET_AVX2 static void Store(double *values,
+                                         const Vector v) noexcept
+    {
+        _mm256_storeu_pd(values, v);
+    }
+    /** min_pd returns its second operand if either is NaN, NaN lanes of
+     * a are then replaced by b, so NaN values are skipped as in MinMaxScalar */
+    ADIOS2_TARGET_AVX2 static Vector Min(const Vector a,
+                                         const Vector b) noexcept
+    {
+        return _mm256_blendv_pd(_mm256_min_pd(b, a), b,
+                                  _mm256_cmp_pd(a, a, _CMP_UNORD_Q));
+    }
+    ADIOS2_TARGET_AVX2 static Vector Max(const Vector a,
+                                         const Vector b) noexcept
+    {
+        return _mm256_blendv_pd(_mm256_max_pd(b, a), b,
+                                  _mm256_cmp_pd(a, a, _CMP_UNORD_Q));
+    }
+};
+
+/** AVX-512F min/max operations, 32 and 64-bit types only, narrower types
+ * need AVX-512BW and use AVX2 */
+template <class T>
+struct AVX512
+{
+    static constexpr bool IsAvailable = false;
+};
+
+struct AVX512Integer
+{
+    static constexpr bool IsAvailable = true;
+    using Vector = __m512i;
+
+    template <class T>
+    ADIOS2_TARGET_AVX512 static Vector Load(const T *values) noexcept
+    {
+        return _mm512_loadu_si512(values);
+    }
+
+    template <class T>
+    ADIOS2_TARGET_AVX512 static void Store(T *values, const Vector v) noexcept
+    {
+        _mm512_storeu_si512(values, v);
+    }
+};
+
+#define ADIOS2_AVX512_INTEGER(T, MIN, MAX)                                     \
+    template <>                                                                \
+    struct AVX512<T> : public AVX512Integer                                    \
+    {                                                                          \
+        ADIOS2_TARGET_AVX512 static Vector Min(const Vector a,                 \
+                                               const Vector b) noexcept        \
+        {                                                                      \
+            return MIN(a, b);                                                  \
+        }                                                                      \
+        ADIOS2_TARGET_AVX512 static Vector Max(const Vector a,                 \
+                                               const Vector b) noexcept        \
+        {                                                                      \
+            return MAX(a, b);                                                  \
+        }                                                                      \
+    };
+
+ADIOS2_AVX512_INTEGER(int32_t, _mm512_min_epi32, _mm512_max_epi32)
+ADIOS2_AVX512_INTEGER(uint32_t, _mm512_min_epu32, _mm512_max_epu32)
+ADIOS2_AVX512_INTEGER(int64_t, _mm512_min_epi64, _mm512_max_epi64)
+ADIOS2_AVX512_INTEGER(uint64_t, _mm512_min_epu64, _mm512_max_epu64)
+#undef ADIOS2_AVX512_INTEGER
+
+template <>
+struct AVX512<float>
+{
+    static constexpr bool IsAvailable = true;
+    using Vector = __m512;
+
+    ADIOS2_TARGET_AVX512 static Vector Load(const float *values) noexcept
+    {
+        return _mm512_loadu_ps(values);
+    }
+    ADIOS2_TARGET_AVX512 static void Store(float *values,
+                                           const Vector v) noexcept
+    {
+        _mm512_storeu_ps(values, v);
+    }
+    /** same NaN handling as AVX2 */
+    ADIOS2_TARGET_AVX512 static Vector Min(const Vector a,
+                                           const Vector b) noexcept
+    {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q),
+                                      _mm512_min_ps(b, a), b);
+    }
+    ADIOS2_TARGET_AVX512 static Vector Max(const Vector a,
+                                           const Vector b) noexcept
+    {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q),
+                                      _mm512_max_ps(b, a), b);
+    }
+};
+
+template <>
+struct AVX512<double>
+{
+    static constexpr bool IsAvailable = true;
+    using Vector = __m512d;
+
+    ADIOS2_TARGET_AVX512 static Vector Load(const double *values) noexcept
+    {
+        return _mm512_loadu_pd(values);
+    }
+    ADIOS2_TARGET_AVX512 static void Store(double *values,
+                                           const Vector v) noexcept
+    {
+        _mm512_storeu_pd(values, v);
+    }
+    /** same NaN handling as AVX2 */
+    ADIOS2_TARGET_AVX512 static Vector Min(const Vector a,
+                                           const Vector b) noexcept
+    {
+        return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q),
+                                      _mm512_min_pd(b, a), b);
+    }
+    ADIOS2_TARGET_AVX512 static Vector Max(const Vector a,
+                                           const Vector b) noexcept
+    {
+        return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q),
+                                      _mm512_max_pd(b, a), b);
+    }
+};
+
+/**
+ * Vectorized min/max, defined once per instruction set as vector types can
+ * only be used in functions compiled for it. Two accumulators per bound hide
+ * the instruction latency, the tail is covered by overlapping loads as min
+ * and max are idempotent.
+ */
+#define ADIOS2_MINMAX_VECTOR(NAME, TARGET)                                     \
+    template <class Traits, class T>                                           \
+    TARGET void NAME(const T *values, const size_t size, T &min,               \
+                     T &max) noexcept                                          \
+    {                                                                          \
+        using Vector = typename Traits::Vector;                                \
+        constexpr size_t width = sizeof(Vector) / sizeof(T);                   \
+        constexpr size_t step = 2 * width;                                     \
+                                                                               \
+        if (size < step)                                                       \
+        {                                                                      \
+            MinMaxScalar(values, size, min, max);                              \
+            return;                                                            \
+        }                                                                      \
+                                                                               \
+        Vector min0 = Traits::Load(values);                                    \
+        Vector max0 = min0;                                                    \
+        Vector min1 = Traits::Load(values + width);                            \
+        Vector max1 = min1;                                                    \
+                                                                               \
+        size_t i = step;                                                       \
+        for (; i + step <= size; i += step)                                    \
+        {                                                                      \
+            const Vector a = Traits::Load(values + i);                         \
+            const Vector b = Traits::Load(values + i + width);                 \
+            min0 = Traits::Min(min0, a);                                       \
+            max0 = Traits::Max(max0, a);                                       \
+            min1 = Traits::Min(min1, b);                                       \
+            max1 = Traits::Max(max1, b);                                       \
+        }                                                                      \
+                                                                               \
+        if (i < size)                                                          \
+        {                                                                      \
+            const Vector a = Traits::Load(values + size - step);               \
+            const Vector b = Traits::Load(values + size - width);              \
+            min0 = Traits::Min(min0, a);                                       \
+            max0 = Traits::Max(max0, a);                                       \
+            min1 = Traits::Min(min1, b);                                       \
+            max1 = Traits::Max(max1, b);                                       \
+        }                                                                      \
+                                                                               \
+        T mins[width];                                                         \
+        T maxs[width];                                                         \
+        Traits::Store(mins, Traits::Min(min0, min1));                          \
+        Traits::Store(maxs, Traits::Max(max0, max1));                          \
+                                                                               \
+        T unused;                                                              \
+        MinMaxScalar(mins, width, min, unused);                                \
+        MinMaxScalar(maxs, width, unused, max);                                \
+    }
+
+ADIOS2_MINMAX_VECTOR(MinMaxVectorAVX2, ADIOS2_TARGET_AVX2)
+ADIOS2_MINMAX_VECTOR(MinMaxVectorAVX512, ADIOS2_TARGET_AVX512)
+#undef ADIOS2_MINMAX_VECTOR
+
+template <class T>
+ADIOS2_TARGET_AVX2 typename std::enable_if<AVX2<T>::IsAvailable>::type
+MinMaxAVX2(const T *values, const size_t size, T &min, T &max) noexcept
+{
+    MinMaxVectorAVX2<AVX2<T>>(values, size, min, max);
+}
+
+template <class T>
+typename std::enable_if<!AVX2<T>::IsAvailable>::type
+MinMaxAVX2(const T *values, const size_t size, T &min, T &max) noexcept
+{
+    MinMaxScalar(values, size, min, max);
+}
+
+template <class T>
+ADIOS2_TARGET_AVX512 typename std::enable_if<AVX512<T>::IsAvailable>::type
+MinMaxAVX512(const T *values, const size_t size, T &min, T &max) noexcept
+{
+    MinMaxVectorAVX512<AVX512<T>>(values, size, min, max);
+}
+
+template <class T>
+typename std::enable_if<!AVX512<T>::IsAvailable>::type
+MinMaxAVX512(const T *values, const size_t size, T &min, T &max) noexcept
+{
+    MinMaxAVX2(values, size, min, max);
+}
+
+/** squared modulus of 8 complex<float>, in lane order, not element order */
+ADIOS2_TARGET_AVX2 inline __m256 NormsAVX2(const std::complex<float> *values)
+{
+    const float *parts = reinterpret_cast<const float *>(values);
+    const __m256 a = _mm256_loadu_ps(parts);
+    const __m256 b = _mm256_loadu_ps(parts + 8);
+    return _mm256_hadd_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b));
+}
+
+/** squared modulus of 4 complex<double>, in lane order, not element order */
+ADIOS2_TARGET_AVX2 inline __m256d
+NormsAVX2(const std::complex<double> *values)
+{
+    const double *parts = reinterpret_cast<const double *>(values);
+    const __m256d a = _mm256_loadu_pd(parts);
+    const __m256d b = _mm256_loadu_pd(parts + 4);
+    return _mm256_hadd_pd(_mm256_mul_pd(a, a), _mm256_mul_pd(b, b));
+}
+
+template <class T>
+ADIOS2_TARGET_AVX2 void MinMaxNormAVX2(const std::complex<T> *values,
+                                       const size_t size, T &min,
+                                       T &max) noexcept
+{
+    using Traits = AVX2<T>;
+    using Vector = typename Traits::Vector;
+    constexpr size_t width = sizeof(Vector) / sizeof(T);
+
+    if (size < width)
+    {
+        MinMaxNormScalar(values, size, min, max);
+        return;
+    }
+
+    Vector vMin = NormsAVX2(values);
+    Vector vMax = vMin;
+
+    size_t i = width;
+    for (; i + width <= size; i += width)
+    {
+        const Vector norms = NormsAVX2(values + i);
+        vMin = Traits::Min(vMin, norms);
+        vMax = Traits::Max(vMax, norms);
+    }
+
+    if (i < size)
+    {
+        const Vector norms = NormsAVX2(values + size - width);
+        vMin = Traits::Min(vMin, norms);
+        vMax = Traits::Max(vMax, norms);
+    }
+
+    T mins[width];
+    T maxs[width];
+    Traits::Store(mins, vMin);
+    Traits::Store(maxs, vMax);
+
+    T unused;
+    MinMaxScalar(mins, width, min, unused);
+    MinMaxScalar(maxs, width, unused, max);
+}
+
+/** Converts 4 values to double for accumulation, float, double and int32
+ * only */
+template <class T>
+struct AVX2Double
+{
+    static constexpr bool IsAvailable = false;
+};
+
+template <>
+struct AVX2Double<float>
+{
+    static constexpr bool IsAvailable = true;
+    ADIOS2_TARGET_AVX2 static __m256d Load(const float *values) noexcept
+    {
+        return _mm256_cvtps_pd(_mm_loadu_ps(values));
+    }
+};
+
+template <>
+struct AVX2Double<double>
+{
+    static constexpr bool IsAvailable = true;
+    ADIOS2_TARGET_AVX2 static __m256d Load(const double *values) noexcept
+    {
+        return _mm256_loadu_pd(values);
+    }
+};
+
+template <>
+struct AVX2Double<int32_t>
+{
+    static constexpr bool IsAvailable = true;
+    ADIOS2_TARGET_AVX2 static __m256d Load(const int32_t *values) noexcept
+    {
+        return _mm256_cvtepi32_pd(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(values)));
+    }
+};
+
+template <class T>
+ADIOS2_TARGET_AVX2 typename std::enable_if<AVX2Double<T>::IsAvailable>::type
+SumsAVX2(const T *values, const size_t size, double &sum,
+         double &sumSquare) noexcept
+{
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+    __m256d square0 = _mm256_setzero_pd();
+    __m256d square1 = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m256d a = AVX2Double<T>::Load(values + i);
+        const __m256d b = AVX2Double<T>::Load(values + i + 4);
+        sum0 = _mm256_add_pd(sum0, a);
+        sum1 = _mm256_add_pd(sum1, b);
+        square0 = _mm256_add_pd(square0, _mm256_mul_pd(a, a));
+        square1 = _mm256_add_pd(square1, _mm256_mul_pd(b, b));
+    }
+
+    double sums[4];
+    double squares[4];
+    _mm256_storeu_pd(sums, _mm256_add_pd(sum0, sum1));
+    _mm256_storeu_pd(squares, _mm256_add_pd(square0, square1));
+
+    double tailSum, tailSquare;
+    SumsScalar(values + i, size - i, tailSum, tailSquare);
+
+    sum = (sums[0] + sums[1]) + (sums[2] + sums[3]) + tailSum;
+    sumSquare = (squares[0] + squares[1]) + (squares[2] + squares[3]) +
+                tailSquare;
+}
+
+template <class T>
+typename std::enable_if<!AVX2Double<T>::IsAvailable>::type
+SumsAVX2(const T *values, const size_t size, double &sum,
+         double &sumSquare) noexcept
+{
+    SumsScalar(values, size, sum, sumSquare);
+}
+
+#endif // ADIOS2_MATH_X86_KERNELS
+
+template <class T>
+void MinMaxKernel(const T *values, const size_t size, T &min, T &max) noexcept
+{
+#ifdef ADIOS2_MATH_X86_KERNELS
+    switch (GetSIMDLevel())
+    {
+    case (SIMDLevel::AVX512):
+        MinMaxAVX512(values, size, min, max);
+        return;
+    case (SIMDLevel::AVX2):
+        MinMaxAVX2(values, size, min, max);
+        return;
+    default:
+        break;
+    }
+#endif
+    MinMaxScalar(values, size, min, max);
+}
+
+template <class T>
+void MinMaxNormKernel(const std::complex<T> *values, const size_t size,
+                      T &min, T &max) noexcept
+{
+    MinMaxNormScalar(values, size, min, max);
+}
+
+#ifdef ADIOS2_MATH_X86_KERNELS
+template <>
+void MinMaxNormKernel(const std::complex<float> *values, const size_t size,
+                      float &min, float &max) noexcept
+{
+    if (GetSIMDLevel() != SIMDLevel::Scalar)
+    {
+        MinMaxNormAVX2(values, size, min, max);
+        return;
+    }
+    MinMaxNormScalar(values, size, min, max);
+}
+
+template <>
+void MinMaxNormKernel(const std::complex<double> *values, const size_t size,
+                      double &min, double &max) noexcept
+{
+    if (GetSIMDLevel() != SIMDLevel::Scalar)
+    {
+        MinMaxNormAVX2(values, size, min, max);
+        return;
+    }
+    MinMaxNormScalar(values, size, min, max);
+}
+#endif
+
+template <class T>
+void SumsKernel(const T *values, const size_t size, double &sum,
+                double &sumSquare) noexcept
+{
+#ifdef ADIOS2_MATH_X86_KERNELS
+    if (GetSIMDLevel() != SIMDLevel::Scalar)
+    {
+        SumsAVX2(values, size, sum, sumSquare);
+        return;
+    }
+#endif
+    SumsScalar(values, size, sum, sumSquare);
+}
+
+} // end anonymous namespace
+
+template <class T>
+void GetMinMax(const T *values, const size_t size, T &min, T &max) noexcept
+{
+    using KernelT = typename KernelType<T>::Type;
+    MinMaxKernel(reinterpret_cast<const KernelT *>(values), size,
+                 reinterpret_cast<KernelT &>(min),
+                 reinterpret_cast<KernelT &>(max));
+}
+
+template <class T>
+void GetMinMaxComplex(const std::complex<T> *values, const size_t size, T &min,
+                      T &max) noexcept
+{
+    MinMaxNormKernel(values, size, min, max);
+    min = std::sqrt(min);
+    max = std::sqrt(max);
+}
+
+template <class T>
+void GetSums(const T *values, const size_t size, double &sum,
+             double &sumSquare) noexcept
+{
+    using KernelT = typename KernelType<T>::Type;
+    SumsKernel(reinterpret_cast<const KernelT *>(values), size, sum,
+               sumSquare);
+}
+
+template <class T>
+void GetSums(const std::complex<T> *values, const size_t size, double &sum,
+             double &sumSquare) noexcept
+{
+    SumsNormScalar(values, size, sum, sumSquare);
+}
+
+#define declare_template_instantiation(T)                                      \
+    template void GetMinMax(const T *, const size_t, T &, T &) noexcept;       \
+    template void GetSums(const T *, const size_t, double &,                   \
+                          double &) noexcept;
+
+ADIOS2_FOREACH_CHAR_TYPE_1ARG(declare_template_instantiation)
+ADIOS2_FOREACH_NUMERIC_ATTRIBUTE_TYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+#define declare_template_instantiation(T)                                      \
+    template void GetMinMaxComplex(const std::complex<T> *, const size_t,      \
+                                   T &, T &) noexcept;                         \
+    template void GetSums(const std::complex<T> *, const size_t, double &,     \
+                          double &) noexcept;
+
+declare_template_instantiation(float)
+declare_template_instantiation(double)
+declare_template_instantiation(long double)
+#undef declare_template_instantiation
+
 } // end namespace adios2
@@ -16,6 +16,7 @@
 /// \endcond
 
 #include "adios2/ADIOSTypes.h"
+#include "adios2/helper/adiosThreadPool.h"
 
 namespace adios2
 {
@@ -29,7 +30,8 @@ size_t GetTotalSize(const Dims &dimensions) noexcept;
 
 /**
  * Gets the min and max from a values array of primitive types (not including
- * complex)
+ * complex). Uses AVX2 or AVX-512 kernels if the CPU supports them. NaN values
+ * are skipped by all kernels, min and max are NaN only if all values are.
  * @param values input array
  * @param size of values array
  * @param min of values
@@ -51,19 +53,45 @@ template <class T>
 void GetMinMaxComplex(const std::complex<T> *values, const size_t size, T &min,
                       T &max) noexcept;
 
+/**
+ * Gets the sum and sum of squares of a values array of primitive types,
+ * accumulated in double precision
+ * @param values input array
+ * @param size of values array
+ * @param sum of values
+ * @param sumSquare sum of squared values
+ */
+template <class T>
+void GetSums(const T *values, const size_t size, double &sum,
+             double &sumSquare) noexcept;
+
+/**
+ * Version for complex types of GetSums, uses the modulus of each value
+ * @param values array of complex numbers
+ * @param size of the values array
+ * @param sum of modulus
+ * @param sumSquare sum of squared modulus
+ */
+template <class T>
+void GetSums(const std::complex<T> *values, const size_t size, double &sum,
+             double &sumSquare) noexcept;
+
 /**
  * Threaded version of GetMinMax.
  * Gets the min and max from a values array of primitive types (not including
- * complex) using threads
+ * complex) using threads from a ThreadPool, runs serially if threadPool is
+ * nullptr or size is below ThreadPool::MinChunkBytes per thread
  * @param values input array of complex
  * @param size of values array
  * @param min of values
  * @param max of values
  * @param threads used for parallel computation
+ * @param threadPool persistent workers, nullptr: serial
  */
 template <class T>
 void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
-                      const unsigned int threads = 1) noexcept;
+                      const unsigned int threads = 1,
+                      ThreadPool *threadPool = nullptr) noexcept;
 
 /**
  * Overloaded version of GetMinMaxThreads for complex types
@@ -72,10 +100,12 @@ void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
  * @param min of values
  * @param max of values
  * @param threads used for parallel computation
+ * @param threadPool persistent workers, nullptr: serial
  */
 template <class T>
 void GetMinMaxThreads(const std::complex<T> *values, const size_t size, T &min,
-                      T &max, const unsigned int threads = 1) noexcept;
+                      T &max, const unsigned int threads = 1,
+                      ThreadPool *threadPool = nullptr) noexcept;
 
 /**
  * Check if index is within (inclusive) limits
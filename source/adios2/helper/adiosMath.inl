@@ -14,146 +14,77 @@
 #error "Inline file should only be included from it's header, never on it's own"
 #endif
 
-#include <algorithm> //std::minmax_element, std::min_element, std::max_element
-#include <thread>
+#include <mutex>
 
 namespace adios2
 {
 
-template <class T>
-void GetMinMax(const T *values, const size_t size, T &min, T &max) noexcept
-{
-    auto bounds = std::minmax_element(values, values + size);
-    min = *bounds.first;
-    max = *bounds.second;
-}
-
-template <class T>
-void GetMinMaxComplex(const std::complex<T> *values, const size_t size, T &min,
-                      T &max) noexcept
-{
-
-    min = std::norm(values[0]);
-    max = min;
-
-    for (size_t i = 1; i < size; ++i)
-    {
-        T norm = std::norm(values[i]);
-
-        if (norm < min)
-        {
-            min = norm;
-            continue;
-        }
-
-        if (norm > max)
-        {
-            max = norm;
-        }
-    }
-
-    min = std::sqrt(min);
-    max = std::sqrt(max);
-}
-
 template <class T>
 void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
-                      const unsigned int threads) noexcept
+                      const unsigned int threads,
+                      ThreadPool *threadPool) noexcept
 {
-    if (threads == 1 || threads > size)
+    if (threads == 1 || threadPool == nullptr)
     {
         GetMinMax(values, size, min, max);
         return;
     }
 
-    const size_t stride = size / threads;    // elements per thread
-    const size_t remainder = size % threads; // remainder if not aligned
-    const size_t last = stride + remainder;
-
-    std::vector<T> mins(threads); // zero init
-    std::vector<T> maxs(threads); // zero init
-
-    std::vector<std::thread> getMinMaxThreads;
-    getMinMaxThreads.reserve(threads);
-
-    for (unsigned int t = 0; t < threads; ++t)
-    {
-        const size_t position = stride * t;
-
-        if (t == threads - 1)
-        {
-            getMinMaxThreads.push_back(
-                std::thread(adios2::GetMinMax<T>, &values[position], last,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-        else
-        {
-            getMinMaxThreads.push_back(
-                std::thread(adios2::GetMinMax<T>, &values[position], stride,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-    }
-
-    for (auto &getMinMaxThread : getMinMaxThreads)
-    {
-        getMinMaxThread.join();
-    }
-
-    auto itMin = std::min_element(mins.begin(), mins.end());
-    min = *itMin;
-
-    auto itMax = std::max_element(maxs.begin(), maxs.end());
-    max = *itMax;
+    std::mutex mutex;
+    bool first = true;
+
+    threadPool->ParallelFor(
+        size, ThreadPool::MinChunkBytes / sizeof(T), threads,
+        [&](const size_t begin, const size_t end) {
+            T rangeMin, rangeMax;
+            GetMinMax(&values[begin], end - begin, rangeMin, rangeMax);
+
+            // ranges of NaN values only are skipped, as NaN values in ranges
+            std::lock_guard<std::mutex> lock(mutex);
+            if (first || rangeMin < min || min != min)
+            {
+                min = rangeMin;
+            }
+            if (first || rangeMax > max || max != max)
+            {
+                max = rangeMax;
+            }
+            first = false;
+        });
 }
 
 template <class T>
 void GetMinMaxThreads(const std::complex<T> *values, const size_t size, T &min,
-                      T &max, const unsigned int threads) noexcept
+                      T &max, const unsigned int threads,
+                      ThreadPool *threadPool) noexcept
 {
-    if (threads == 1)
+    if (threads == 1 || threadPool == nullptr)
     {
         GetMinMaxComplex(values, size, min, max);
         return;
     }
 
-    const size_t stride = size / threads;    // elements per thread
-    const size_t remainder = size % threads; // remainder if not aligned
-    const size_t last = stride + remainder;
-
-    std::vector<T> mins(threads); // zero init
-    std::vector<T> maxs(threads); // zero init
-
-    std::vector<std::thread> getMinMaxThreads;
-    getMinMaxThreads.reserve(threads);
-
-    for (unsigned int t = 0; t < threads; ++t)
-    {
-        const size_t position = stride * t;
-
-        if (t == threads - 1)
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMaxComplex<T>, &values[position], last,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-        else
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMaxComplex<T>, &values[position], stride,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-    }
-
-    for (auto &getMinMaxThread : getMinMaxThreads)
-    {
-        getMinMaxThread.join();
-    }
-
-    auto itMin = std::min_element(mins.begin(), mins.end());
-    min = *itMin;
-
-    auto itMax = std::max_element(maxs.begin(), maxs.end());
-    max = *itMax;
+    std::mutex mutex;
+    bool first = true;
+
+    threadPool->ParallelFor(
+        size, ThreadPool::MinChunkBytes / sizeof(std::complex<T>), threads,
+        [&](const size_t begin, const size_t end) {
+            T rangeMin, rangeMax;
+            GetMinMaxComplex(&values[begin], end - begin, rangeMin, rangeMax);
+
+            // ranges of NaN values only are skipped, as NaN values in ranges
+            std::lock_guard<std::mutex> lock(mutex);
+            if (first || rangeMin < min || min != min)
+            {
+                min = rangeMin;
+            }
+            if (first || rangeMax > max || max != max)
+            {
+                max = rangeMax;
+            }
+            first = false;
+        });
 }
 
 } // end namespace adios2
@@ -0,0 +1,432 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosMemory.cpp
+ *
+ *  Created on: Feb 5, 2018
+ */
+
+#include "adiosMemory.h"
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::stable_sort, std::max, std::find
+#include <cstring>   //std::memcpy
+/// \endcond
+
+#include "adios2/helper/adiosMath.h" //LinearIndex, StartEndBox
+
+namespace adios2
+{
+
+namespace
+{
+
+/** a dimension of a box copy, strides in bytes */
+struct CopyDimension
+{
+    size_t Count;
+    size_t SourceStride;
+    size_t DestinationStride;
+};
+
+/** edge of the square tiles of a transposed copy, in elements */
+constexpr size_t TransposeTile = 32;
+
+/** element copy with a size known at compile time, inlined as moves */
+template <size_t N>
+struct FixedCopy
+{
+    void operator()(char *destination, const char *source) const noexcept
+    {
+        std::memcpy(destination, source, N);
+    }
+};
+
+struct VariableCopy
+{
+    size_t Size;
+
+    void operator()(char *destination, const char *source) const noexcept
+    {
+        std::memcpy(destination, source, Size);
+    }
+};
+
+/**
+ * Calls function(destination, source) at each point of dims, dims[0] is the
+ * fastest. 1-D and 2-D loops are unrolled, higher dimensions recurse on the
+ * slowest dimension.
+ */
+template <class F>
+void ForEachPoint(char *destination, const char *source,
+                  const CopyDimension *dims, const size_t dimensions,
+                  const F &function) noexcept
+{
+    switch (dimensions)
+    {
+    case 0:
+        function(destination, source);
+        break;
+
+    case 1:
+        for (size_t i = 0; i < dims[0].Count; ++i)
+        {
+            function(destination + i * dims[0].DestinationStride,
+                     source + i * dims[0].SourceStride);
+        }
+        break;
+
+    case 2:
+        for (size_t j = 0; j < dims[1].Count; ++j)
+        {
+            char *destinationJ = destination + j * dims[1].DestinationStride;
+            const char *sourceJ = source + j * dims[1].SourceStride;
+
+            for (size_t i = 0; i < dims[0].Count; ++i)
+            {
+                function(destinationJ + i * dims[0].DestinationStride,
+                         sourceJ + i * dims[0].SourceStride);
+            }
+        }
+        break;
+
+    default:
+    {
+        const CopyDimension &slowest = dims[dimensions - 1];
+        for (size_t k = 0; k < slowest.Count; ++k)
+        {
+            ForEachPoint(destination + k * slowest.DestinationStride,
+                         source + k * slowest.SourceStride, dims,
+                         dimensions - 1, function);
+        }
+    }
+    }
+}
+
+/**
+ * Copies dims element by element. If a dimension other than dims[0] is
+ * contiguous in source, dims[0] and that dimension are copied as a transpose
+ * in square tiles so both sides stay in cache.
+ */
+template <class Copy>
+void CopyElements(char *destination, const char *source,
+                  const std::vector<CopyDimension> &dims,
+                  const size_t elementSize, const Copy &copy) noexcept
+{
+    const CopyDimension &inner = dims.front();
+
+    size_t transposed = 0;
+    for (size_t d = 1; d < dims.size(); ++d)
+    {
+        if (dims[d].SourceStride == elementSize &&
+            inner.DestinationStride == elementSize)
+        {
+            transposed = d;
+            break;
+        }
+    }
+
+    if (transposed == 0)
+    {
+        ForEachPoint(destination, source, dims.data() + 1, dims.size() - 1,
+                     [&](char *destinationRow, const char *sourceRow) {
+                         for (size_t i = 0; i < inner.Count; ++i)
+                         {
+                             copy(destinationRow + i * inner.DestinationStride,
+                                  sourceRow + i * inner.SourceStride);
+                         }
+                     });
+        return;
+    }
+
+    const CopyDimension &other = dims[transposed];
+
+    std::vector<CopyDimension> outer;
+    outer.reserve(dims.size() - 2);
+    for (size_t d = 1; d < dims.size(); ++d)
+    {
+        if (d != transposed)
+        {
+            outer.push_back(dims[d]);
+        }
+    }
+
+    ForEachPoint(
+        destination, source, outer.data(), outer.size(),
+        [&](char *destinationPlane, const char *sourcePlane) {
+            for (size_t j0 = 0; j0 < other.Count; j0 += TransposeTile)
+            {
+                const size_t j1 = std::min(j0 + TransposeTile, other.Count);
+
+                for (size_t i0 = 0; i0 < inner.Count; i0 += TransposeTile)
+                {
+                    const size_t i1 =
+                        std::min(i0 + TransposeTile, inner.Count);
+
+                    for (size_t j = j0; j < j1; ++j)
+                    {
+                        char *destinationRow =
+                            destinationPlane + j * other.DestinationStride;
+                        const char *sourceRow =
+                            sourcePlane + j * other.SourceStride;
+
+                        for (size_t i = i0; i < i1; ++i)
+                        {
+                            copy(destinationRow + i * inner.DestinationStride,
+                                 sourceRow + i * inner.SourceStride);
+                        }
+                    }
+                }
+            }
+        });
+}
+
+/**
+ * Serial copy of normalized dims
+ * @param runBytes > elementSize: dims are all outer dimensions of contiguous
+ * runs, otherwise elements are copied one by one
+ */
+void CopyDimensions(char *destination, const char *source,
+                    const std::vector<CopyDimension> &dims,
+                    const size_t runBytes, const size_t elementSize) noexcept
+{
+    if (dims.empty() || runBytes > elementSize)
+    {
+        ForEachPoint(destination, source, dims.data(), dims.size(),
+                     [runBytes](char *destinationRun, const char *sourceRun) {
+                         std::memcpy(destinationRun, sourceRun, runBytes);
+                     });
+        return;
+    }
+
+    switch (elementSize)
+    {
+    case 1:
+        CopyElements(destination, source, dims, elementSize, FixedCopy<1>());
+        break;
+    case 2:
+        CopyElements(destination, source, dims, elementSize, FixedCopy<2>());
+        break;
+    case 4:
+        CopyElements(destination, source, dims, elementSize, FixedCopy<4>());
+        break;
+    case 8:
+        CopyElements(destination, source, dims, elementSize, FixedCopy<8>());
+        break;
+    case 16:
+        CopyElements(destination, source, dims, elementSize, FixedCopy<16>());
+        break;
+    default:
+        CopyElements(destination, source, dims, elementSize,
+                     VariableCopy{elementSize});
+    }
+}
+
+/** @return byte strides of a box, in the order of its dimensions */
+Dims GetStrides(const Box<Dims> &box, const bool isRowMajor,
+                const size_t elementSize)
+{
+    const size_t dimensions = box.first.size();
+    Dims strides(dimensions);
+
+    size_t stride = elementSize;
+    for (size_t i = 0; i < dimensions; ++i)
+    {
+        const size_t d = isRowMajor ? dimensions - 1 - i : i;
+        strides[d] = stride;
+        stride *= box.second[d] - box.first[d] + 1;
+    }
+    return strides;
+}
+
+} // end anonymous namespace
+
+void CopyMemoryBox(char *destination, const Box<Dims> &destinationBox,
+                   const bool destinationRowMajor, const char *source,
+                   const Box<Dims> &sourceBox, const bool sourceRowMajor,
+                   const Box<Dims> &intersectionBox, const size_t elementSize,
+                   const unsigned int threads, ThreadPool *threadPool) noexcept
+{
+    const Dims &start = intersectionBox.first;
+    const Dims &end = intersectionBox.second;
+    const size_t dimensions = start.size();
+
+    const Dims sourceStrides =
+        GetStrides(sourceBox, sourceRowMajor, elementSize);
+    const Dims destinationStrides =
+        GetStrides(destinationBox, destinationRowMajor, elementSize);
+
+    // single points don't move pointers
+    std::vector<CopyDimension> dims;
+    dims.reserve(dimensions);
+    for (size_t d = 0; d < dimensions; ++d)
+    {
+        const size_t count = end[d] - start[d] + 1;
+        if (count > 1)
+        {
+            dims.push_back({count, sourceStrides[d], destinationStrides[d]});
+        }
+    }
+
+    // fastest destination dimension first
+    std::stable_sort(dims.begin(), dims.end(),
+                     [](const CopyDimension &a, const CopyDimension &b) {
+                         return a.DestinationStride < b.DestinationStride;
+                     });
+
+    // collapse dimensions that are contiguous in both layouts
+    size_t collapsed = 0;
+    for (size_t d = 1; d < dims.size(); ++d)
+    {
+        CopyDimension &current = dims[collapsed];
+        if (dims[d].SourceStride == current.SourceStride * current.Count &&
+            dims[d].DestinationStride ==
+                current.DestinationStride * current.Count)
+        {
+            current.Count *= dims[d].Count;
+        }
+        else
+        {
+            dims[++collapsed] = dims[d];
+        }
+    }
+    if (!dims.empty())
+    {
+        dims.resize(collapsed + 1);
+    }
+
+    size_t runBytes = elementSize;
+    if (!dims.empty() && dims.front().SourceStride == elementSize &&
+        dims.front().DestinationStride == elementSize)
+    {
+        runBytes = dims.front().Count * elementSize;
+        dims.erase(dims.begin());
+    }
+
+    size_t totalBytes = runBytes;
+    for (const auto &dimension : dims)
+    {
+        totalBytes *= dimension.Count;
+    }
+
+    if (threads <= 1 || threadPool == nullptr ||
+        totalBytes < 2 * ThreadPool::MinChunkBytes)
+    {
+        CopyDimensions(destination, source, dims, runBytes, elementSize);
+        return;
+    }
+
+    if (dims.empty())
+    {
+        threadPool->ParallelFor(
+            runBytes, ThreadPool::MinChunkBytes, threads,
+            [&](const size_t first, const size_t last) {
+                std::memcpy(destination + first, source + first, last - first);
+            });
+        return;
+    }
+
+    // ranges of the slowest dimension
+    const CopyDimension slowest = dims.back();
+    const size_t sliceBytes = totalBytes / slowest.Count;
+
+    threadPool->ParallelFor(
+        slowest.Count,
+        std::max(ThreadPool::MinChunkBytes / sliceBytes, size_t(1)), threads,
+        [&](const size_t first, const size_t last) {
+            std::vector<CopyDimension> rangeDims(dims);
+            rangeDims.back().Count = last - first;
+            CopyDimensions(destination + first * slowest.DestinationStride,
+                           source + first * slowest.SourceStride, rangeDims,
+                           runBytes, elementSize);
+        });
+}
+
+void CopyFromMemorySelection(char *destination, const char *memory,
+                             const Dims &memoryStart, const Dims &memoryCount,
+                             const Dims &count, const bool isRowMajor,
+                             const size_t elementSize,
+                             const unsigned int threads,
+                             ThreadPool *threadPool) noexcept
+{
+    const Box<Dims> memoryBox =
+        StartEndBox(Dims(memoryCount.size(), 0), memoryCount);
+    const Box<Dims> selectionBox = StartEndBox(memoryStart, count);
+
+    const size_t memoryOffset =
+        LinearIndex(memoryBox, memoryStart, isRowMajor) * elementSize;
+
+    CopyMemoryBox(destination, selectionBox, isRowMajor,
+                  memory + memoryOffset, memoryBox, isRowMajor, selectionBox,
+                  elementSize, threads, threadPool);
+}
+
+void ForEachMemorySelectionRun(
+    const Dims &memoryStart, const Dims &memoryCount, const Dims &count,
+    const bool isRowMajor,
+    const std::function<void(const size_t, const size_t)> &function)
+{
+    const size_t dimensions = count.size();
+    if (std::find(count.begin(), count.end(), 0) != count.end())
+    {
+        return;
+    }
+
+    // fastest dimension first
+    Dims order(dimensions);
+    for (size_t i = 0; i < dimensions; ++i)
+    {
+        order[i] = isRowMajor ? dimensions - 1 - i : i;
+    }
+
+    size_t offset = 0;
+    size_t stride = 1;
+    Dims strides(dimensions);
+    for (const size_t d : order)
+    {
+        strides[d] = stride;
+        offset += memoryStart[d] * stride;
+        stride *= memoryCount[d];
+    }
+
+    // a run continues into the next dimension while the selection covers
+    // whole rows of the memory block
+    size_t runSize = 1;
+    size_t inner = 0;
+    while (inner < dimensions)
+    {
+        const size_t d = order[inner++];
+        runSize *= count[d];
+        if (count[d] != memoryCount[d])
+        {
+            break;
+        }
+    }
+
+    Dims index(dimensions, 0);
+    while (true)
+    {
+        function(offset, runSize);
+
+        size_t i = inner;
+        for (; i < dimensions; ++i)
+        {
+            const size_t d = order[i];
+            if (++index[d] < count[d])
+            {
+                offset += strides[d];
+                break;
+            }
+            offset -= (count[d] - 1) * strides[d];
+            index[d] = 0;
+        }
+
+        if (i == dimensions)
+        {
+            break;
+        }
+    }
+}
+
+} // end namespace adios2
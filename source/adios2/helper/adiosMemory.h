@@ -13,11 +13,13 @@
 #define ADIOS2_HELPER_ADIOSMEMORY_H_
 
 /// \cond EXCLUDE_FROM_DOXYGEN
+#include <functional>
 #include <string>
 #include <vector>
 /// \endcond
 
 #include "adios2/ADIOSTypes.h"
+#include "adios2/helper/adiosThreadPool.h"
 
 namespace adios2
 {
@@ -46,18 +48,21 @@ void CopyToBuffer(std::vector<char> &buffer, size_t &position, const T *source,
 
 /**
  * Copies data to a specific location in the buffer updating position using
- * threads.
+ * threads from a ThreadPool. Copies smaller than ThreadPool::MinChunkBytes per
+ * thread stay in the calling thread.
  * Does not update vec.size().
  * @param buffer data destination used in std::copy
  * @param position starting position in buffer (in terms of T not bytes)
  * @param source pointer to source data
  * @param elements number of elements of source type
  * @param threads number of threads sharing the copy load
+ * @param threadPool persistent workers, nullptr: serial copy
  */
 template <class T>
 void CopyToBufferThreads(std::vector<char> &buffer, size_t &position,
                          const T *source, const size_t elements = 1,
-                         const unsigned int threads = 1) noexcept;
+                         const unsigned int threads = 1,
+                         ThreadPool *threadPool = nullptr) noexcept;
 
 /**
  * Copy memory from a buffer at a certain input position
@@ -82,6 +87,65 @@ void InsertU64(std::vector<char> &buffer, const T element) noexcept;
 template <class T>
 T ReadValue(const std::vector<char> &buffer, size_t &position) noexcept;
 
+/**
+ * Copies the elements of intersectionBox between two N-dimensional blocks.
+ * Strides are precomputed, dimensions contiguous in both blocks are
+ * collapsed into single memcpy runs and different layouts (row-major and
+ * column-major) are copied as cache-blocked transposes.
+ * @param destination first intersection element in the destination block
+ * @param destinationBox destination block start and end (inclusive)
+ * @param destinationRowMajor destination block layout
+ * @param source first intersection element in the source block
+ * @param sourceBox source block start and end (inclusive)
+ * @param sourceRowMajor source block layout
+ * @param intersectionBox start and end (inclusive), inside both blocks
+ * @param elementSize bytes per element
+ * @param threads number of threads sharing the copy load
+ * @param threadPool persistent workers, nullptr: serial copy
+ */
+void CopyMemoryBox(char *destination, const Box<Dims> &destinationBox,
+                   const bool destinationRowMajor, const char *source,
+                   const Box<Dims> &sourceBox, const bool sourceRowMajor,
+                   const Box<Dims> &intersectionBox, const size_t elementSize,
+                   const unsigned int threads = 1,
+                   ThreadPool *threadPool = nullptr) noexcept;
+
+/**
+ * Gathers a memory selection, a box of count elements starting at
+ * memoryStart inside a larger memory block (e.g. without ghost cells), into
+ * contiguous memory
+ * @param destination count elements, same layout as memory
+ * @param memory first element of the memory block
+ * @param memoryStart selection start in the memory block
+ * @param memoryCount memory block dimensions
+ * @param count selection dimensions
+ * @param isRowMajor memory block layout
+ * @param elementSize bytes per element
+ * @param threads number of threads sharing the copy load
+ * @param threadPool persistent workers, nullptr: serial copy
+ */
+void CopyFromMemorySelection(char *destination, const char *memory,
+                             const Dims &memoryStart, const Dims &memoryCount,
+                             const Dims &count, const bool isRowMajor,
+                             const size_t elementSize,
+                             const unsigned int threads = 1,
+                             ThreadPool *threadPool = nullptr) noexcept;
+
+/**
+ * Visits the contiguous runs of a memory selection in memory order,
+ * dimensions fully covered by the selection are merged into longer runs
+ * @param memoryStart selection start in the memory block
+ * @param memoryCount memory block dimensions
+ * @param count selection dimensions
+ * @param isRowMajor memory block layout
+ * @param function called with the first element of a run (from the start of
+ * the memory block) and its number of elements
+ */
+void ForEachMemorySelectionRun(
+    const Dims &memoryStart, const Dims &memoryCount, const Dims &count,
+    const bool isRowMajor,
+    const std::function<void(const size_t, const size_t)> &function);
+
 } // end namespace adios2
 
 #include "adiosMemory.inl"
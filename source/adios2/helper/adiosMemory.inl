@@ -17,7 +17,6 @@
 /// \cond EXCLUDE_FROM_DOXYGEN
 #include <algorithm> //std::copy
 #include <cstring>   //std::memcpy
-#include <thread>
 /// \endcond
 
 namespace adios2
@@ -43,57 +42,24 @@ void CopyToBuffer(std::vector<char> &buffer, size_t &position, const T *source,
 template <class T>
 void CopyToBufferThreads(std::vector<char> &buffer, size_t &position,
                          const T *source, const size_t elements,
-                         const unsigned int threads) noexcept
+                         const unsigned int threads,
+                         ThreadPool *threadPool) noexcept
 {
-    if (threads == 1 || threads > elements)
+    if (threads == 1 || threadPool == nullptr)
     {
         CopyToBuffer(buffer, position, source, elements);
         return;
     }
 
-    const size_t stride = elements / threads;    // elements per thread
-    const size_t remainder = elements % threads; // remainder if not aligned
-    const size_t last = stride + remainder;
-
-    std::vector<std::thread> copyThreads;
-    copyThreads.reserve(threads);
-
     const char *src = reinterpret_cast<const char *>(source);
-
-    for (unsigned int t = 0; t < threads; ++t)
-    {
-        const size_t bufferStart = position + stride * t * sizeof(T);
-        const size_t srcStart = stride * t * sizeof(T);
-        if (t == threads - 1) // last thread takes stride + remainder
-        {
-            copyThreads.push_back(std::thread(std::memcpy, &buffer[bufferStart],
-                                              &src[srcStart],
-                                              last * sizeof(T)));
-            // std::copy not working properly with std::thread...why?
-            //            copyThreads.push_back(std::thread(std::copy,
-            //            &src[srcStart],
-            //                                              &src[srcStart] +
-            //                                              last * sizeof(T),
-            //                                              buffer.begin() +
-            //                                              bufferStart));
-        }
-        else
-        {
-            copyThreads.push_back(std::thread(std::memcpy, &buffer[bufferStart],
-                                              &src[srcStart],
-                                              stride * sizeof(T)));
-            // std::copy not working properly with std::thread...why?
-            //            copyThreads.push_back(std::thread(
-            //                std::copy, &src[srcStart], &src[srcStart] + stride
-            //                * sizeof(T),
-            //                buffer.begin() + bufferStart));
-        }
-    }
-
-    for (auto &copyThread : copyThreads)
-    {
-        copyThread.join();
-    }
+    char *destination = &buffer[position];
+
+    threadPool->ParallelFor(
+        elements, ThreadPool::MinChunkBytes / sizeof(T), threads,
+        [&](const size_t begin, const size_t end) {
+            std::memcpy(&destination[begin * sizeof(T)],
+                        &src[begin * sizeof(T)], (end - begin) * sizeof(T));
+        });
 
     position += elements * sizeof(T);
 }
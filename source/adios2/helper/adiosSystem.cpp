@@ -32,6 +32,11 @@ bool CreateDirectory(const std::string &fullPath) noexcept
     return adios2sys::SystemTools::MakeDirectory(fullPath);
 }
 
+bool FileExists(const std::string &fullPath) noexcept
+{
+    return adios2sys::SystemTools::FileExists(fullPath, true);
+}
+
 bool IsLittleEndian() noexcept
 {
     uint16_t hexa = 0x1234;
@@ -28,6 +28,14 @@ namespace adios2
  * @return true: directory exists, false: failed to create or access directory
  */
 bool CreateDirectory(const std::string &fullPath) noexcept;
+
+/**
+ * Check if a file exists using kwsys SystemTools
+ * @param fullPath /full/path/for/file
+ * @return true: file exists, false: doesn't exist or can't be accessed
+ */
+bool FileExists(const std::string &fullPath) noexcept;
+
 /**
  * Check if system is little endian
  * @return true: little endian, false: big endian
@@ -0,0 +1,266 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosThreadPool.cpp
+ *
+ *  Created on: Jan 22, 2018
+ */
+
+#include "adiosThreadPool.h"
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::min, std::max
+#include <exception> //std::exception_ptr
+/// \endcond
+
+namespace adios2
+{
+
+constexpr size_t ThreadPool::MinChunkBytes;
+
+ThreadPool::ThreadPool(const unsigned int threads)
+: m_Workers(std::make_shared<const Workers>()), m_Pending(0), m_Next(0),
+  m_Stop(false)
+{
+    Reserve(threads);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Stop = true;
+    }
+    m_WakeCondition.notify_all();
+
+    const auto workers = std::atomic_load(&m_Workers);
+    for (auto &worker : *workers)
+    {
+        if (worker->Thread.joinable())
+        {
+            worker->Thread.join();
+        }
+    }
+}
+
+void ThreadPool::Reserve(const unsigned int threads)
+{
+    std::lock_guard<std::mutex> lock(m_ReserveMutex);
+
+    const auto current = std::atomic_load(&m_Workers);
+    const size_t workersCount = (threads > 1) ? threads - 1 : 0;
+    if (current->size() >= workersCount)
+    {
+        return;
+    }
+
+    // new workers can only start after they are visible in the snapshot
+    auto workers = std::make_shared<Workers>(*current);
+    const size_t first = workers->size();
+    for (size_t w = first; w < workersCount; ++w)
+    {
+        workers->push_back(std::make_shared<Worker>());
+    }
+    std::atomic_store(&m_Workers, std::shared_ptr<const Workers>(workers));
+
+    for (size_t w = first; w < workersCount; ++w)
+    {
+        (*workers)[w]->Thread = std::thread(&ThreadPool::WorkerLoop, this, w);
+    }
+}
+
+unsigned int ThreadPool::GetWorkers() const noexcept
+{
+    return static_cast<unsigned int>(std::atomic_load(&m_Workers)->size());
+}
+
+void ThreadPool::ParallelFor(
+    const size_t size, const size_t minChunk, const unsigned int threads,
+    const std::function<void(const size_t, const size_t)> &function)
+{
+    const size_t workers = static_cast<size_t>(GetWorkers());
+    const size_t maxRanges = size / std::max(minChunk, size_t(1));
+    const size_t ranges = std::min(
+        {maxRanges, static_cast<size_t>(threads), workers + 1});
+
+    if (ranges <= 1)
+    {
+        function(0, size);
+        return;
+    }
+
+    // lives in the caller's stack until all ranges are done
+    struct Group
+    {
+        size_t Remaining;
+        std::exception_ptr Exception;
+        std::mutex Mutex;
+        std::condition_variable Condition;
+    } group;
+    group.Remaining = ranges - 1;
+
+    auto lf_Done = [&group](std::exception_ptr exception) {
+        std::lock_guard<std::mutex> lock(group.Mutex);
+        if (exception && !group.Exception)
+        {
+            group.Exception = exception;
+        }
+        if (--group.Remaining == 0)
+        {
+            group.Condition.notify_all();
+        }
+    };
+
+    const size_t stride = size / ranges;
+    const size_t remainder = size % ranges;
+
+    // range r starts at r * stride + min(r, remainder)
+    for (size_t r = 1; r < ranges; ++r)
+    {
+        const size_t begin = r * stride + std::min(r, remainder);
+        const size_t end = begin + stride + (r < remainder ? 1 : 0);
+
+        Push([&function, &lf_Done, begin, end]() {
+            std::exception_ptr exception;
+            try
+            {
+                function(begin, end);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            lf_Done(exception);
+        });
+    }
+
+    std::exception_ptr callerException;
+    try
+    {
+        function(0, stride + (remainder > 0 ? 1 : 0));
+    }
+    catch (...)
+    {
+        callerException = std::current_exception();
+    }
+
+    // help instead of blocking while ranges are still queued
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(group.Mutex);
+            if (group.Remaining == 0)
+            {
+                break;
+            }
+        }
+        if (!RunPendingTask())
+        {
+            break;
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(group.Mutex);
+        group.Condition.wait(lock, [&group] { return group.Remaining == 0; });
+    }
+
+    if (callerException)
+    {
+        std::rethrow_exception(callerException);
+    }
+    if (group.Exception)
+    {
+        std::rethrow_exception(group.Exception);
+    }
+}
+
+// PRIVATE
+void ThreadPool::WorkerLoop(const size_t index)
+{
+    Task task;
+
+    while (true)
+    {
+        const auto workers = std::atomic_load(&m_Workers);
+        if (Pop(*workers, index, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+        if (m_Stop && m_Pending == 0)
+        {
+            break;
+        }
+        m_WakeCondition.wait(lock, [this] { return m_Stop || m_Pending > 0; });
+    }
+}
+
+void ThreadPool::Push(Task &&task)
+{
+    const auto workers = std::atomic_load(&m_Workers);
+    const size_t index = m_Next++ % workers->size();
+    Worker &worker = *(*workers)[index];
+    {
+        std::lock_guard<std::mutex> lock(worker.Mutex);
+        worker.Tasks.push_back(std::move(task));
+    }
+
+    // increment under the wake mutex, a worker can't miss the notification
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        ++m_Pending;
+    }
+    m_WakeCondition.notify_one();
+}
+
+bool ThreadPool::Pop(const Workers &workers, const size_t index, Task &task)
+{
+    const size_t size = workers.size();
+    for (size_t i = 0; i < size; ++i)
+    {
+        Worker &worker = *workers[(index + i) % size];
+        std::lock_guard<std::mutex> lock(worker.Mutex);
+        if (worker.Tasks.empty())
+        {
+            continue;
+        }
+
+        if (i == 0)
+        {
+            task = std::move(worker.Tasks.back());
+            worker.Tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(worker.Tasks.front());
+            worker.Tasks.pop_front();
+        }
+        --m_Pending;
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::RunPendingTask()
+{
+    const auto workers = std::atomic_load(&m_Workers);
+    if (workers->empty())
+    {
+        return false;
+    }
+
+    Task task;
+    if (!Pop(*workers, m_Next % workers->size(), task))
+    {
+        return false;
+    }
+    task();
+    return true;
+}
+
+} // end namespace adios2
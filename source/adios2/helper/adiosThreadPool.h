@@ -0,0 +1,129 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosThreadPool.h : persistent work-stealing thread pool owned by the ADIOS
+ * class, shared by its IO objects, engines and helper functions
+ *
+ *  Created on: Jan 22, 2018
+ */
+
+#ifndef ADIOS2_HELPER_ADIOSTHREADPOOL_H_
+#define ADIOS2_HELPER_ADIOSTHREADPOOL_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory> //std::shared_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+/// \endcond
+
+#include "adios2/ADIOSTypes.h"
+
+namespace adios2
+{
+
+class ThreadPool
+{
+
+public:
+    /**
+     * Minimum bytes per task used by helper functions (copies, min/max),
+     * smaller ranges run inline in the calling thread
+     */
+    static constexpr size_t MinChunkBytes = 256 * 1024;
+
+    /**
+     * Unique constructor, workers are created lazily with Reserve
+     * @param threads initial number of threads, including the caller
+     */
+    ThreadPool(const unsigned int threads = 1);
+
+    /** Stops and joins all workers, pending tasks are executed first */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Grows the pool so that threads (caller + workers) can run
+     * concurrently, never shrinks. Thread-safe.
+     * @param threads from Threads parameter
+     */
+    void Reserve(const unsigned int threads);
+
+    /** @return current number of worker threads, excluding callers */
+    unsigned int GetWorkers() const noexcept;
+
+    /**
+     * Splits [0, size) into at most threads contiguous ranges of at least
+     * minChunk elements and runs function(begin, end) on each. The caller
+     * runs the first range and executes pending tasks while waiting, so
+     * nested calls do not deadlock. Runs inline if only one range results.
+     * The first exception thrown by function is rethrown in the caller.
+     * @param size number of elements
+     * @param minChunk minimum number of elements per range
+     * @param threads maximum number of concurrent ranges
+     * @param function called with [begin, end) element ranges
+     */
+    void ParallelFor(
+        const size_t size, const size_t minChunk, const unsigned int threads,
+        const std::function<void(const size_t, const size_t)> &function);
+
+private:
+    using Task = std::function<void()>;
+
+    /** per worker double-ended queue, owner pops back, thieves pop front */
+    struct Worker
+    {
+        std::deque<Task> Tasks;
+        std::mutex Mutex;
+        std::thread Thread;
+    };
+
+    using Workers = std::vector<std::shared_ptr<Worker>>;
+
+    /** copy-on-write snapshot, replaced atomically in Reserve */
+    std::shared_ptr<const Workers> m_Workers;
+
+    /** serializes Reserve calls */
+    std::mutex m_ReserveMutex;
+
+    /** tasks queued and not yet taken by any thread */
+    std::atomic<size_t> m_Pending;
+
+    /** round-robin index for task placement */
+    std::atomic<size_t> m_Next;
+
+    std::atomic<bool> m_Stop;
+
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCondition;
+
+    /** Main loop of worker index, runs until m_Stop and no pending tasks */
+    void WorkerLoop(const size_t index);
+
+    /** Places task in the next worker queue and wakes up one worker */
+    void Push(Task &&task);
+
+    /**
+     * Pops a task from workers' own queue (back) or steals from others
+     * (front) starting at index
+     * @return true if a task was found
+     */
+    bool Pop(const Workers &workers, const size_t index, Task &task);
+
+    /**
+     * Runs one pending task from any queue, used by waiting callers
+     * @return true if a task was executed
+     */
+    bool RunPendingTask();
+};
+
+} // end namespace adios2
+
+#endif /* ADIOS2_HELPER_ADIOSTHREADPOOL_H_ */
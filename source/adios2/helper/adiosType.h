@@ -31,6 +31,20 @@ struct SubFileInfo
     Box<Dims> BlockBox;
     Box<Dims> IntersectionBox; ///< first = Start point, second = End point
     Box<size_t> Seeks;         ///< first = Start seek, second = End seek
+
+    /** untransformed blocks only, seeks of the contiguous pieces of
+     * IntersectionBox inside Seeks, empty: Seeks is read as a whole */
+    std::vector<Box<size_t>> Runs;
+
+    /** operator type if the block is stored transformed, empty otherwise */
+    std::string TransformType;
+    /** operator parameters required to invert the transform */
+    Params TransformParameters;
+    /** transformed blocks only, Seeks cover the whole stored block and these
+     * the IntersectionBox in the untransformed block */
+    Box<size_t> PreTransformSeeks;
+    /** transformed blocks only, untransformed block size in bytes */
+    size_t PreTransformSize = 0;
 };
 
 /**
@@ -0,0 +1,133 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPIAggregator.cpp
+ *
+ *  Created on: Feb 20, 2018
+ *      Author: William F Godoy godoywf@ornl.gov
+ */
+
+#include "MPIAggregator.h"
+
+#include <algorithm> //std::min
+#include <climits>   //INT_MAX
+#include <numeric>   //std::accumulate
+
+#include "adios2/ADIOSMPI.h"
+
+namespace adios2
+{
+namespace aggregator
+{
+
+MPIAggregator::~MPIAggregator() { Close(); }
+
+void MPIAggregator::Init(const size_t subStreams, MPI_Comm parentComm)
+{
+    int parentRank = 0;
+    int parentSize = 1;
+    MPI_Comm_rank(parentComm, &parentRank);
+    MPI_Comm_size(parentComm, &parentSize);
+
+    m_SubStreams = std::min(subStreams, static_cast<size_t>(parentSize));
+
+    // contiguous, balanced groups of ranks
+    m_SubStreamIndex = static_cast<size_t>(parentRank) * m_SubStreams /
+                       static_cast<size_t>(parentSize);
+
+    MPI_Comm_split(parentComm, static_cast<int>(m_SubStreamIndex), parentRank,
+                   &m_Comm);
+    MPI_Comm_rank(m_Comm, &m_Rank);
+    MPI_Comm_size(m_Comm, &m_Size);
+
+    m_IsConsumer = (m_Rank == 0);
+    m_IsActive = true;
+}
+
+size_t MPIAggregator::GetSubFileOffset(const size_t size)
+{
+    m_Sizes.resize(m_Size);
+    MPI_Allgather(&size, 1, ADIOS2_MPI_SIZE_T, m_Sizes.data(), 1,
+                  ADIOS2_MPI_SIZE_T, m_Comm);
+
+    const size_t offset = std::accumulate(
+        m_Sizes.begin(), m_Sizes.begin() + m_Rank, m_SubFileSize);
+
+    m_SubFileSize =
+        std::accumulate(m_Sizes.begin(), m_Sizes.end(), m_SubFileSize);
+
+    return offset;
+}
+
+void MPIAggregator::Gather(
+    const char *buffer, const size_t size,
+    const std::function<void(const char *, const size_t)> &lf_Write)
+{
+    if (!m_IsConsumer)
+    {
+        Send(buffer, size, 0);
+        return;
+    }
+
+    lf_Write(buffer, size);
+
+    for (int r = 1; r < m_Size; ++r)
+    {
+        const size_t rankSize = m_Sizes[r];
+        if (rankSize == 0)
+        {
+            continue;
+        }
+
+        m_ReceiveBuffer.resize(rankSize);
+        Receive(m_ReceiveBuffer.data(), rankSize, r);
+        lf_Write(m_ReceiveBuffer.data(), rankSize);
+    }
+}
+
+void MPIAggregator::Close()
+{
+    if (m_IsActive)
+    {
+        MPI_Comm_free(&m_Comm);
+        m_IsActive = false;
+    }
+}
+
+// PRIVATE
+void MPIAggregator::Send(const char *buffer, const size_t size,
+                         const int destination)
+{
+    // MPI counts are int, send in batches for buffers larger than 2GB
+    const size_t batchSize = static_cast<size_t>(INT_MAX);
+    size_t position = 0;
+
+    while (position < size)
+    {
+        const int count =
+            static_cast<int>(std::min(batchSize, size - position));
+        MPI_Send(const_cast<char *>(buffer + position), count, MPI_CHAR,
+                 destination, 0, m_Comm);
+        position += static_cast<size_t>(count);
+    }
+}
+
+void MPIAggregator::Receive(char *buffer, const size_t size, const int source)
+{
+    const size_t batchSize = static_cast<size_t>(INT_MAX);
+    size_t position = 0;
+
+    while (position < size)
+    {
+        const int count =
+            static_cast<int>(std::min(batchSize, size - position));
+        MPI_Status status;
+        MPI_Recv(buffer + position, count, MPI_CHAR, source, 0, m_Comm,
+                 &status);
+        position += static_cast<size_t>(count);
+    }
+}
+
+} // end namespace aggregator
+} // end namespace adios2
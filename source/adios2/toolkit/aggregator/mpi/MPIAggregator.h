@@ -0,0 +1,110 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPIAggregator.h : groups MPI processes into sub-streams, each sub-stream
+ * writes a single sub-file through its consumer (aggregator) rank
+ *
+ *  Created on: Feb 20, 2018
+ *      Author: William F Godoy godoywf@ornl.gov
+ */
+
+#ifndef ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPIAGGREGATOR_H_
+#define ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPIAGGREGATOR_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <functional>
+#include <vector>
+/// \endcond
+
+#include "adios2/ADIOSConfig.h"
+#include "adios2/ADIOSMPICommOnly.h"
+#include "adios2/ADIOSTypes.h"
+
+namespace adios2
+{
+namespace aggregator
+{
+
+class MPIAggregator
+{
+
+public:
+    /** total number of substreams (sub-files) */
+    size_t m_SubStreams = 0;
+
+    /** current substream index from 0 to m_SubStreams-1, used as file index */
+    size_t m_SubStreamIndex = 0;
+
+    /** split communicator, one per substream, MPI_COMM_NULL until Init */
+    MPI_Comm m_Comm = MPI_COMM_NULL;
+
+    /** rank in m_Comm */
+    int m_Rank = 0;
+
+    /** size of m_Comm */
+    int m_Size = 1;
+
+    /** true: this rank is the consumer (rank 0 in m_Comm) writing the
+     * sub-file */
+    bool m_IsConsumer = true;
+
+    /** true: Init was called and aggregation is used */
+    bool m_IsActive = false;
+
+    /** current sub-file size, only tracked by producers and consumers as a
+     * running sum of all Write calls */
+    size_t m_SubFileSize = 0;
+
+    MPIAggregator() = default;
+
+    /** frees m_Comm if Close was not called */
+    ~MPIAggregator();
+
+    /**
+     * Splits parentComm into subStreams contiguous groups of ranks
+     * @param subStreams number of sub-files, must be >= 1 and is capped to
+     * the size of parentComm
+     * @param parentComm communicator to be split, collective call
+     */
+    void Init(const size_t subStreams, MPI_Comm parentComm);
+
+    /**
+     * Collective in m_Comm. Computes where each rank's buffer will land in the
+     * sub-file and advances m_SubFileSize by the total size of the group.
+     * @param size bytes to be written by this rank
+     * @return offset of this rank's bytes in the sub-file
+     */
+    size_t GetSubFileOffset(const size_t size);
+
+    /**
+     * Collective in m_Comm. Producers send their buffer to the consumer,
+     * which calls lf_Write for its own buffer and then for each producer's
+     * buffer in rank order, so only one extra buffer is held at a time.
+     * @param buffer this rank's data
+     * @param size bytes in buffer
+     * @param lf_Write consumer write function (buffer, size)
+     */
+    void
+    Gather(const char *buffer, const size_t size,
+           const std::function<void(const char *, const size_t)> &lf_Write);
+
+    /** Frees m_Comm, must be called before MPI_Finalize */
+    void Close();
+
+private:
+    /** sizes of each rank in m_Comm from latest GetSubFileOffset */
+    std::vector<size_t> m_Sizes;
+
+    /** reusable receive buffer at the consumer */
+    std::vector<char> m_ReceiveBuffer;
+
+    void Send(const char *buffer, const size_t size, const int destination);
+
+    void Receive(char *buffer, const size_t size, const int source);
+};
+
+} // end namespace aggregator
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPIAGGREGATOR_H_ */
@@ -10,6 +10,10 @@
 
 #include "BufferSTL.h"
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::fill, std::max
+/// \endcond
+
 namespace adios2
 {
 
@@ -32,4 +36,67 @@ size_t BufferSTL::GetAvailableSize() const
     return m_Buffer.size() - m_Position;
 }
 
+void BufferSTL::AddChunk(const size_t size, const std::string hint)
+{
+    const size_t chunkSize = std::max(size, m_ChunkSize);
+
+    m_Chunks.emplace_back(std::vector<char>(), m_Position);
+    m_Chunks.back().first.swap(m_Buffer);
+    m_ChunksSize += m_Position;
+    m_Position = 0;
+
+    for (auto itChunk = m_ChunksPool.begin(); itChunk != m_ChunksPool.end();
+         ++itChunk)
+    {
+        if (itChunk->size() >= chunkSize)
+        {
+            m_Buffer.swap(*itChunk);
+            m_ChunksPool.erase(itChunk);
+            return;
+        }
+    }
+
+    Resize(chunkSize, hint);
+}
+
+void BufferSTL::ReserveChunk(const size_t size, const std::string hint)
+{
+    if (m_ChunkSize > 0 && GetAvailableSize() < size)
+    {
+        AddChunk(size, hint);
+    }
+}
+
+void BufferSTL::ReleaseChunks()
+{
+    // bytes past the used ones were never written
+    for (auto &chunk : m_Chunks)
+    {
+        std::fill(chunk.first.begin(), chunk.first.begin() + chunk.second,
+                  '\0');
+        m_ChunksPool.push_back(std::move(chunk.first));
+    }
+    m_Chunks.clear();
+    m_ChunksSize = 0;
+}
+
+size_t BufferSTL::GetDataSize() const noexcept
+{
+    return m_ChunksSize + m_Position;
+}
+
+char *BufferSTL::GetData(const size_t dataPosition) noexcept
+{
+    size_t chunkStart = 0;
+    for (auto &chunk : m_Chunks)
+    {
+        if (dataPosition < chunkStart + chunk.second)
+        {
+            return chunk.first.data() + dataPosition - chunkStart;
+        }
+        chunkStart += chunk.second;
+    }
+    return m_Buffer.data() + dataPosition - chunkStart;
+}
+
 } // end namespace adios2
@@ -12,6 +12,7 @@
 #define ADIOS2_TOOLKIT_FORMAT_BUFFERSTL_H_
 
 #include <string>
+#include <utility> //std::pair
 #include <vector>
 
 #include "adios2/ADIOSTypes.h"
@@ -22,10 +23,21 @@ namespace adios2
 class BufferSTL
 {
 public:
+    /** contiguous buffer, or chunk being written if m_ChunkSize > 0 */
     std::vector<char> m_Buffer;
     size_t m_Position = 0;
     size_t m_AbsolutePosition = 0;
 
+    /** > 0: new data goes to chunks of at least this size instead of
+     * growing m_Buffer, 0 (default): m_Buffer is the only buffer */
+    size_t m_ChunkSize = 0;
+
+    /** sealed chunks in write order, first: chunk, second: bytes used */
+    std::vector<std::pair<std::vector<char>, size_t>> m_Chunks;
+
+    /** total bytes used in m_Chunks */
+    size_t m_ChunksSize = 0;
+
     BufferSTL() = default;
     ~BufferSTL() = default;
 
@@ -33,8 +45,38 @@ public:
 
     size_t GetAvailableSize() const;
 
+    /**
+     * Seals m_Buffer at m_Position and continues in a released chunk or a
+     * new one, m_Position is set to 0
+     * @param size minimum chunk size, chunks are at least m_ChunkSize
+     * @param hint for exception handling
+     */
+    void AddChunk(const size_t size, const std::string hint);
+
+    /**
+     * Chunked only: calls AddChunk if m_Buffer has less than size bytes left,
+     * records up to size bytes can then be written and patched in place
+     */
+    void ReserveChunk(const size_t size, const std::string hint);
+
+    /** Zeroes and keeps sealed chunks for reuse by AddChunk */
+    void ReleaseChunks();
+
+    /** @return bytes written in sealed chunks and m_Buffer */
+    size_t GetDataSize() const noexcept;
+
+    /**
+     * @param dataPosition position from the start of the first chunk, as
+     * returned by GetDataSize
+     * @return pointer to the byte in a sealed chunk or m_Buffer
+     */
+    char *GetData(const size_t dataPosition) noexcept;
+
 private:
     const bool m_DebugMode = false;
+
+    /** released chunks, reused before allocating new ones */
+    std::vector<std::vector<char>> m_ChunksPool;
 };
 
 } // end namespace adios2
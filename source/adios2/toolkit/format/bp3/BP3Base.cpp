@@ -75,6 +75,34 @@ void BP3Base::InitParameters(const Params &parameters)
         {
             InitParameterFlushStepsCount(value);
         }
+        else if (key == "Aggregators" || key == "SubStreams")
+        {
+            InitParameterSubStreams(value);
+        }
+        else if (key == "AsyncWrite")
+        {
+            InitParameterAsyncWrite(value);
+        }
+        else if (key == "ReadGapSize")
+        {
+            InitParameterReadGapSize(value);
+        }
+        else if (key == "BufferChunkSize")
+        {
+            InitParameterBufferChunkSize(value);
+        }
+        else if (key == "MetadataFanIn")
+        {
+            InitParameterMetadataFanIn(value);
+        }
+        else if (key == "ZeroCopy")
+        {
+            InitParameterZeroCopy(value);
+        }
+        else if (key == "StatsSum")
+        {
+            InitParameterStatsSum(value);
+        }
     }
 
     // default timer for buffering
@@ -91,6 +119,15 @@ void BP3Base::InitParameters(const Params &parameters)
     {
         m_Data.Resize(DefaultInitialBufferSize, "in call to Open");
     }
+
+    if (m_Threads > 1)
+    {
+        if (!m_ThreadPool)
+        {
+            m_ThreadPool = std::make_shared<ThreadPool>();
+        }
+        m_ThreadPool->Reserve(m_Threads);
+    }
 }
 
 std::vector<std::string>
@@ -139,8 +176,7 @@ BP3Base::GetBPRankNames(const std::vector<std::string> &names) const noexcept
 
     for (const auto &name : names)
     {
-        bpNames.push_back(
-            GetBPRankName(name, static_cast<unsigned int>(m_RankMPI)));
+        bpNames.push_back(GetBPRankName(name, GetFileIndex()));
     }
     return bpNames;
 }
@@ -151,6 +187,28 @@ std::string BP3Base::GetBPSubFileName(const std::string &name,
     return GetBPRankName(name, subFileIndex);
 }
 
+std::string BP3Base::GetBPStepMetadataFileName(const std::string &name) const
+    noexcept
+{
+    const std::string bpName = AddExtension(name, ".bp");
+
+    // path/root.bp.dir/root.bp.md
+    std::string bpRoot = bpName;
+    const auto lastPathSeparator(bpName.find_last_of(PathSeparator));
+
+    if (lastPathSeparator != std::string::npos)
+    {
+        bpRoot = bpName.substr(lastPathSeparator);
+    }
+    return bpName + ".dir" + PathSeparator + bpRoot + ".md";
+}
+
+std::string
+BP3Base::GetBPStepMetadataIndexFileName(const std::string &name) const noexcept
+{
+    return GetBPStepMetadataFileName(name) + ".idx";
+}
+
 size_t BP3Base::GetVariableBPIndexSize(const std::string &variableName,
                                        const Dims &variableCount) const noexcept
 {
@@ -179,9 +237,64 @@ size_t BP3Base::GetVariableBPIndexSize(const std::string &variableName,
         indexSize += 1 + 1; // id
     }
 
+    // bitmap (id + 4) and stat with sum and sum of squares (id + 2 * 8)
+    if (m_StatsSum)
+    {
+        indexSize += 5 + 17;
+    }
+
     return indexSize + 12; // extra 12 bytes in case of attributes
 }
 
+size_t BP3Base::GetVariableBPIndexSize(const VariableBase &variable) const
+    noexcept
+{
+    size_t indexSize =
+        GetVariableBPIndexSize(variable.m_Name, variable.m_Count);
+
+    const VariableBase::OperatorInfo *operatorInfo =
+        GetCompressionOperator(variable);
+    if (operatorInfo == nullptr)
+    {
+        return indexSize;
+    }
+
+    // characteristic_transform_type: id, type name, pre-transform type,
+    // dimensions count, length and values, parameters count
+    indexSize += 1 + 2 + operatorInfo->ADIOSOperator.m_Type.size() + 1;
+    indexSize += 1 + 2 + 8 * variable.m_Count.size();
+    indexSize += 1;
+
+    // variable and operator parameters, duplicated keys are counted twice
+    auto lf_ParametersSize = [](const Params &parameters) -> size_t {
+        size_t size = 0;
+        for (const auto &parameter : parameters)
+        {
+            size += 2 + parameter.first.size() + 2 + parameter.second.size();
+        }
+        return size;
+    };
+    indexSize += lf_ParametersSize(operatorInfo->Parameters);
+    indexSize += lf_ParametersSize(operatorInfo->ADIOSOperator.GetParameters());
+
+    indexSize += 8; // transformed size
+    return indexSize;
+}
+
+const VariableBase::OperatorInfo *
+BP3Base::GetCompressionOperator(const VariableBase &variable) const noexcept
+{
+    for (const auto &operatorInfo : variable.m_OperatorsInfo)
+    {
+        const std::string &type = operatorInfo.ADIOSOperator.m_Type;
+        if (type == "bzip2" || type == "zfp")
+        {
+            return &operatorInfo;
+        }
+    }
+    return nullptr;
+}
+
 void BP3Base::ResetBuffer(BufferSTL &bufferSTL,
                           const bool resetAbsolutePosition)
 {
@@ -191,6 +304,7 @@ void BP3Base::ResetBuffer(BufferSTL &bufferSTL,
         bufferSTL.m_AbsolutePosition = 0;
     }
     bufferSTL.m_Buffer.assign(bufferSTL.m_Buffer.size(), '\0');
+    bufferSTL.ReleaseChunks();
 }
 
 BP3Base::ResizeResult BP3Base::ResizeBuffer(const size_t dataIn,
@@ -213,7 +327,26 @@ BP3Base::ResizeResult BP3Base::ResizeBuffer(const size_t dataIn,
             hint + "\n");
     }
 
-    if (requiredCapacity <= currentCapacity)
+    if (m_Data.m_ChunkSize > 0)
+    {
+        // sealed chunks are never moved, data goes to a new chunk
+        if (dataIn <= m_Data.GetAvailableSize())
+        {
+            // do nothing, unchanged is default
+        }
+        else if (m_Data.GetDataSize() + dataIn > m_MaxBufferSize)
+        {
+            result = ResizeResult::Flush;
+        }
+        else
+        {
+            m_Data.AddChunk(dataIn, " when adding a buffer chunk of " +
+                                        std::to_string(dataIn) + "bytes, " +
+                                        hint);
+            result = ResizeResult::Success;
+        }
+    }
+    else if (requiredCapacity <= currentCapacity)
     {
         // do nothing, unchanged is default
     }
@@ -249,11 +382,11 @@ BP3Base::ResizeResult BP3Base::ResizeBuffer(const size_t dataIn,
 void BP3Base::InitOnOffParameter(const std::string value, bool &parameter,
                                  const std::string hint)
 {
-    if (value == "off" || value == "Off")
+    if (value == "off" || value == "Off" || value == "false")
     {
         parameter = false;
     }
-    else if (value == "on" || value == "On")
+    else if (value == "on" || value == "On" || value == "true")
     {
         parameter = true;
     }
@@ -459,6 +592,42 @@ void BP3Base::InitParameterThreads(const std::string value)
     m_Threads = static_cast<unsigned int>(threads);
 }
 
+void BP3Base::InitParameterMetadataFanIn(const std::string value)
+{
+    int fanIn = -1;
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            fanIn = std::stoi(value);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success || fanIn < 0 || fanIn == 1)
+        {
+            throw std::invalid_argument(
+                "ERROR: value in MetadataFanIn=value in IO SetParameters must "
+                "be 0 (default, gather in rank 0) or an integer >= 2 "
+                "\nadditional description: " +
+                description + "\n, in call to Open\n");
+        }
+    }
+    else
+    {
+        fanIn = std::stoi(value);
+    }
+
+    m_MetadataFanIn = (fanIn < 2) ? 0 : static_cast<unsigned int>(fanIn);
+}
+
 void BP3Base::InitParameterVerbose(const std::string value)
 {
     int verbosity = -1;
@@ -501,6 +670,120 @@ void BP3Base::InitParameterCollectiveMetadata(const std::string value)
                        "valid: CollectiveMetadata On or Off");
 }
 
+void BP3Base::InitParameterAsyncWrite(const std::string value)
+{
+    InitOnOffParameter(value, m_AsyncWrite,
+                       "valid: AsyncWrite On (true) or Off (false)");
+}
+
+void BP3Base::InitParameterZeroCopy(const std::string value)
+{
+    InitOnOffParameter(value, m_ZeroCopy,
+                       "valid: ZeroCopy On (true) or Off (false)");
+}
+
+void BP3Base::InitParameterStatsSum(const std::string value)
+{
+    InitOnOffParameter(value, m_StatsSum,
+                       "valid: StatsSum On (true) or Off (false)");
+}
+
+void BP3Base::InitParameterReadGapSize(const std::string value)
+{
+    if (m_DebugMode)
+    {
+        if (value.size() < 3)
+        {
+            throw std::invalid_argument(
+                "ERROR: couldn't convert value of ReadGapSize IO "
+                "SetParameter, valid syntax: ReadGapSize=64Kb (default), "
+                "ReadGapSize=1Mb, in call to Open\n");
+        }
+    }
+
+    const std::string number(value.substr(0, value.size() - 2));
+    const std::string units(value.substr(value.size() - 2));
+    const size_t factor = BytesFactor(units, m_DebugMode);
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            m_ReadGapSize = static_cast<size_t>(std::stoul(number) * factor);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success)
+        {
+            throw std::invalid_argument(
+                "ERROR: couldn't convert value of ReadGapSize IO "
+                "SetParameter, valid syntax: ReadGapSize=64Kb (default), "
+                "ReadGapSize=1Mb, additional description: " +
+                description + " in call to Open\n");
+        }
+    }
+    else
+    {
+        m_ReadGapSize = static_cast<size_t>(std::stoul(number) * factor);
+    }
+}
+
+void BP3Base::InitParameterBufferChunkSize(const std::string value)
+{
+    if (m_DebugMode)
+    {
+        if (value.size() < 3)
+        {
+            throw std::invalid_argument(
+                "ERROR: couldn't convert value of BufferChunkSize IO "
+                "SetParameter, valid syntax: BufferChunkSize=0Mb (default, "
+                "contiguous buffer), BufferChunkSize=16Mb, in call to Open\n");
+        }
+    }
+
+    const std::string number(value.substr(0, value.size() - 2));
+    const std::string units(value.substr(value.size() - 2));
+    const size_t factor = BytesFactor(units, m_DebugMode);
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            m_BufferChunkSize =
+                static_cast<size_t>(std::stoul(number) * factor);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success)
+        {
+            throw std::invalid_argument(
+                "ERROR: couldn't convert value of BufferChunkSize IO "
+                "SetParameter, valid syntax: BufferChunkSize=0Mb (default, "
+                "contiguous buffer), BufferChunkSize=16Mb, additional "
+                "description: " +
+                description + " in call to Open\n");
+        }
+    }
+    else
+    {
+        m_BufferChunkSize = static_cast<size_t>(std::stoul(number) * factor);
+    }
+}
+
 void BP3Base::InitParameterFlushStepsCount(const std::string value)
 {
     long long int flushStepsCount = -1;
@@ -536,6 +819,52 @@ void BP3Base::InitParameterFlushStepsCount(const std::string value)
     m_FlushStepsCount = static_cast<size_t>(flushStepsCount);
 }
 
+void BP3Base::InitParameterSubStreams(const std::string value)
+{
+    long long int subStreams = -1;
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            subStreams = std::stoll(value);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success || subStreams < 1)
+        {
+            throw std::invalid_argument(
+                "ERROR: value in Aggregators=value or SubStreams=value in IO "
+                "SetParameters must be an integer >= 1, capped to the number "
+                "of MPI processes \nadditional description: " +
+                description + "\n, in call to Open\n");
+        }
+    }
+    else
+    {
+        subStreams = std::stoll(value);
+    }
+
+    m_SubStreams = static_cast<size_t>(subStreams);
+}
+
+uint32_t BP3Base::GetFileIndex() const noexcept
+{
+    if (m_Aggregator.m_IsActive)
+    {
+        return static_cast<uint32_t>(m_Aggregator.m_SubStreamIndex);
+    }
+
+    return static_cast<uint32_t>(m_RankMPI);
+}
+
 std::vector<uint8_t>
 BP3Base::GetTransportIDs(const std::vector<std::string> &transportsTypes) const
     noexcept
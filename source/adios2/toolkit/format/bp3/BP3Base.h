@@ -13,6 +13,7 @@
 
 /// \cond EXCLUDE_FROM_DOXYGEN
 #include <bitset>
+#include <memory> //std::shared_ptr
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -23,6 +24,8 @@
 #include "adios2/ADIOSMacros.h"
 #include "adios2/ADIOSTypes.h"
 #include "adios2/core/Variable.h"
+#include "adios2/helper/adiosThreadPool.h"
+#include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
 #include "adios2/toolkit/format/BufferSTL.h"
 #include "adios2/toolkit/profiling/iochrono/IOChrono.h"
 
@@ -51,6 +54,12 @@ public:
         uint64_t Count = 0;
         /** unique ID assigned to each variable for counter */
         const uint32_t MemberID;
+        /** Buffer position up to which offsets were updated to sub-file
+         * offsets, used with aggregation */
+        size_t LastUpdatedPosition = 0;
+        /** Buffer position up to which characteristics sets were aggregated
+         * into step metadata blocks */
+        size_t LastAggregatedPosition = 0;
 
         SerialElementIndex(const uint32_t memberID,
                            const size_t bufferSize = 200)
@@ -86,11 +95,13 @@ public:
 
         /** number of current PGs */
         uint64_t DataPGCount = 0;
-        /** current PG initial ( relative ) position in data buffer */
+        /** current PG initial ( relative ) position in data buffer, from
+         * m_Data.GetDataSize() */
         size_t DataPGLengthPosition = 0;
         /** number of variables in current PG */
         uint32_t DataPGVarsCount = 0;
-        /** current PG variable count ( relative ) position */
+        /** current PG variable count ( relative ) position, from
+         * m_Data.GetDataSize() */
         size_t DataPGVarsCountPosition = 0;
         /** true: currently writing to a pg, false: no current pg */
         bool DataPGIsOpen = false;
@@ -122,6 +133,13 @@ public:
     int m_SizeMPI = 1;   ///< current MPI processes size
     int m_Processes = 1; ///< number of aggregated MPI processes
 
+    /** Aggregators=M parameter, 0 (default): one file per rank */
+    size_t m_SubStreams = 0;
+
+    /** groups ranks into sub-files, initialized by engines writing
+     * m_SubStreams sub-files */
+    aggregator::MPIAggregator m_Aggregator;
+
     /** statistics verbosity, only 0 is supported */
     unsigned int m_Verbosity = 0;
 
@@ -154,7 +172,39 @@ public:
      * EndStep */
     size_t m_FlushStepsCount = 1;
 
-    /** from host language in data information at read */
+    /** true: data buffers are written to transports by a background thread
+     * while the next buffer is filled */
+    bool m_AsyncWrite = false;
+
+    /** true: array characteristics also carry the sum and sum of squares
+     * of the block values (statistic_sum, statistic_sum_square) */
+    bool m_StatsSum = false;
+
+    /** true: deferred payloads flushed at EndStep are written from user
+     * memory, only headers and characteristics are copied to m_Data */
+    bool m_ZeroCopy = false;
+
+    /** threads for payload copies at write and sub-file reads at read */
+    unsigned int m_Threads = 1;
+
+    /** persistent workers, set from IO before InitParameters or created
+     * there if Threads > 1, nullptr: serial */
+    std::shared_ptr<ThreadPool> m_ThreadPool;
+
+    /** reads of the same sub-file separated by up to this many bytes are
+     * merged into a single read */
+    size_t m_ReadGapSize = DefaultReadGapSize;
+
+    /** >= 2: collective metadata indices are merged in a tree with this
+     * fan-in, 0: all indices are gathered and merged in rank 0 */
+    unsigned int m_MetadataFanIn = 0;
+
+    /** > 0: engines that write m_Data in pieces set m_Data.m_ChunkSize, so
+     * it grows by chunks instead of reallocations */
+    size_t m_BufferChunkSize = 0;
+
+    /** from host language in data information at read, from the IO host
+     * language at write */
     bool m_IsRowMajor = true;
 
     /** if reader and writer have different ordering (column vs row major) */
@@ -196,6 +246,24 @@ public:
     std::string GetBPSubFileName(const std::string &name,
                                  const size_t subFileIndex) const noexcept;
 
+    /**
+     * Step metadata file, a collective metadata block is appended per flush:
+     * /path/name.bp.dir/name.bp.md
+     * @param name input
+     * @return step metadata file name
+     */
+    std::string GetBPStepMetadataFileName(const std::string &name) const
+        noexcept;
+
+    /**
+     * Step metadata index file, one record per block in the step metadata
+     * file: /path/name.bp.dir/name.bp.md.idx
+     * @param name input
+     * @return step metadata index file name
+     */
+    std::string GetBPStepMetadataIndexFileName(const std::string &name) const
+        noexcept;
+
     /**
      * Returns the estimated variable index size. Used by ResizeBuffer public
      * function
@@ -206,7 +274,24 @@ public:
                                   const Dims &variableCount) const noexcept;
 
     /**
-     * Sets buffer's positions to zero and fill buffer with zero char
+     * Overload that also accounts for the transform characteristic written
+     * for variables with a compression operator
+     * @param variable input
+     */
+    size_t GetVariableBPIndexSize(const VariableBase &variable) const noexcept;
+
+    /**
+     * Returns the first operator of a variable that transforms its payload
+     * (bzip2, zfp), other operators (e.g. callbacks) are not applied by BP3
+     * @param variable input
+     * @return pointer to operator info, nullptr if none
+     */
+    const VariableBase::OperatorInfo *
+    GetCompressionOperator(const VariableBase &variable) const noexcept;
+
+    /**
+     * Sets buffer's positions to zero and fill buffer with zero char, sealed
+     * chunks are released for reuse
      * @param bufferSTL buffer to be reset
      * @param resetAbsolutePosition true: both bufferSTL.m_Position and
      * bufferSTL.m_AbsolutePosition set to 0,   false(default): only
@@ -226,7 +311,8 @@ public:
     };
 
     /**
-     * Resizes the data buffer to hold new dataIn size
+     * Resizes the data buffer to hold new dataIn size, or starts a new
+     * chunk if m_Data is chunked
      * @param dataIn input size for new data
      * @param hint for exception handling
      * @return
@@ -238,8 +324,6 @@ public:
     ResizeResult ResizeBuffer(const size_t dataIn, const std::string hint);
 
 protected:
-    /** might be used in large payload copies to buffer */
-    unsigned int m_Threads = 1;
     const bool m_DebugMode = false;
 
     /** method type for file I/O */
@@ -377,6 +461,14 @@ protected:
         std::bitset<32> Bitmap;
         uint8_t BitFinite;
         bool IsValue = false;
+        /** reader only, true: Min and Max were found in characteristics */
+        bool HasBounds = false;
+        /** operator type of a transformed payload, empty if stored as is */
+        std::string TransformType;
+        /** operator parameters used to transform the payload */
+        Params TransformParameters;
+        /** payload size in bytes after the transform */
+        uint64_t TransformedSize = 0;
     };
 
     template <class T>
@@ -440,6 +532,33 @@ protected:
     /** set steps count to flush */
     void InitParameterFlushStepsCount(const std::string value);
 
+    /** ReadGapSize=64Kb (default), 0Kb only merges contiguous reads */
+    void InitParameterReadGapSize(const std::string value);
+
+    /** MetadataFanIn=0 (default, gather in rank 0), 2, 4, 8 ... */
+    void InitParameterMetadataFanIn(const std::string value);
+
+    /** BufferChunkSize=0Mb (default, contiguous), 16Mb */
+    void InitParameterBufferChunkSize(const std::string value);
+
+    /** AsyncWrite=On, Off (default) */
+    void InitParameterAsyncWrite(const std::string value);
+
+    /** ZeroCopy=On, Off (default) */
+    void InitParameterZeroCopy(const std::string value);
+
+    /** StatsSum=On, Off (default) */
+    void InitParameterStatsSum(const std::string value);
+
+    /** Aggregators=M or SubStreams=M, number of sub-files written */
+    void InitParameterSubStreams(const std::string value);
+
+    /**
+     * File index stored in characteristic_file_index
+     * @return sub-stream index if aggregating, rank otherwise
+     */
+    uint32_t GetFileIndex() const noexcept;
+
     /**
      * Returns data type index from enum Datatypes
      * @param variable input variable
@@ -510,6 +629,19 @@ private:
                               const DataTypes dataType,
                               const bool untilTimeStep,
                               Characteristics<T> &characteristics) const;
+
+    /**
+     * Reads a characteristic_transform_type record: operator type,
+     * pre-transform type and dimensions, operator parameters and the
+     * transformed payload size
+     * @param buffer metadata buffer
+     * @param position in buffer, updated past the record
+     * @param stats receives TransformType, TransformParameters and
+     * TransformedSize
+     */
+    template <class T>
+    void ParseTransformRecord(const std::vector<char> &buffer,
+                              size_t &position, Stats<T> &stats) const;
 };
 
 #define declare_template_instantiation(T)                                      \
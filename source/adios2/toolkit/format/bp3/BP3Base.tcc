@@ -367,6 +367,8 @@ BP3Base::ParseCharacteristics(const std::vector<char> &buffer, size_t &position,
         {
             characteristics.Statistics.Max =
                 ReadValue<typename TypeInfo<T>::ValueType>(buffer, position);
+            // written together with characteristic_min
+            characteristics.Statistics.HasBounds = true;
             break;
         }
 
@@ -494,7 +496,12 @@ BP3Base::ParseCharacteristics(const std::vector<char> &buffer, size_t &position,
             }     // for
             break;
         }
-        // TODO: implement compression and BP1 Stats characteristics
+        case (characteristic_transform_type):
+        {
+            ParseTransformRecord(buffer, position, characteristics.Statistics);
+            break;
+        }
+        // TODO: implement BP1 Stats characteristics
         default:
         {
             throw std::invalid_argument("ERROR: characteristic ID " +
@@ -513,6 +520,41 @@ BP3Base::ParseCharacteristics(const std::vector<char> &buffer, size_t &position,
     }
 }
 
+template <class T>
+inline void BP3Base::ParseTransformRecord(const std::vector<char> &buffer,
+                                          size_t &position,
+                                          Stats<T> &stats) const
+{
+    const size_t typeLength =
+        static_cast<size_t>(ReadValue<uint16_t>(buffer, position));
+    stats.TransformType = std::string(&buffer[position], typeLength);
+    position += typeLength;
+
+    position += 1; // skip pre-transform data type, same as the variable's
+
+    // skip pre-transform dimensions, same as the dimensions characteristic
+    position += 1;
+    const uint16_t dimensionsLength = ReadValue<uint16_t>(buffer, position);
+    position += dimensionsLength;
+
+    const uint8_t parametersCount = ReadValue<uint8_t>(buffer, position);
+    for (uint8_t p = 0; p < parametersCount; ++p)
+    {
+        const size_t keyLength =
+            static_cast<size_t>(ReadValue<uint16_t>(buffer, position));
+        const std::string key(&buffer[position], keyLength);
+        position += keyLength;
+
+        const size_t valueLength =
+            static_cast<size_t>(ReadValue<uint16_t>(buffer, position));
+        stats.TransformParameters[key] =
+            std::string(&buffer[position], valueLength);
+        position += valueLength;
+    }
+
+    stats.TransformedSize = ReadValue<uint64_t>(buffer, position);
+}
+
 } // end namespace format
 } // end namespace adios2
 
@@ -11,11 +11,21 @@
 #include "BP3Deserializer.h"
 #include "BP3Deserializer.tcc"
 
-#include <future>
+#include <algorithm> //std::sort, std::lexicographical_compare
+#include <numeric>   //std::iota
+#include <utility>   //std::pair
 #include <vector>
 
 #include "adios2/helper/adiosFunctions.h" //ReadValue<T>
 
+#ifdef ADIOS2_HAVE_BZIP2
+#include "adios2/operator/compress/CompressBZip2.h"
+#endif
+
+#ifdef ADIOS2_HAVE_ZFP
+#include "adios2/operator/compress/CompressZfp.h"
+#endif
+
 #ifdef _WIN32
 #pragma warning(disable : 4503) // Windows complains about SubFileInfoMap levels
 #endif
@@ -26,24 +36,138 @@ namespace format
 {
 
 std::mutex BP3Deserializer::m_Mutex;
+constexpr size_t BP3Deserializer::BlockIndexFanout;
 
 BP3Deserializer::BP3Deserializer(MPI_Comm mpiComm, const bool debugMode)
 : BP3Base(mpiComm, debugMode)
 {
 }
 
-void BP3Deserializer::ParseMetadata(const BufferSTL &bufferSTL, IO &io)
+void BP3Deserializer::ParseMetadata(const BufferSTL &bufferSTL, IO &io,
+                                    const size_t blockStart)
 {
-    ParseMinifooter(bufferSTL);
+    // a new metadata buffer invalidates all block positions, appended step
+    // blocks keep them and are detected by GetBlockIndex
+    if (blockStart == 0)
+    {
+        m_BlockIndices.clear();
+    }
+
+    ParseMinifooter(bufferSTL, blockStart);
     ParsePGIndex(bufferSTL, io);
     ParseVariablesIndex(bufferSTL, io);
     ParseAttributesIndex(bufferSTL, io);
 }
 
+std::map<size_t, std::vector<BP3Deserializer::ReadRequest>>
+BP3Deserializer::GetReadRequests(
+    const std::map<std::string, SubFileInfoMap> &variablesSubFileInfo) const
+{
+    using ReadBlock = std::pair<const std::string *, const SubFileInfo *>;
+
+    // gather blocks per sub-file
+    std::map<size_t, std::vector<ReadBlock>> subFilesBlocks;
+
+    for (const auto &variableNamePair : variablesSubFileInfo)
+    {
+        for (const auto &subFileIndexPair : variableNamePair.second)
+        {
+            auto &blocks = subFilesBlocks[subFileIndexPair.first];
+
+            for (const auto &stepPair : subFileIndexPair.second)
+            {
+                for (const auto &blockInfo : stepPair.second)
+                {
+                    blocks.emplace_back(&variableNamePair.first, &blockInfo);
+                }
+            }
+        }
+    }
+
+    std::map<size_t, std::vector<ReadRequest>> subFilesRequests;
+
+    for (auto &subFileBlocksPair : subFilesBlocks)
+    {
+        auto &blocks = subFileBlocksPair.second;
+
+        std::sort(blocks.begin(), blocks.end(),
+                  [](const ReadBlock &block1, const ReadBlock &block2) {
+                      return block1.second->Seeks.first <
+                             block2.second->Seeks.first;
+                  });
+
+        auto &requests = subFilesRequests[subFileBlocksPair.first];
+
+        for (const auto &block : blocks)
+        {
+            const Box<size_t> &seeks = block.second->Seeks;
+
+            if (requests.empty() ||
+                seeks.first > requests.back().Seeks.second + m_ReadGapSize)
+            {
+                ReadRequest request;
+                request.Seeks = seeks;
+                requests.push_back(std::move(request));
+            }
+            else
+            {
+                // overlapping or close enough, read the gap
+                requests.back().Seeks.second =
+                    std::max(requests.back().Seeks.second, seeks.second);
+            }
+
+            requests.back().Blocks.push_back(block);
+
+            auto &runs = requests.back().Runs;
+            if (block.second->Runs.empty())
+            {
+                runs.push_back(seeks);
+            }
+            else
+            {
+                runs.insert(runs.end(), block.second->Runs.begin(),
+                            block.second->Runs.end());
+            }
+        }
+
+        for (auto &request : requests)
+        {
+            auto &runs = request.Runs;
+            std::sort(runs.begin(), runs.end());
+
+            // merge overlapping runs or runs closer than m_ReadGapSize
+            size_t last = 0;
+            for (size_t r = 1; r < runs.size(); ++r)
+            {
+                if (runs[r].first <= runs[last].second + m_ReadGapSize)
+                {
+                    runs[last].second =
+                        std::max(runs[last].second, runs[r].second);
+                }
+                else
+                {
+                    runs[++last] = runs[r];
+                }
+            }
+            runs.resize(last + 1);
+        }
+    }
+
+    return subFilesRequests;
+}
+
 void BP3Deserializer::ClipContiguousMemory(
     const std::string &variableName, IO &io,
     const std::vector<char> &contiguousMemory, const Box<Dims> &blockBox,
     const Box<Dims> &intersectionBox) const
+{
+    ClipContiguousMemory(variableName, io, contiguousMemory.data(), blockBox,
+                         intersectionBox);
+}
+
+void BP3Deserializer::ClipContiguousMemory(
+    const std::string &variableName, IO &io, const char *contiguousMemory,
+    const Box<Dims> &blockBox, const Box<Dims> &intersectionBox) const
 {
     // get variable pointer and set data in it with local dimensions
     const std::string type(io.InquireVariableType(variableName));
@@ -65,6 +189,75 @@ void BP3Deserializer::ClipContiguousMemory(
 #undef declare_type
 }
 
+void BP3Deserializer::InverseTransform(const std::string &variableName,
+                                       IO &io, const SubFileInfo &blockInfo,
+                                       const char *transformedMemory,
+                                       std::vector<char> &preTransformMemory)
+{
+    const std::string &transformType = blockInfo.TransformType;
+    std::shared_ptr<Operator> operatorPtr;
+
+    {
+        // operators are shared by reading threads
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto itOperator = m_Operators.find(transformType);
+        if (itOperator != m_Operators.end())
+        {
+            operatorPtr = itOperator->second;
+        }
+        else
+        {
+            if (transformType == "bzip2")
+            {
+#ifdef ADIOS2_HAVE_BZIP2
+                operatorPtr = std::make_shared<adios2::compress::CompressBZip2>(
+                    Params(), m_DebugMode);
+#endif
+            }
+            else if (transformType == "zfp")
+            {
+#ifdef ADIOS2_HAVE_ZFP
+                operatorPtr = std::make_shared<adios2::compress::CompressZfp>(
+                    Params(), m_DebugMode);
+#endif
+            }
+
+            if (!operatorPtr)
+            {
+                throw std::invalid_argument(
+                    "ERROR: variable " + variableName + " was written with " +
+                    transformType +
+                    " operator, not available in this version of ADIOS2, in "
+                    "call to PerformGets or Get\n");
+            }
+
+            m_Operators.emplace(transformType, operatorPtr);
+        }
+    }
+
+    const size_t transformedSize =
+        blockInfo.Seeks.second - blockInfo.Seeks.first;
+    preTransformMemory.resize(blockInfo.PreTransformSize);
+
+    if (transformType == "zfp")
+    {
+        const Dims blockCount =
+            StartCountBox(blockInfo.BlockBox.first, blockInfo.BlockBox.second)
+                .second;
+        operatorPtr->Decompress(transformedMemory, transformedSize,
+                                preTransformMemory.data(), blockCount,
+                                io.InquireVariableType(variableName),
+                                blockInfo.TransformParameters);
+    }
+    else
+    {
+        operatorPtr->Decompress(transformedMemory, transformedSize,
+                                preTransformMemory.data(),
+                                preTransformMemory.size());
+    }
+}
+
 void BP3Deserializer::GetStringFromMetadata(
     Variable<std::string> &variable) const
 {
@@ -96,7 +289,8 @@ void BP3Deserializer::GetStringFromMetadata(
 }
 
 // PRIVATE
-void BP3Deserializer::ParseMinifooter(const BufferSTL &bufferSTL)
+void BP3Deserializer::ParseMinifooter(const BufferSTL &bufferSTL,
+                                      const size_t blockStart)
 {
     auto lf_GetEndianness = [](const uint8_t endianness, bool &isLittleEndian) {
 
@@ -138,9 +332,12 @@ void BP3Deserializer::ParseMinifooter(const BufferSTL &bufferSTL)
     m_Minifooter.VersionTag.assign(&buffer[position], 28);
     position += 28;
 
-    m_Minifooter.PGIndexStart = ReadValue<uint64_t>(buffer, position);
-    m_Minifooter.VarsIndexStart = ReadValue<uint64_t>(buffer, position);
-    m_Minifooter.AttributesIndexStart = ReadValue<uint64_t>(buffer, position);
+    m_Minifooter.PGIndexStart =
+        blockStart + ReadValue<uint64_t>(buffer, position);
+    m_Minifooter.VarsIndexStart =
+        blockStart + ReadValue<uint64_t>(buffer, position);
+    m_Minifooter.AttributesIndexStart =
+        blockStart + ReadValue<uint64_t>(buffer, position);
 }
 
 void BP3Deserializer::ParsePGIndex(const BufferSTL &bufferSTL, const IO &io)
@@ -307,45 +504,26 @@ void BP3Deserializer::ParseVariablesIndex(const BufferSTL &bufferSTL, IO &io)
         return;
     }
 
-    // threads for reading Variables
-    std::vector<std::future<void>> asyncs(m_Threads);
-    std::vector<size_t> asyncPositions(m_Threads);
-
-    bool launched = false;
+    // element index positions, each one parsed in a pool task
+    std::vector<size_t> positions;
 
     while (localPosition < length)
     {
-        // extract async positions
-        for (unsigned int t = 0; t < m_Threads; ++t)
-        {
-            asyncPositions[t] = position;
-            const size_t elementIndexSize =
-                static_cast<size_t>(ReadValue<uint32_t>(buffer, position));
-            position += elementIndexSize;
-            localPosition = position - startPosition;
-
-            if (launched)
-            {
-                asyncs[t].get();
-            }
+        positions.push_back(position);
+        const size_t elementIndexSize =
+            static_cast<size_t>(ReadValue<uint32_t>(buffer, position));
+        position += elementIndexSize;
+        localPosition = position - startPosition;
+    }
 
-            if (localPosition <= length)
+    m_ThreadPool->ParallelFor(
+        positions.size(), 1, m_Threads,
+        [&](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; ++i)
             {
-                asyncs[t] = std::async(std::launch::async, lf_ReadElementIndex,
-                                       std::ref(io), std::ref(buffer),
-                                       asyncPositions[t]);
+                lf_ReadElementIndex(io, buffer, positions[i]);
             }
-        }
-        launched = true;
-    }
-
-    for (auto &async : asyncs)
-    {
-        if (async.valid())
-        {
-            async.wait();
-        }
-    }
+        });
 }
 
 void BP3Deserializer::ParseAttributesIndex(const BufferSTL &bufferSTL, IO &io)
@@ -460,6 +638,269 @@ void BP3Deserializer::ParseAttributesIndex(const BufferSTL &bufferSTL, IO &io)
     }
 }
 
+void BP3Deserializer::SetReadRuns(SubFileInfo &blockInfo,
+                                  const size_t elementSize) const
+{
+    blockInfo.Runs.clear();
+
+    const Dims &blockStart = blockInfo.BlockBox.first;
+    const Dims &blockEnd = blockInfo.BlockBox.second;
+    const Dims &start = blockInfo.IntersectionBox.first;
+    const Dims &end = blockInfo.IntersectionBox.second;
+    const size_t dimensions = start.size();
+
+    // d-th fastest changing dimension
+    auto lf_Dimension = [&](const size_t d) -> size_t {
+        return m_IsRowMajor ? dimensions - 1 - d : d;
+    };
+
+    // a run spans the fastest dimensions up to the first one that is not
+    // fully covered by the intersection
+    size_t runDimensions = 0;
+    size_t runElements = 1;
+    while (runDimensions < dimensions)
+    {
+        const size_t dim = lf_Dimension(runDimensions);
+        runElements *= end[dim] - start[dim] + 1;
+        ++runDimensions;
+
+        if (start[dim] != blockStart[dim] || end[dim] != blockEnd[dim])
+        {
+            break;
+        }
+    }
+
+    if (runDimensions >= dimensions)
+    {
+        return; // a single run, same as Seeks
+    }
+
+    Dims strides(dimensions);
+    size_t stride = 1;
+    size_t linearIndex = 0;
+    for (size_t d = 0; d < dimensions; ++d)
+    {
+        const size_t dim = lf_Dimension(d);
+        strides[dim] = stride;
+        linearIndex += (start[dim] - blockStart[dim]) * stride;
+        stride *= blockEnd[dim] - blockStart[dim] + 1;
+    }
+
+    const size_t payloadOffset =
+        blockInfo.Seeks.first - linearIndex * elementSize;
+    const size_t runSize = runElements * elementSize;
+
+    auto &runs = blockInfo.Runs;
+    Dims point(start);
+
+    while (true)
+    {
+        const size_t runStart = payloadOffset + linearIndex * elementSize;
+
+        if (!runs.empty() && runStart <= runs.back().second + m_ReadGapSize)
+        {
+            runs.back().second = runStart + runSize;
+        }
+        else
+        {
+            runs.push_back(Box<size_t>(runStart, runStart + runSize));
+        }
+
+        // next run start, only the dimensions outside a run are iterated
+        size_t d = runDimensions;
+        for (; d < dimensions; ++d)
+        {
+            const size_t dim = lf_Dimension(d);
+            if (point[dim] < end[dim])
+            {
+                ++point[dim];
+                linearIndex += strides[dim];
+                break;
+            }
+
+            linearIndex -= (point[dim] - start[dim]) * strides[dim];
+            point[dim] = start[dim];
+        }
+
+        if (d == dimensions)
+        {
+            break;
+        }
+    }
+
+    if (runs.size() == 1)
+    {
+        runs.clear(); // gaps are all merged, same as Seeks
+    }
+}
+
+void BP3Deserializer::BuildBlockTree(BlockIndex &blockIndex) const
+{
+    const size_t blocks = blockIndex.PayloadOffsets.size();
+    const size_t dimensions = blockIndex.Dimensions;
+
+    if (dimensions == 0 || blocks <= BlockIndexFanout)
+    {
+        return; // linear search over the arrays is faster
+    }
+
+    // spatially close blocks (same start prefix) end up in the same leaves
+    const size_t *starts = blockIndex.Starts.data();
+    blockIndex.Leaves.resize(blocks);
+    std::iota(blockIndex.Leaves.begin(), blockIndex.Leaves.end(), 0);
+    std::sort(blockIndex.Leaves.begin(), blockIndex.Leaves.end(),
+              [&](const size_t a, const size_t b) {
+                  return std::lexicographical_compare(
+                      starts + a * dimensions, starts + (a + 1) * dimensions,
+                      starts + b * dimensions, starts + (b + 1) * dimensions);
+              });
+
+    size_t children = blocks;
+    while (children > 1)
+    {
+        const bool isLeafLevel = blockIndex.NodeStarts.empty();
+        const size_t nodes =
+            (children + BlockIndexFanout - 1) / BlockIndexFanout;
+
+        std::vector<size_t> nodeStarts(nodes * dimensions);
+        std::vector<size_t> nodeEnds(nodes * dimensions);
+
+        for (size_t n = 0; n < nodes; ++n)
+        {
+            size_t *nodeStart = &nodeStarts[n * dimensions];
+            size_t *nodeEnd = &nodeEnds[n * dimensions];
+
+            const size_t first = n * BlockIndexFanout;
+            const size_t last = std::min(first + BlockIndexFanout, children);
+
+            for (size_t c = first; c < last; ++c)
+            {
+                const size_t *childStart = nullptr;
+                const size_t *childEnd = nullptr;
+                if (isLeafLevel)
+                {
+                    const size_t b = blockIndex.Leaves[c];
+                    childStart = &blockIndex.Starts[b * dimensions];
+                    childEnd = &blockIndex.Ends[b * dimensions];
+                }
+                else
+                {
+                    childStart = &blockIndex.NodeStarts.back()[c * dimensions];
+                    childEnd = &blockIndex.NodeEnds.back()[c * dimensions];
+                }
+
+                for (size_t d = 0; d < dimensions; ++d)
+                {
+                    if (c == first || childStart[d] < nodeStart[d])
+                    {
+                        nodeStart[d] = childStart[d];
+                    }
+                    if (c == first || childEnd[d] > nodeEnd[d])
+                    {
+                        nodeEnd[d] = childEnd[d];
+                    }
+                }
+            }
+        }
+
+        blockIndex.NodeStarts.push_back(std::move(nodeStarts));
+        blockIndex.NodeEnds.push_back(std::move(nodeEnds));
+        children = nodes;
+    }
+}
+
+void BP3Deserializer::QueryBlockIndex(const BlockIndex &blockIndex,
+                                      const Box<Dims> &selectionBox,
+                                      std::vector<size_t> &blockIDs) const
+{
+    blockIDs.clear();
+
+    const size_t blocks = blockIndex.PayloadOffsets.size();
+    const size_t dimensions = blockIndex.Dimensions;
+
+    // boxes can't be compared here, IntersectionBox decides for each block
+    if (!blockIndex.Uniform || dimensions == 0 ||
+        selectionBox.first.size() != dimensions)
+    {
+        blockIDs.resize(blocks);
+        std::iota(blockIDs.begin(), blockIDs.end(), 0);
+        return;
+    }
+
+    const Dims &selectionStart = selectionBox.first;
+    const Dims &selectionEnd = selectionBox.second;
+
+    auto lf_Intersects = [&](const size_t *start, const size_t *end) -> bool {
+        for (size_t d = 0; d < dimensions; ++d)
+        {
+            if (start[d] > selectionEnd[d] || end[d] < selectionStart[d])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (blockIndex.NodeStarts.empty())
+    {
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            if (lf_Intersects(&blockIndex.Starts[b * dimensions],
+                              &blockIndex.Ends[b * dimensions]))
+            {
+                blockIDs.push_back(b);
+            }
+        }
+        return;
+    }
+
+    // depth-first search from the root, first: level, second: node
+    std::vector<std::pair<size_t, size_t>> nodes;
+    nodes.emplace_back(blockIndex.NodeStarts.size() - 1, 0);
+
+    while (!nodes.empty())
+    {
+        const size_t level = nodes.back().first;
+        const size_t node = nodes.back().second;
+        nodes.pop_back();
+
+        if (!lf_Intersects(&blockIndex.NodeStarts[level][node * dimensions],
+                           &blockIndex.NodeEnds[level][node * dimensions]))
+        {
+            continue;
+        }
+
+        const size_t first = node * BlockIndexFanout;
+
+        if (level == 0)
+        {
+            const size_t last = std::min(first + BlockIndexFanout, blocks);
+            for (size_t c = first; c < last; ++c)
+            {
+                const size_t b = blockIndex.Leaves[c];
+                if (lf_Intersects(&blockIndex.Starts[b * dimensions],
+                                  &blockIndex.Ends[b * dimensions]))
+                {
+                    blockIDs.push_back(b);
+                }
+            }
+        }
+        else
+        {
+            const size_t children =
+                blockIndex.NodeStarts[level - 1].size() / dimensions;
+            const size_t last = std::min(first + BlockIndexFanout, children);
+            for (size_t c = first; c < last; ++c)
+            {
+                nodes.emplace_back(level - 1, c);
+            }
+        }
+    }
+
+    // results in metadata order, as a linear search
+    std::sort(blockIDs.begin(), blockIDs.end());
+}
+
 std::map<std::string, SubFileInfoMap>
 BP3Deserializer::PerformGetsVariablesSubFileInfo(IO &io)
 {
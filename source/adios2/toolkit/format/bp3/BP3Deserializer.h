@@ -31,6 +31,19 @@ public:
     /** BP Minifooter fields */
     Minifooter m_Minifooter;
 
+    /** A single read from a sub-file covering one or more blocks */
+    struct ReadRequest
+    {
+        /** first = Start seek, second = End seek in the sub-file */
+        Box<size_t> Seeks;
+        /** sorted seeks inside Seeks that are actually read, bytes between
+         * them are left unset in the read memory */
+        std::vector<Box<size_t>> Runs;
+        /** variable name and info of each block inside Seeks */
+        std::vector<std::pair<const std::string *, const SubFileInfo *>>
+            Blocks;
+    };
+
     bool m_PerformedGets = true;
 
     /**
@@ -42,7 +55,17 @@ public:
 
     ~BP3Deserializer() = default;
 
-    void ParseMetadata(const BufferSTL &bufferSTL, IO &io);
+    /**
+     * Parses metadata and defines its variables and attributes in io. Also
+     * used for step metadata blocks appended to the same buffer, in which
+     * case variables already in io get the new steps added.
+     * @param bufferSTL metadata buffer, must end with a minifooter
+     * @param io
+     * @param blockStart position of the last metadata block in bufferSTL,
+     * index starts in its minifooter are relative to it
+     */
+    void ParseMetadata(const BufferSTL &bufferSTL, IO &io,
+                       const size_t blockStart = 0);
 
     // Sync functions
     template <class T>
@@ -69,26 +92,127 @@ public:
     std::map<std::string, SubFileInfoMap>
     PerformGetsVariablesSubFileInfo(IO &io);
 
+    /**
+     * Plans the reads of PerformGetsVariablesSubFileInfo: blocks are sorted
+     * by offset in each sub-file and blocks closer than m_ReadGapSize are
+     * merged into a single request. Inside a request only the Runs of
+     * its blocks are read, runs closer than m_ReadGapSize are merged.
+     * @param variablesSubFileInfo must outlive the returned requests
+     * @return key: sub-file index, value: reads in offset order
+     */
+    std::map<size_t, std::vector<ReadRequest>> GetReadRequests(
+        const std::map<std::string, SubFileInfoMap> &variablesSubFileInfo)
+        const;
+
     void ClipContiguousMemory(const std::string &variableName, IO &io,
                               const std::vector<char> &contiguousMemory,
                               const Box<Dims> &blockBox,
                               const Box<Dims> &intersectionBox) const;
 
+    /**
+     * Overloaded version for memory inside a larger read, thread-safe for
+     * blocks with different intersections
+     * @param contiguousMemory start of the intersection bytes
+     */
+    void ClipContiguousMemory(const std::string &variableName, IO &io,
+                              const char *contiguousMemory,
+                              const Box<Dims> &blockBox,
+                              const Box<Dims> &intersectionBox) const;
+
+    /**
+     * Thread-safe. Inverts the transform (Operator) of a block read from
+     * blockInfo.Seeks, the intersection is then at
+     * blockInfo.PreTransformSeeks in preTransformMemory
+     * @param variableName
+     * @param io
+     * @param blockInfo transformed block, TransformType is not empty
+     * @param transformedMemory stored block
+     * @param preTransformMemory output, resized to the untransformed block
+     */
+    void InverseTransform(const std::string &variableName, IO &io,
+                          const SubFileInfo &blockInfo,
+                          const char *transformedMemory,
+                          std::vector<char> &preTransformMemory);
+
     void GetStringFromMetadata(Variable<std::string> &variable) const;
 
 private:
+    /**
+     * Parsed characteristics of the blocks of a variable in one step, kept
+     * as arrays in metadata order, plus a packed R-tree over the block boxes.
+     * Built once by GetBlockIndex so selections never re-decode metadata.
+     */
+    struct BlockIndex
+    {
+        /** transformed blocks only, from characteristics */
+        struct Transform
+        {
+            std::string Type;
+            Params Parameters;
+            uint64_t Size;
+        };
+
+        /** block positions in metadata when built, a different list means
+         * blocks were appended or metadata was replaced */
+        std::vector<size_t> BlockStarts;
+
+        /** false: blocks have different dimensions, stored in Boxes */
+        bool Uniform = true;
+        size_t Dimensions = 0;
+
+        /** Uniform only, Dimensions per block, ends are inclusive */
+        std::vector<size_t> Starts;
+        std::vector<size_t> Ends;
+
+        /** not Uniform only, block boxes */
+        std::vector<Box<Dims>> Boxes;
+
+        std::vector<uint64_t> PayloadOffsets;
+        std::vector<uint32_t> FileIndices;
+
+        /** 0: not transformed, otherwise index + 1 in Transforms */
+        std::vector<uint32_t> TransformIDs;
+        std::vector<Transform> Transforms;
+
+        /** min and max value of each block for SetValueSelection, empty if
+         * a block has no min/max characteristics */
+        std::vector<char> Bounds;
+
+        /** block ids sorted by start, in groups of BlockIndexFanout */
+        std::vector<size_t> Leaves;
+
+        /** bounding boxes per tree level, level 0 bounds groups of Leaves,
+         * level l + 1 bounds groups of level l nodes. Empty: linear search */
+        std::vector<std::vector<size_t>> NodeStarts;
+        std::vector<std::vector<size_t>> NodeEnds;
+    };
+
+    /** children per R-tree node, also the minimum blocks to build a tree */
+    static constexpr size_t BlockIndexFanout = 16;
+
+    /**
+     * key: variable name, value: key: step, value: block index. Cleared when
+     * a whole metadata buffer is parsed. Not synchronized: only used from
+     * the thread calling Get/PerformGets, reading threads never access it.
+     */
+    mutable std::map<std::string, std::map<size_t, BlockIndex>> m_BlockIndices;
+
     std::map<std::string, SubFileInfoMap> m_DeferredVariables;
 
+    /** operators created by InverseTransform, key: operator type */
+    std::map<std::string, std::shared_ptr<Operator>> m_Operators;
+
     static std::mutex m_Mutex;
 
-    void ParseMinifooter(const BufferSTL &bufferSTL);
+    void ParseMinifooter(const BufferSTL &bufferSTL, const size_t blockStart);
     void ParsePGIndex(const BufferSTL &bufferSTL, const IO &io);
     void ParseVariablesIndex(const BufferSTL &bufferSTL, IO &io);
     void ParseAttributesIndex(const BufferSTL &bufferSTL, IO &io);
 
     /**
      * Reads a variable index element (serialized) and calls IO.DefineVariable
-     * to deserialize the Variable metadata
+     * to deserialize the Variable metadata, if the variable already exists
+     * only its steps and min/max are updated
      * @param header serialize
      * @param io
      * @param buffer
@@ -107,35 +231,72 @@ private:
     template <class T>
     SubFileInfoMap GetSubFileInfo(const Variable<T> &variable) const;
 
+    /**
+     * Returns the cached block index of a variable step, parses the step
+     * block characteristics only the first time or if its block positions
+     * in metadata changed
+     * @param variable
+     * @param step as stored in bp file (starts at 1)
+     * @param blockStarts metadata positions of the step blocks
+     * @return block index, valid until the next call for the same variable
+     */
     template <class T>
-    void ClipContiguousMemoryCommon(Variable<T> &variable,
-                                    const std::vector<char> &contiguousMemory,
-                                    const Box<Dims> &blockBox,
-                                    const Box<Dims> &intersectionBox) const;
+    const BlockIndex &
+    GetBlockIndex(const Variable<T> &variable, const size_t step,
+                  const std::vector<size_t> &blockStarts) const;
 
     /**
-     * Row-major, zero-indexed data e.g. : C, C++
-     * @param variable
-     * @param contiguousMemory
-     * @param blockBox
-     * @param intersectionBox
+     * Appends block min and max to blockIndex.Bounds
+     * @param blockIndex
+     * @param statistics block characteristics statistics
+     * @return false: block doesn't have min and max, Bounds is cleared
      */
     template <class T>
-    void ClipContiguousMemoryCommonRow(
-        Variable<T> &variable, const std::vector<char> &contiguousMemory,
-        const Box<Dims> &blockBox, const Box<Dims> &intersectionBox) const;
+    bool InsertBlockBounds(BlockIndex &blockIndex,
+                           const Stats<T> &statistics) const;
 
     /**
-     * Column-major, one indexed data e.g. : Fortran, R
+     * Checks a block against variable SetValueSelection
+     * @return false: block values are all outside the value selection
+     */
+    template <class T>
+    bool IsBlockInValueSelection(const Variable<T> &variable,
+                                 const BlockIndex &blockIndex,
+                                 const size_t blockID) const;
+
+    /**
+     * Sets blockInfo.Runs to the seeks of the contiguous pieces of its
+     * intersection, pieces closer than m_ReadGapSize are merged
+     * @param blockInfo untransformed block with Seeks set
+     * @param elementSize bytes per element
+     */
+    void SetReadRuns(SubFileInfo &blockInfo, const size_t elementSize) const;
+
+    /** Bulk loads the packed R-tree of a filled Uniform blockIndex */
+    void BuildBlockTree(BlockIndex &blockIndex) const;
+
+    /**
+     * Finds the blocks that may intersect selectionBox
+     * @param blockIndex
+     * @param selectionBox start and inclusive end
+     * @param blockIDs output, in metadata order
+     */
+    void QueryBlockIndex(const BlockIndex &blockIndex,
+                         const Box<Dims> &selectionBox,
+                         std::vector<size_t> &blockIDs) const;
+
+    /**
+     * Copies the intersection of a block into the variable selection
      * @param variable
-     * @param contiguousMemory
+     * @param contiguousMemory first intersection element in the block
      * @param blockBox
      * @param intersectionBox
      */
     template <class T>
-    void ClipContiguousMemoryCommonColumn(
-        Variable<T> &variable, const std::vector<char> &contiguousMemory,
-        const Box<Dims> &blockBox, const Box<Dims> &intersectionBox) const;
+    void ClipContiguousMemoryCommon(Variable<T> &variable,
+                                    const char *contiguousMemory,
+                                    const Box<Dims> &blockBox,
+                                    const Box<Dims> &intersectionBox) const;
 };
 
 #define declare_template_instantiation(T)                                      \
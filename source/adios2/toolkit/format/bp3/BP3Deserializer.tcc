@@ -87,25 +87,36 @@ inline void BP3Deserializer::DefineVariableInIO<std::string>(
     }
 
     Variable<std::string> *variable = nullptr;
-    if (characteristics.Statistics.IsValue)
+    {
+        // defined by a previous step metadata block
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        variable = io.InquireVariable<std::string>(variableName);
+    }
+    const bool isNew = (variable == nullptr);
+
+    if (isNew && characteristics.Statistics.IsValue)
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
         variable = &io.DefineVariable<std::string>(variableName);
         variable->m_Value =
             characteristics.Statistics.Value; // assigning first step
     }
-    else
+    else if (isNew)
     {
         // TODO: throw exception?
     }
 
     // going back to get variable index position
-    variable->m_IndexStart =
+    const size_t indexStart =
         initialPosition - (header.Name.size() + header.GroupName.size() +
                            header.Path.size() + 23);
+    if (isNew)
+    {
+        variable->m_IndexStart = indexStart;
+    }
 
     const size_t endPosition =
-        variable->m_IndexStart + static_cast<size_t>(header.Length) + 4;
+        indexStart + static_cast<size_t>(header.Length) + 4;
 
     position = initialPosition;
 
@@ -150,7 +161,14 @@ BP3Deserializer::DefineVariableInIO(const ElementIndexHeader &header, IO &io,
     }
 
     Variable<T> *variable = nullptr;
-    if (characteristics.Statistics.IsValue)
+    {
+        // defined by a previous step metadata block
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        variable = io.InquireVariable<T>(variableName);
+    }
+    const bool isNew = (variable == nullptr);
+
+    if (isNew && characteristics.Statistics.IsValue)
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
         variable = &io.DefineVariable<T>(variableName);
@@ -158,7 +176,7 @@ BP3Deserializer::DefineVariableInIO(const ElementIndexHeader &header, IO &io,
         variable->m_Min = characteristics.Statistics.Value;
         variable->m_Max = characteristics.Statistics.Value;
     }
-    else
+    else if (isNew)
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
 
@@ -177,12 +195,16 @@ BP3Deserializer::DefineVariableInIO(const ElementIndexHeader &header, IO &io,
     }
 
     // going back to get variable index position
-    variable->m_IndexStart =
+    const size_t indexStart =
         initialPosition - (header.Name.size() + header.GroupName.size() +
                            header.Path.size() + 23);
+    if (isNew)
+    {
+        variable->m_IndexStart = indexStart;
+    }
 
     const size_t endPosition =
-        variable->m_IndexStart + static_cast<size_t>(header.Length) + 4;
+        indexStart + static_cast<size_t>(header.Length) + 4;
 
     position = initialPosition;
 
@@ -238,6 +260,12 @@ void BP3Deserializer::DefineAttributeInIO(const ElementIndexHeader &header,
         attributeName = header.Path + PathSeparator + header.Name;
     }
 
+    // defined by a previous step metadata block
+    if (io.InquireAttribute<T>(attributeName) != nullptr)
+    {
+        return;
+    }
+
     if (characteristics.Statistics.IsValue)
     {
         io.DefineAttribute<T>(attributeName, characteristics.Statistics.Value);
@@ -250,20 +278,77 @@ void BP3Deserializer::DefineAttributeInIO(const ElementIndexHeader &header,
     }
 }
 
+template <>
+inline bool BP3Deserializer::InsertBlockBounds(
+    BlockIndex & /*blockIndex*/,
+    const Stats<std::string> & /*statistics*/) const
+{
+    return false; // strings are not filtered by value
+}
+
+template <class T>
+bool BP3Deserializer::InsertBlockBounds(BlockIndex &blockIndex,
+                                        const Stats<T> &statistics) const
+{
+    if (!statistics.HasBounds)
+    {
+        blockIndex.Bounds.clear();
+        return false;
+    }
+
+    // complex characteristics store the modulus as the real part, which is
+    // the first ValueType of std::complex
+    using ValueType = typename TypeInfo<T>::ValueType;
+    InsertToBuffer(blockIndex.Bounds,
+                   reinterpret_cast<const ValueType *>(&statistics.Min));
+    InsertToBuffer(blockIndex.Bounds,
+                   reinterpret_cast<const ValueType *>(&statistics.Max));
+    return true;
+}
+
+template <>
+inline bool BP3Deserializer::IsBlockInValueSelection(
+    const Variable<std::string> & /*variable*/,
+    const BlockIndex & /*blockIndex*/, const size_t /*blockID*/) const
+{
+    return true;
+}
+
+template <class T>
+bool BP3Deserializer::IsBlockInValueSelection(const Variable<T> &variable,
+                                              const BlockIndex &blockIndex,
+                                              const size_t blockID) const
+{
+    if (!variable.m_HasValueSelection || blockIndex.Bounds.empty())
+    {
+        return true;
+    }
+
+    using ValueType = typename TypeInfo<T>::ValueType;
+
+    ValueType min, max;
+    size_t position = 2 * sizeof(ValueType) * blockID;
+    CopyFromBuffer(blockIndex.Bounds, position, &min);
+    CopyFromBuffer(blockIndex.Bounds, position, &max);
+
+    return !(max < variable.m_ValueSelectionMin ||
+             variable.m_ValueSelectionMax < min);
+}
+
 template <class T>
 SubFileInfoMap
 BP3Deserializer::GetSubFileInfo(const Variable<T> &variable) const
 {
     SubFileInfoMap infoMap;
 
-    const auto &buffer = m_Metadata.m_Buffer;
-
     const size_t stepStart = variable.m_StepsStart + 1;
     const size_t stepEnd = stepStart + variable.m_StepsCount; // exclusive
 
     const Box<Dims> selectionBox =
         StartEndBox(variable.m_Start, variable.m_Count, m_ReverseDimensions);
 
+    std::vector<size_t> blockIDs;
+
     for (size_t step = stepStart; step < stepEnd; ++step)
     {
         auto itBlockStarts = variable.m_IndexStepBlockStarts.find(step);
@@ -272,20 +357,32 @@ BP3Deserializer::GetSubFileInfo(const Variable<T> &variable) const
             continue;
         }
 
-        const std::vector<size_t> &blockStarts = itBlockStarts->second;
+        const BlockIndex &blockIndex =
+            GetBlockIndex(variable, step, itBlockStarts->second);
+
+        QueryBlockIndex(blockIndex, selectionBox, blockIDs);
 
-        // blockPosition gets updated by Read, can't be const
-        for (size_t blockPosition : blockStarts)
+        for (const size_t b : blockIDs)
         {
-            const Characteristics<T> blockCharacteristics =
-                ReadElementIndexCharacteristics<T>(
-                    buffer, blockPosition,
-                    static_cast<DataTypes>(GetDataType<T>()));
+            if (!IsBlockInValueSelection(variable, blockIndex, b))
+            {
+                continue;
+            }
 
             // check if they intersect
             SubFileInfo info;
-            info.BlockBox = StartEndBox(blockCharacteristics.Start,
-                                        blockCharacteristics.Count);
+            if (blockIndex.Uniform)
+            {
+                const size_t dimensions = blockIndex.Dimensions;
+                const auto itStart = blockIndex.Starts.begin() + b * dimensions;
+                const auto itEnd = blockIndex.Ends.begin() + b * dimensions;
+                info.BlockBox.first.assign(itStart, itStart + dimensions);
+                info.BlockBox.second.assign(itEnd, itEnd + dimensions);
+            }
+            else
+            {
+                info.BlockBox = blockIndex.Boxes[b];
+            }
             info.IntersectionBox = IntersectionBox(selectionBox, info.BlockBox);
 
             if (info.IntersectionBox.first.empty() ||
@@ -293,23 +390,54 @@ BP3Deserializer::GetSubFileInfo(const Variable<T> &variable) const
             {
                 continue;
             }
+
+            const size_t payloadOffset =
+                static_cast<size_t>(blockIndex.PayloadOffsets[b]);
+
             // if they intersect get info Seeks (first: start, second:
             // count)
             info.Seeks.first =
-                blockCharacteristics.Statistics.PayloadOffset +
+                payloadOffset +
                 LinearIndex(info.BlockBox, info.IntersectionBox.first,
                             m_IsRowMajor) *
                     sizeof(T);
 
             info.Seeks.second =
-                blockCharacteristics.Statistics.PayloadOffset +
+                payloadOffset +
                 (LinearIndex(info.BlockBox, info.IntersectionBox.second,
                              m_IsRowMajor) +
                  1) *
                     sizeof(T);
 
+            const uint32_t transformID = blockIndex.TransformIDs[b];
+            if (transformID != 0)
+            {
+                // the whole block is read and untransformed before clipping
+                const BlockIndex::Transform &transform =
+                    blockIndex.Transforms[transformID - 1];
+
+                info.TransformType = transform.Type;
+                info.TransformParameters = transform.Parameters;
+                info.PreTransformSeeks.first = info.Seeks.first - payloadOffset;
+                info.PreTransformSeeks.second =
+                    info.Seeks.second - payloadOffset;
+                info.PreTransformSize =
+                    GetTotalSize(StartCountBox(info.BlockBox.first,
+                                               info.BlockBox.second)
+                                     .second) *
+                    sizeof(T);
+
+                info.Seeks.first = payloadOffset;
+                info.Seeks.second =
+                    payloadOffset + static_cast<size_t>(transform.Size);
+            }
+            else
+            {
+                SetReadRuns(info, sizeof(T));
+            }
+
             const size_t fileIndex =
-                static_cast<size_t>(blockCharacteristics.Statistics.FileIndex);
+                static_cast<size_t>(blockIndex.FileIndices[b]);
 
             infoMap[fileIndex][step].push_back(std::move(info));
         }
@@ -319,162 +447,127 @@ BP3Deserializer::GetSubFileInfo(const Variable<T> &variable) const
 }
 
 template <class T>
-void BP3Deserializer::ClipContiguousMemoryCommon(
-    Variable<T> &variable, const std::vector<char> &contiguousMemory,
-    const Box<Dims> &blockBox, const Box<Dims> &intersectionBox) const
+const BP3Deserializer::BlockIndex &
+BP3Deserializer::GetBlockIndex(const Variable<T> &variable, const size_t step,
+                               const std::vector<size_t> &blockStarts) const
 {
-    const Dims &start = intersectionBox.first;
-    if (start.size() == 1) // 1D copy memory
+    BlockIndex &blockIndex = m_BlockIndices[variable.m_Name][step];
+    if (blockIndex.BlockStarts == blockStarts)
     {
-        // normalize intersection start with variable.m_Start
-        const size_t normalizedStart =
-            (start[0] - variable.m_Start[0]) * sizeof(T);
-        char *rawVariableData = reinterpret_cast<char *>(variable.GetData());
-
-        std::copy(contiguousMemory.begin(), contiguousMemory.end(),
-                  &rawVariableData[normalizedStart]);
-
-        return;
+        return blockIndex;
     }
 
-    if (m_IsRowMajor) // stored with C, C++, Python
-    {
-        ClipContiguousMemoryCommonRow(variable, contiguousMemory, blockBox,
-                                      intersectionBox);
-    }
-    else // stored with Fortran, R
-    {
-        ClipContiguousMemoryCommonColumn(variable, contiguousMemory, blockBox,
-                                         intersectionBox);
-    }
-}
+    blockIndex = BlockIndex();
+    blockIndex.BlockStarts = blockStarts;
 
-template <class T>
-void BP3Deserializer::ClipContiguousMemoryCommonRow(
-    Variable<T> &variable, const std::vector<char> &contiguousMemory,
-    const Box<Dims> &blockBox, const Box<Dims> &intersectionBox) const
-{
-    const Dims &start = intersectionBox.first;
-    const Dims &end = intersectionBox.second;
-    const size_t stride = (end.back() - start.back() + 1) * sizeof(T);
-
-    Dims currentPoint(start); // current point for memory copy
+    const auto &buffer = m_Metadata.m_Buffer;
+    const size_t blocks = blockStarts.size();
 
-    const Box<Dims> selectionBox =
-        StartEndBox(variable.m_Start, variable.m_Count, m_ReverseDimensions);
+    blockIndex.PayloadOffsets.reserve(blocks);
+    blockIndex.FileIndices.reserve(blocks);
+    blockIndex.TransformIDs.reserve(blocks);
 
-    const size_t dimensions = start.size();
-    bool run = true;
+    std::vector<Box<Dims>> boxes;
+    boxes.reserve(blocks);
 
-    const size_t intersectionStart =
-        LinearIndex(blockBox, intersectionBox.first, true) * sizeof(T);
+    bool hasBounds = true;
 
-    while (run)
+    // blockPosition gets updated by Read, can't be const
+    for (size_t blockPosition : blockStarts)
     {
-        // here copy current linear memory between currentPoint and end
-        const size_t contiguousStart =
-            LinearIndex(blockBox, currentPoint, true) * sizeof(T) -
-            intersectionStart;
+        const Characteristics<T> blockCharacteristics =
+            ReadElementIndexCharacteristics<T>(
+                buffer, blockPosition,
+                static_cast<DataTypes>(GetDataType<T>()));
 
-        const size_t variableStart =
-            LinearIndex(selectionBox, currentPoint, true) * sizeof(T);
+        const auto &statistics = blockCharacteristics.Statistics;
 
-        char *rawVariableData = reinterpret_cast<char *>(variable.GetData());
+        boxes.push_back(StartEndBox(blockCharacteristics.Start,
+                                    blockCharacteristics.Count));
+        blockIndex.PayloadOffsets.push_back(statistics.PayloadOffset);
+        blockIndex.FileIndices.push_back(statistics.FileIndex);
 
-        std::copy(contiguousMemory.begin() + contiguousStart,
-                  contiguousMemory.begin() + contiguousStart + stride,
-                  rawVariableData + variableStart);
+        if (hasBounds)
+        {
+            hasBounds = InsertBlockBounds(blockIndex, statistics);
+        }
 
-        // here update each index recursively, always starting from the 2nd
-        // fastest changing index, since fastest changing index is the
-        // continuous part in the previous std::copy
-        size_t p = dimensions - 2;
-        while (true)
+        if (statistics.TransformType.empty())
         {
-            ++currentPoint[p];
-            if (currentPoint[p] > end[p])
-            {
-                if (p == 0)
-                {
-                    run = false; // we are done
-                    break;
-                }
-                else
-                {
-                    currentPoint[p] = start[p];
-                    --p;
-                }
-            }
-            else
-            {
-                break; // break inner p loop
-            }
-        } // dimension index update
-    }     // run
+            blockIndex.TransformIDs.push_back(0);
+        }
+        else
+        {
+            blockIndex.Transforms.push_back(
+                {statistics.TransformType, statistics.TransformParameters,
+                 statistics.TransformedSize});
+            blockIndex.TransformIDs.push_back(
+                static_cast<uint32_t>(blockIndex.Transforms.size()));
+        }
+    }
+
+    const size_t dimensions = boxes.empty() ? 0 : boxes.front().first.size();
+    for (const auto &box : boxes)
+    {
+        if (box.first.size() != dimensions)
+        {
+            blockIndex.Uniform = false;
+            blockIndex.Boxes = std::move(boxes);
+            return blockIndex;
+        }
+    }
+
+    blockIndex.Dimensions = dimensions;
+    blockIndex.Starts.reserve(blocks * dimensions);
+    blockIndex.Ends.reserve(blocks * dimensions);
+    for (const auto &box : boxes)
+    {
+        blockIndex.Starts.insert(blockIndex.Starts.end(), box.first.begin(),
+                                 box.first.end());
+        blockIndex.Ends.insert(blockIndex.Ends.end(), box.second.begin(),
+                               box.second.end());
+    }
+
+    BuildBlockTree(blockIndex);
+    return blockIndex;
 }
 
 template <class T>
-void BP3Deserializer::ClipContiguousMemoryCommonColumn(
-    Variable<T> &variable, const std::vector<char> &contiguousMemory,
+void BP3Deserializer::ClipContiguousMemoryCommon(
+    Variable<T> &variable, const char *contiguousMemory,
     const Box<Dims> &blockBox, const Box<Dims> &intersectionBox) const
 {
-    const Dims &start = intersectionBox.first;
-    const Dims &end = intersectionBox.second;
-    const size_t stride = (end.front() - start.front() + 1) * sizeof(T);
-
-    Dims currentPoint(start); // current point for memory copy
-
-    const Box<Dims> selectionBox =
-        StartEndBox(variable.m_Start, variable.m_Count, m_ReverseDimensions);
-
-    const size_t dimensions = start.size();
-    bool run = true;
-
-    const size_t intersectionStart =
-        LinearIndex(blockBox, intersectionBox.first, false) * sizeof(T);
-
-    while (run)
+    Box<Dims> selectionBox;
+    if (variable.m_MemoryCount.empty())
     {
-        // here copy current linear memory between currentPoint and end
-        const size_t contiguousStart =
-            LinearIndex(blockBox, currentPoint, false) * sizeof(T) -
-            intersectionStart;
-
-        const size_t variableStart =
-            LinearIndex(selectionBox, currentPoint, false) * sizeof(T);
+        selectionBox = StartEndBox(variable.m_Start, variable.m_Count,
+                                   m_ReverseDimensions);
+    }
+    else
+    {
+        // the whole memory block in global coordinates, its start wraps
+        // around if the selection is near 0, only strides and differences
+        // from it are used
+        Dims memoryBlockStart(variable.m_Start);
+        for (size_t d = 0; d < memoryBlockStart.size(); ++d)
+        {
+            memoryBlockStart[d] -= variable.m_MemoryStart[d];
+        }
+        selectionBox = StartEndBox(memoryBlockStart, variable.m_MemoryCount,
+                                   m_ReverseDimensions);
+    }
 
-        char *rawVariableData = reinterpret_cast<char *>(variable.GetData());
+    // reversed dimensions keep the stored memory order, both blocks use the
+    // writer's layout
+    const size_t variableStart =
+        LinearIndex(selectionBox, intersectionBox.first, m_IsRowMajor) *
+        sizeof(T);
 
-        std::copy(&contiguousMemory[contiguousStart],
-                  &contiguousMemory[contiguousStart + stride],
-                  &rawVariableData[variableStart]);
+    char *rawVariableData = reinterpret_cast<char *>(variable.GetData());
 
-        // here update each index recursively, always starting from the 2nd
-        // fastest changing index, since fastest changing index is the
-        // continuous part in the previous std::copy
-        size_t p = 1;
-        while (true)
-        {
-            ++currentPoint[p];
-            if (currentPoint[p] > end[p])
-            {
-                if (p == dimensions - 1)
-                {
-                    run = false; // we are done
-                    break;
-                }
-                else
-                {
-                    currentPoint[p] = start[p];
-                    ++p;
-                }
-            }
-            else
-            {
-                break; // break inner p loop
-            }
-        } // dimension index update
-    }
+    CopyMemoryBox(rawVariableData + variableStart, selectionBox, m_IsRowMajor,
+                  contiguousMemory, blockBox, m_IsRowMajor, intersectionBox,
+                  sizeof(T), m_Threads, m_ThreadPool.get());
 }
 
 } // end namespace format
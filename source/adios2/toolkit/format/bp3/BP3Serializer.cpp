@@ -12,8 +12,9 @@
 #include "BP3Serializer.tcc"
 
 #include <chrono>
-#include <future>
+#include <cstring> //std::memcpy
 #include <string>
+#include <utility> //std::pair
 #include <vector>
 
 #include "adios2/helper/adiosFunctions.h" //GetType<T>, ReadValue<T>,
@@ -29,6 +30,7 @@ namespace format
 {
 
 std::mutex BP3Serializer::m_Mutex;
+constexpr uint32_t BP3Serializer::StatsSumBitmap;
 
 BP3Serializer::BP3Serializer(MPI_Comm mpiComm, const bool debugMode)
 : BP3Base(mpiComm, debugMode)
@@ -37,15 +39,25 @@ BP3Serializer::BP3Serializer(MPI_Comm mpiComm, const bool debugMode)
 
 void BP3Serializer::PutProcessGroupIndex(
     const std::string &ioName, const std::string hostLanguage,
-    const std::vector<std::string> &transportsTypes) noexcept
+    const std::vector<std::string> &transportsTypes)
 {
     ProfilerStart("buffering");
     std::vector<char> &metadataBuffer = m_MetadataSet.PGIndex.Buffer;
 
+    const std::string timeStepName(std::to_string(m_MetadataSet.TimeStep));
+
+    // pg record and vars count and length, patched in SerializeDataBuffer
+    const size_t pgSize = 8 + 1 + (2 + ioName.size()) + 4 +
+                          (2 + timeStepName.size()) +
+                          sizeof(m_MetadataSet.TimeStep) + 3 +
+                          3 * transportsTypes.size() + 12;
+    m_Data.ReserveChunk(pgSize, " when writing process group index");
+
     std::vector<char> &dataBuffer = m_Data.m_Buffer;
     size_t &dataPosition = m_Data.m_Position;
+    const size_t dataPGPosition = dataPosition;
 
-    m_MetadataSet.DataPGLengthPosition = dataPosition;
+    m_MetadataSet.DataPGLengthPosition = m_Data.GetDataSize();
     dataPosition += 8; // skip pg length (8)
 
     const std::size_t metadataPGLengthPosition = metadataBuffer.size();
@@ -55,7 +67,8 @@ void BP3Serializer::PutProcessGroupIndex(
     PutNameRecord(ioName, metadataBuffer);
 
     // write if data is column major in metadata and data
-    const char columnMajor = (IsRowMajor(hostLanguage) == false) ? 'y' : 'n';
+    m_IsRowMajor = IsRowMajor(hostLanguage);
+    const char columnMajor = (m_IsRowMajor == false) ? 'y' : 'n';
     InsertToBuffer(metadataBuffer, &columnMajor);
     CopyToBuffer(dataBuffer, dataPosition, &columnMajor);
 
@@ -69,7 +82,6 @@ void BP3Serializer::PutProcessGroupIndex(
     dataPosition += 4;
 
     // time step name to metadata and data
-    const std::string timeStepName(std::to_string(m_MetadataSet.TimeStep));
     PutNameRecord(timeStepName, metadataBuffer);
     PutNameRecord(timeStepName, dataBuffer, dataPosition);
 
@@ -104,11 +116,10 @@ void BP3Serializer::PutProcessGroupIndex(
     }
 
     // update absolute position
-    m_Data.m_AbsolutePosition +=
-        dataPosition - m_MetadataSet.DataPGLengthPosition;
+    m_Data.m_AbsolutePosition += dataPosition - dataPGPosition;
     // pg vars count and position
     m_MetadataSet.DataPGVarsCount = 0;
-    m_MetadataSet.DataPGVarsCountPosition = dataPosition;
+    m_MetadataSet.DataPGVarsCountPosition = m_Data.GetDataSize();
     // add vars count and length
     dataPosition += 12;
     m_Data.m_AbsolutePosition += 12; // add vars count and length
@@ -160,10 +171,23 @@ void BP3Serializer::CloseStream(IO &io)
         SerializeDataBuffer(io);
     }
     SerializeMetadataInData(false);
-    m_Profiler.Bytes.at("buffering") += m_Data.m_Position;
+    m_Profiler.Bytes.at("buffering") += m_Data.GetDataSize();
     ProfilerStop("buffering");
 }
 
+void BP3Serializer::ResetIndices() noexcept
+{
+    SerialElementIndex &pgIndex = m_MetadataSet.PGIndex;
+    pgIndex.Buffer.clear();
+    pgIndex.Count = 0;
+    pgIndex.LastUpdatedPosition = 0;
+    pgIndex.LastAggregatedPosition = 0;
+    m_MetadataSet.DataPGCount = 0;
+    m_MetadataSet.VarsIndices.clear();
+    m_MetadataSet.AttributesIndices.clear();
+    m_MetadataSet.AreAttributesWritten = false;
+}
+
 std::string BP3Serializer::GetRankProfilingJSON(
     const std::vector<std::string> &transportsTypes,
     const std::vector<profiling::IOChrono *> &transportsProfilers) noexcept
@@ -228,30 +252,252 @@ BP3Serializer::AggregateProfilingJSON(const std::string &rankProfilingLog)
 
 void BP3Serializer::AggregateCollectiveMetadata()
 {
-    const uint64_t pgIndexStart = m_Metadata.m_Position;
-    AggregateIndex(m_MetadataSet.PGIndex, m_MetadataSet.DataPGCount);
+    AggregateCollectiveMetadata(m_MPIComm, m_Metadata, true);
+}
+
+void BP3Serializer::AggregateCollectiveMetadata(MPI_Comm comm,
+                                                BufferSTL &bufferSTL,
+                                                const bool inMetadataBuffer)
+{
+    AggregateMetadataSet(m_MetadataSet, comm, bufferSTL, inMetadataBuffer);
+}
+
+void BP3Serializer::AggregateCollectiveStepMetadata()
+{
+    // copies the header and the sets added since the last aggregation
+    auto lf_GetStepIndices =
+        [&](std::unordered_map<std::string, SerialElementIndex> &indices,
+            std::unordered_map<std::string, SerialElementIndex> &stepIndices) {
+
+            for (auto &indexPair : indices)
+            {
+                SerialElementIndex &index = indexPair.second;
+                const auto &buffer = index.Buffer;
+
+                size_t headerSize = 0;
+                ReadElementIndexHeader(buffer, headerSize);
+
+                size_t &lastPosition = index.LastAggregatedPosition;
+                if (lastPosition < headerSize)
+                {
+                    lastPosition = headerSize;
+                }
+
+                if (lastPosition == buffer.size())
+                {
+                    continue;
+                }
+
+                uint64_t setsCount = 0;
+                size_t position = lastPosition;
+                while (position < buffer.size())
+                {
+                    // skip characteristics count
+                    position += 1;
+                    const size_t length = static_cast<size_t>(
+                        ReadValue<uint32_t>(buffer, position));
+                    position += length;
+                    ++setsCount;
+                }
+
+                SerialElementIndex stepIndex(
+                    index.MemberID, headerSize + buffer.size() - lastPosition);
+                auto &stepBuffer = stepIndex.Buffer;
+                stepBuffer.insert(stepBuffer.end(), buffer.begin(),
+                                  buffer.begin() + headerSize);
+                stepBuffer.insert(stepBuffer.end(),
+                                  buffer.begin() + lastPosition, buffer.end());
+
+                const uint32_t stepLength =
+                    static_cast<uint32_t>(stepBuffer.size() - 4);
+                size_t stepPosition = 0;
+                CopyToBuffer(stepBuffer, stepPosition, &stepLength);
+                // sets count is the last header field
+                stepPosition = headerSize - 8;
+                CopyToBuffer(stepBuffer, stepPosition, &setsCount);
+                stepIndex.Count = setsCount;
+
+                stepIndices.emplace(indexPair.first, std::move(stepIndex));
+                lastPosition = buffer.size();
+            }
+        };
+
+    MetadataSet stepMetadataSet;
+
+    // PG Index entries don't have a header
+    const auto &pgBuffer = m_MetadataSet.PGIndex.Buffer;
+    auto &pgLastPosition = m_MetadataSet.PGIndex.LastAggregatedPosition;
+    size_t pgPosition = pgLastPosition;
+    while (pgPosition < pgBuffer.size())
+    {
+        ReadProcessGroupIndexHeader(pgBuffer, pgPosition);
+        ++stepMetadataSet.DataPGCount;
+    }
+    stepMetadataSet.PGIndex.Buffer.assign(pgBuffer.begin() + pgLastPosition,
+                                          pgBuffer.end());
+    pgLastPosition = pgBuffer.size();
+
+    lf_GetStepIndices(m_MetadataSet.VarsIndices, stepMetadataSet.VarsIndices);
+    lf_GetStepIndices(m_MetadataSet.AttributesIndices,
+                      stepMetadataSet.AttributesIndices);
+
+    AggregateMetadataSet(stepMetadataSet, m_MPIComm, m_Metadata, true);
+}
+
+void BP3Serializer::UpdateOffsetsInMetadata(const uint64_t shift) noexcept
+{
+    auto lf_ShiftOffset = [&](std::vector<char> &buffer,
+                              const size_t idPosition, const uint8_t id) {
+        if (buffer[idPosition] != static_cast<char>(id))
+        {
+            return;
+        }
+
+        size_t position = idPosition + 1;
+        const uint64_t offset = ReadValue<uint64_t>(buffer, position) + shift;
+        position = idPosition + 1;
+        CopyToBuffer(buffer, position, &offset);
+    };
+
+    auto lf_UpdateIndex = [&](SerialElementIndex &index) {
+        auto &buffer = index.Buffer;
+        auto &position = index.LastUpdatedPosition;
+
+        if (position == 0)
+        {
+            ReadElementIndexHeader(buffer, position);
+        }
+
+        while (position < buffer.size())
+        {
+            // skip characteristics count
+            position += 1;
+            const size_t length =
+                static_cast<size_t>(ReadValue<uint32_t>(buffer, position));
+            const size_t end = position + length;
+
+            // offset and payload offset are always the last characteristics
+            lf_ShiftOffset(buffer, end - 18, characteristic_offset);
+            lf_ShiftOffset(buffer, end - 9, characteristic_payload_offset);
+            position = end;
+        }
+    };
 
-    const uint64_t variablesIndexStart = m_Metadata.m_Position;
-    AggregateMergeIndex(m_MetadataSet.VarsIndices);
+    // PG Index, offset is the last field of each pg entry
+    auto &pgBuffer = m_MetadataSet.PGIndex.Buffer;
+    auto &pgPosition = m_MetadataSet.PGIndex.LastUpdatedPosition;
+    while (pgPosition < pgBuffer.size())
+    {
+        ReadProcessGroupIndexHeader(pgBuffer, pgPosition);
+        size_t offsetPosition = pgPosition - 8;
+        const uint64_t offset =
+            ReadValue<uint64_t>(pgBuffer, offsetPosition) + shift;
+        offsetPosition = pgPosition - 8;
+        CopyToBuffer(pgBuffer, offsetPosition, &offset);
+    }
 
-    const uint64_t attributesIndexStart = m_Metadata.m_Position;
-    AggregateMergeIndex(m_MetadataSet.AttributesIndices);
+    for (auto &indexPair : m_MetadataSet.VarsIndices)
+    {
+        lf_UpdateIndex(indexPair.second);
+    }
 
-    if (m_RankMPI == 0)
+    for (auto &indexPair : m_MetadataSet.AttributesIndices)
     {
-        m_Metadata.Resize(m_Metadata.m_Position + m_MetadataSet.MiniFooterSize,
-                          " when writing collective bp1 Minifooter");
-        PutMinifooter(pgIndexStart, variablesIndexStart, attributesIndexStart,
-                      m_Metadata.m_Buffer, m_Metadata.m_Position, true);
-        m_Metadata.m_AbsolutePosition = m_Metadata.m_Position;
+        lf_UpdateIndex(indexPair.second);
     }
 }
 
+void BP3Serializer::AppendMetadataIndices(const std::vector<char> &buffer,
+                                          const Minifooter &minifooter)
+{
+    auto lf_SetIndices =
+        [&](size_t position,
+            std::unordered_map<std::string, SerialElementIndex> &indices) {
+
+            position += 4; // skip count
+            const uint64_t length = ReadValue<uint64_t>(buffer, position);
+            const size_t endPosition = position + static_cast<size_t>(length);
+
+            while (position < endPosition)
+            {
+                const size_t elementStart = position;
+                const ElementIndexHeader header =
+                    ReadElementIndexHeader(buffer, position);
+                const size_t elementEnd =
+                    elementStart + static_cast<size_t>(header.Length) + 4;
+
+                SerialElementIndex index(header.MemberID,
+                                         elementEnd - elementStart);
+                index.Buffer.assign(buffer.begin() + elementStart,
+                                    buffer.begin() + elementEnd);
+                index.Count = header.CharacteristicsSetsCount;
+                // existing offsets are final and already aggregated
+                index.LastUpdatedPosition = index.Buffer.size();
+                index.LastAggregatedPosition = index.Buffer.size();
+
+                indices.emplace(header.Name, std::move(index));
+                position = elementEnd;
+            }
+        };
+
+    // PG Index
+    size_t position = static_cast<size_t>(minifooter.PGIndexStart);
+    const uint64_t pgCount = ReadValue<uint64_t>(buffer, position);
+    const uint64_t pgLength = ReadValue<uint64_t>(buffer, position);
+
+    auto &pgIndex = m_MetadataSet.PGIndex;
+    pgIndex.Buffer.assign(buffer.begin() + position,
+                          buffer.begin() + position +
+                              static_cast<size_t>(pgLength));
+    pgIndex.LastUpdatedPosition = pgIndex.Buffer.size();
+    pgIndex.LastAggregatedPosition = pgIndex.Buffer.size();
+    m_MetadataSet.DataPGCount = pgCount;
+
+    lf_SetIndices(static_cast<size_t>(minifooter.VarsIndexStart),
+                  m_MetadataSet.VarsIndices);
+    lf_SetIndices(static_cast<size_t>(minifooter.AttributesIndexStart),
+                  m_MetadataSet.AttributesIndices);
+}
+
 // PRIVATE FUNCTIONS
+void BP3Serializer::AggregateMetadataSet(const MetadataSet &metadataSet,
+                                         MPI_Comm comm, BufferSTL &bufferSTL,
+                                         const bool inMetadataBuffer)
+{
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+
+    // index starts are absolute positions in the sub-file footer
+    const size_t startOffset =
+        inMetadataBuffer ? 0 : bufferSTL.m_AbsolutePosition;
+
+    const uint64_t pgIndexStart = startOffset + bufferSTL.m_Position;
+    AggregateIndex(metadataSet.PGIndex, metadataSet.DataPGCount, comm,
+                   bufferSTL);
+
+    const uint64_t variablesIndexStart = startOffset + bufferSTL.m_Position;
+    AggregateMergeIndex(metadataSet.VarsIndices, comm, bufferSTL);
+
+    const uint64_t attributesIndexStart = startOffset + bufferSTL.m_Position;
+    AggregateMergeIndex(metadataSet.AttributesIndices, comm, bufferSTL);
+
+    if (rank == 0)
+    {
+        bufferSTL.Resize(bufferSTL.m_Position + m_MetadataSet.MiniFooterSize,
+                         " when writing collective bp1 Minifooter");
+        PutMinifooter(pgIndexStart, variablesIndexStart, attributesIndexStart,
+                      bufferSTL.m_Buffer, bufferSTL.m_Position,
+                      inMetadataBuffer);
+        bufferSTL.m_AbsolutePosition = startOffset + bufferSTL.m_Position;
+    }
+}
+
 void BP3Serializer::PutAttributes(IO &io)
 {
     const auto attributesDataMap = io.GetAttributesDataMap();
 
+    m_Data.ReserveChunk(12, " when writing attributes");
+
     auto &buffer = m_Data.m_Buffer;
     auto &position = m_Data.m_Position;
     auto &absolutePosition = m_Data.m_AbsolutePosition;
@@ -264,8 +510,8 @@ void BP3Serializer::PutAttributes(IO &io)
         static_cast<uint32_t>(attributesDataMap.size());
     CopyToBuffer(buffer, position, &attributesCount);
 
-    // will go back
-    const size_t attributesLengthPosition = position;
+    // will go back, records may continue in other chunks
+    const size_t attributesLengthPosition = m_Data.GetDataSize();
     position += 8; // skip attributes length
 
     absolutePosition += position - attributesCountPosition;
@@ -287,8 +533,10 @@ void BP3Serializer::PutAttributes(IO &io)
         stats.Offset = absolutePosition;                                       \
         stats.MemberID = memberID;                                             \
         stats.Step = m_MetadataSet.TimeStep;                                   \
-        stats.FileIndex = static_cast<uint32_t>(m_RankMPI);                    \
+        stats.FileIndex = GetFileIndex();                                      \
         Attribute<T> &attribute = *io.InquireAttribute<T>(name);               \
+        m_Data.ReserveChunk(GetAttributeSizeInData(attribute),                 \
+                            " when writing attribute " + name);                \
         PutAttributeInData(attribute, stats);                                  \
         PutAttributeInIndex(attribute, stats);                                 \
     }
@@ -300,10 +548,10 @@ void BP3Serializer::PutAttributes(IO &io)
 
     // complete attributes length
     const uint64_t attributesLength =
-        static_cast<uint64_t>(position - attributesLengthPosition);
+        static_cast<uint64_t>(m_Data.GetDataSize() - attributesLengthPosition);
 
-    size_t backPosition = attributesLengthPosition;
-    CopyToBuffer(buffer, backPosition, &attributesLength);
+    std::memcpy(m_Data.GetData(attributesLengthPosition), &attributesLength,
+                sizeof(attributesLength));
 }
 
 void BP3Serializer::PutDimensionsRecord(const Dims &localDimensions,
@@ -415,19 +663,24 @@ BP3Serializer::SerialElementIndex &BP3Serializer::GetSerialElementIndex(
     return itName->second;
 }
 
-void BP3Serializer::SerializeDataBuffer(IO &io) noexcept
+void BP3Serializer::SerializeDataBuffer(IO &io)
 {
-    auto &buffer = m_Data.m_Buffer;
-    auto &position = m_Data.m_Position;
-    auto &absolutePosition = m_Data.m_AbsolutePosition;
+    // positions are from m_Data.GetDataSize(), the pg record and its vars
+    // count and length can be in a sealed chunk
+    char *varsCountData = m_Data.GetData(m_MetadataSet.DataPGVarsCountPosition);
 
     // vars count and Length (only for PG)
-    CopyToBuffer(buffer, m_MetadataSet.DataPGVarsCountPosition,
-                 &m_MetadataSet.DataPGVarsCount);
-    // without record itself and vars count
-    const uint64_t varsLength =
-        position - m_MetadataSet.DataPGVarsCountPosition - 8 - 4;
-    CopyToBuffer(buffer, m_MetadataSet.DataPGVarsCountPosition, &varsLength);
+    std::memcpy(varsCountData, &m_MetadataSet.DataPGVarsCount,
+                sizeof(m_MetadataSet.DataPGVarsCount));
+    // without record itself and vars count, payloads left in user memory
+    // are part of the pg
+    const size_t externalSize =
+        GetExternalPayloadsSize(m_MetadataSet.DataPGVarsCountPosition);
+    const uint64_t varsLength = m_Data.GetDataSize() + externalSize -
+                                m_MetadataSet.DataPGVarsCountPosition - 4 -
+                                8 - 4;
+    std::memcpy(varsCountData + sizeof(m_MetadataSet.DataPGVarsCount),
+                &varsLength, sizeof(varsLength));
 
     // attributes are only written once
     if (!m_MetadataSet.AreAttributesWritten)
@@ -437,18 +690,34 @@ void BP3Serializer::SerializeDataBuffer(IO &io) noexcept
     }
     else
     {
-        position += 12;
-        absolutePosition += 12;
+        m_Data.ReserveChunk(12, " when writing attributes");
+        m_Data.m_Position += 12;
+        m_Data.m_AbsolutePosition += 12;
     }
 
     // Finish writing pg group length without record itself
-    const uint64_t dataPGLength =
-        position - m_MetadataSet.DataPGLengthPosition - 8;
-    CopyToBuffer(buffer, m_MetadataSet.DataPGLengthPosition, &dataPGLength);
+    const uint64_t dataPGLength = m_Data.GetDataSize() + externalSize -
+                                  m_MetadataSet.DataPGLengthPosition - 8;
+    std::memcpy(m_Data.GetData(m_MetadataSet.DataPGLengthPosition),
+                &dataPGLength, sizeof(dataPGLength));
 
     m_MetadataSet.DataPGIsOpen = false;
 }
 
+size_t BP3Serializer::GetExternalPayloadsSize(const size_t position) const
+    noexcept
+{
+    size_t size = 0;
+    for (const auto &externalPayload : m_ExternalPayloads)
+    {
+        if (externalPayload.Position >= position)
+        {
+            size += externalPayload.Size;
+        }
+    }
+    return size;
+}
+
 void BP3Serializer::SerializeMetadataInData(
     const bool updateAbsolutePosition) noexcept
 {
@@ -510,10 +779,17 @@ void BP3Serializer::SerializeMetadataInData(
     auto &position = m_Data.m_Position;
     auto &absolutePosition = m_Data.m_AbsolutePosition;
 
-    // reserve data to fit metadata,
-    // must replace with growth buffer strategy?
-    m_Data.Resize(position + footerSize,
-                  " when writing metadata in bp data buffer");
+    // reserve data to fit metadata, chunks are not moved
+    if (m_Data.m_ChunkSize > 0)
+    {
+        m_Data.ReserveChunk(footerSize,
+                            " when writing metadata in bp data buffer");
+    }
+    else
+    {
+        m_Data.Resize(position + footerSize,
+                      " when writing metadata in bp data buffer");
+    }
 
     // write pg index
     CopyToBuffer(buffer, position, &pgCount);
@@ -608,28 +884,32 @@ void BP3Serializer::PutMinifooter(const uint64_t pgIndexStart,
 }
 
 void BP3Serializer::AggregateIndex(const SerialElementIndex &index,
-                                   const size_t count)
+                                   const size_t count, MPI_Comm comm,
+                                   BufferSTL &bufferSTL)
 {
-    auto &buffer = m_Metadata.m_Buffer;
-    auto &position = m_Metadata.m_Position;
+    auto &buffer = bufferSTL.m_Buffer;
+    auto &position = bufferSTL.m_Position;
+
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
 
     size_t countPosition = position;
-    const size_t totalCount = ReduceValues<size_t>(count, m_MPIComm);
+    const size_t totalCount = ReduceValues<size_t>(count, comm);
 
-    if (m_RankMPI == 0)
+    if (rank == 0)
     {
         // Write count
         position += 16;
-        m_Metadata.Resize(position, " in call to AggregateIndex bp1 metadata");
+        bufferSTL.Resize(position, " in call to AggregateIndex bp1 metadata");
         const uint64_t totalCountU64 = static_cast<uint64_t>(totalCount);
         CopyToBuffer(buffer, countPosition, &totalCountU64);
     }
 
     // write contents
-    GathervVectors(index.Buffer, buffer, position, m_MPIComm);
+    GathervVectors(index.Buffer, buffer, position, comm);
 
     // get total length and write it after count and before index
-    if (m_RankMPI == 0)
+    if (rank == 0)
     {
         const uint64_t totalLengthU64 =
             static_cast<uint64_t>(position - countPosition - 8);
@@ -638,16 +918,28 @@ void BP3Serializer::AggregateIndex(const SerialElementIndex &index,
 }
 
 void BP3Serializer::AggregateMergeIndex(
-    const std::unordered_map<std::string, SerialElementIndex> &indices) noexcept
+    const std::unordered_map<std::string, SerialElementIndex> &indices,
+    MPI_Comm comm, BufferSTL &bufferSTL) noexcept
 {
+    int rank = 0;
+    int size = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    if (m_MetadataFanIn >= 2 && size > 1)
+    {
+        AggregateMergeIndexTree(indices, comm, bufferSTL);
+        return;
+    }
+
     // first serialize index
-    std::vector<char> serializedIndices = SerializeIndices(indices);
+    std::vector<char> serializedIndices = SerializeIndices(indices, comm);
     // gather in rank 0
     std::vector<char> gatheredSerialIndices;
     size_t gatheredSerialIndicesPosition = 0;
 
     GathervVectors(serializedIndices, gatheredSerialIndices,
-                   gatheredSerialIndicesPosition, m_MPIComm);
+                   gatheredSerialIndicesPosition, comm);
 
     // deallocate local serialized Indices
     std::vector<char>().swap(serializedIndices);
@@ -655,31 +947,31 @@ void BP3Serializer::AggregateMergeIndex(
     // deserialize in [name][rank] order
     const std::unordered_map<std::string, std::vector<SerialElementIndex>>
         nameRankIndices =
-            DeserializeIndicesPerRankThreads(gatheredSerialIndices);
+            DeserializeIndicesPerRankThreads(gatheredSerialIndices, comm);
 
     // deallocate gathered serial indices (full in rank 0 only)
     std::vector<char>().swap(gatheredSerialIndices);
 
     // to write count and length
-    auto &buffer = m_Metadata.m_Buffer;
-    auto &position = m_Metadata.m_Position;
+    auto &buffer = bufferSTL.m_Buffer;
+    auto &position = bufferSTL.m_Position;
 
     size_t countPosition = position;
 
-    if (m_RankMPI == 0)
+    if (rank == 0)
     {
         // Write count
         position += 12;
-        m_Metadata.Resize(position,
-                          ", in call to AggregateMergeIndex bp1 metadata");
+        bufferSTL.Resize(position,
+                         ", in call to AggregateMergeIndex bp1 metadata");
         const uint32_t totalCountU32 =
             static_cast<uint32_t>(nameRankIndices.size());
         CopyToBuffer(buffer, countPosition, &totalCountU32);
     }
 
-    MergeSerializeIndices(nameRankIndices);
+    MergeSerializeIndices(nameRankIndices, bufferSTL);
 
-    if (m_RankMPI == 0)
+    if (rank == 0)
     {
         // Write length
         const uint64_t totalLengthU64 =
@@ -688,10 +980,145 @@ void BP3Serializer::AggregateMergeIndex(
     }
 }
 
+void BP3Serializer::AggregateMergeIndexTree(
+    const std::unordered_map<std::string, SerialElementIndex> &indices,
+    MPI_Comm comm, BufferSTL &bufferSTL) noexcept
+{
+    int rank = 0;
+    int size = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    const int tag = 0;
+    const size_t fanIn = static_cast<size_t>(m_MetadataFanIn);
+
+    // merged index per name of the ranks in this rank subtree
+    std::unordered_map<std::string, std::vector<char>> merged;
+    for (const auto &indexPair : indices)
+    {
+        merged[indexPair.first] = indexPair.second.Buffer;
+    }
+
+    // subtrees at level l are rank ranges [r, r + fanIn^l), contiguous
+    // children merged in rank order keep the flat merge order
+    for (size_t stride = 1; stride < static_cast<size_t>(size);
+         stride *= fanIn)
+    {
+        const size_t group = stride * fanIn;
+        const size_t offset = static_cast<size_t>(rank) % group;
+
+        if (offset != 0)
+        {
+            std::vector<char> serialized;
+            for (const auto &mergedPair : merged)
+            {
+                InsertToBuffer(serialized, mergedPair.second.data(),
+                               mergedPair.second.size());
+            }
+            std::unordered_map<std::string, std::vector<char>>().swap(merged);
+
+            MPI_Send(serialized.data(), static_cast<int>(serialized.size()),
+                     MPI_CHAR, rank - static_cast<int>(offset), tag, comm);
+            return;
+        }
+
+        // slot 0 is this rank subtree, slot c is child c
+        std::unordered_map<std::string, std::vector<SerialElementIndex>>
+            nameChildIndices;
+
+        auto lf_Insert = [&](const size_t slot, const std::string &name,
+                             std::vector<char> &&buffer) {
+            auto itName = nameChildIndices.find(name);
+            if (itName == nameChildIndices.end())
+            {
+                const std::vector<SerialElementIndex> slots(
+                    fanIn, SerialElementIndex(0, 0));
+                itName = nameChildIndices.emplace(name, slots).first;
+            }
+            itName->second[slot].Buffer = std::move(buffer);
+        };
+
+        for (auto &mergedPair : merged)
+        {
+            lf_Insert(0, mergedPair.first, std::move(mergedPair.second));
+        }
+        merged.clear();
+
+        for (size_t c = 1; c < fanIn; ++c)
+        {
+            const size_t child = static_cast<size_t>(rank) + c * stride;
+            if (child >= static_cast<size_t>(size))
+            {
+                break;
+            }
+
+            MPI_Status status;
+            int count = 0;
+            MPI_Probe(static_cast<int>(child), tag, comm, &status);
+            MPI_Get_count(&status, MPI_CHAR, &count);
+
+            std::vector<char> received(static_cast<size_t>(count));
+            MPI_Recv(received.data(), count, MPI_CHAR, static_cast<int>(child),
+                     tag, comm, MPI_STATUS_IGNORE);
+
+            // concatenated index elements, each starts with its length
+            size_t position = 0;
+            while (position < received.size())
+            {
+                size_t headerPosition = position;
+                const ElementIndexHeader header =
+                    ReadElementIndexHeader(received, headerPosition);
+                const size_t elementSize =
+                    static_cast<size_t>(header.Length) + 4;
+
+                lf_Insert(c, header.Name,
+                          std::vector<char>(
+                              received.begin() + position,
+                              received.begin() + position + elementSize));
+                position += elementSize;
+            }
+        }
+
+        // rank 0 merges the last level straight into bufferSTL
+        if (group >= static_cast<size_t>(size))
+        {
+            auto &buffer = bufferSTL.m_Buffer;
+            auto &position = bufferSTL.m_Position;
+
+            // same layout as AggregateMergeIndex
+            size_t countPosition = position;
+            position += 12;
+            bufferSTL.Resize(
+                position, ", in call to AggregateMergeIndexTree bp1 metadata");
+            const uint32_t totalCountU32 =
+                static_cast<uint32_t>(nameChildIndices.size());
+            CopyToBuffer(buffer, countPosition, &totalCountU32);
+
+            MergeSerializeIndices(nameChildIndices, bufferSTL);
+
+            const uint64_t totalLengthU64 =
+                static_cast<uint64_t>(position - countPosition - 8);
+            CopyToBuffer(buffer, countPosition, &totalLengthU64);
+            return;
+        }
+
+        // inputs are released as soon as they are merged
+        for (auto itIndices = nameChildIndices.begin();
+             itIndices != nameChildIndices.end();)
+        {
+            merged[itIndices->first] = MergeIndex(itIndices->second);
+            itIndices = nameChildIndices.erase(itIndices);
+        }
+    }
+}
+
 std::vector<char> BP3Serializer::SerializeIndices(
-    const std::unordered_map<std::string, SerialElementIndex> &indices) const
-    noexcept
+    const std::unordered_map<std::string, SerialElementIndex> &indices,
+    MPI_Comm comm) const noexcept
 {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+
     std::vector<char> serializedIndices;
 
     for (const auto &indexPair : indices)
@@ -699,7 +1126,7 @@ std::vector<char> BP3Serializer::SerializeIndices(
         const SerialElementIndex &index = indexPair.second;
 
         // add rank at the beginning
-        const uint32_t rankSource = static_cast<uint32_t>(m_RankMPI);
+        const uint32_t rankSource = static_cast<uint32_t>(rank);
         InsertToBuffer(serializedIndices, &rankSource);
 
         // insert buffer
@@ -712,8 +1139,13 @@ std::vector<char> BP3Serializer::SerializeIndices(
 
 std::unordered_map<std::string, std::vector<BP3Base::SerialElementIndex>>
 BP3Serializer::DeserializeIndicesPerRankThreads(
-    const std::vector<char> &serialized) const noexcept
+    const std::vector<char> &serialized, MPI_Comm comm) const noexcept
 {
+    int rank = 0;
+    int size = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
     auto lf_Deserialize =
         [&](const int rankSource, const std::vector<char> &serialized,
             const size_t serializedPosition,
@@ -724,18 +1156,20 @@ BP3Serializer::DeserializeIndicesPerRankThreads(
             ElementIndexHeader header =
                 ReadElementIndexHeader(serialized, localPosition);
 
-            // mutex portion
+            // mutex portion, lookups can't race with insertions
+            std::vector<SerialElementIndex> *rankIndices = nullptr;
             {
                 std::lock_guard<std::mutex> lock(m_Mutex);
                 if (deserialized.count(header.Name) == 0)
                 {
                     deserialized[header.Name] = std::vector<SerialElementIndex>(
-                        m_SizeMPI, SerialElementIndex(header.MemberID, 0));
+                        size, SerialElementIndex(header.MemberID, 0));
                 }
+                rankIndices = &deserialized[header.Name];
             }
 
             const size_t bufferSize = static_cast<size_t>(header.Length) + 4;
-            SerialElementIndex &index = deserialized[header.Name][rankSource];
+            SerialElementIndex &index = (*rankIndices)[rankSource];
             InsertToBuffer(index.Buffer, &serialized[serializedPosition],
                            bufferSize);
         };
@@ -745,7 +1179,7 @@ BP3Serializer::DeserializeIndicesPerRankThreads(
         deserialized;
     const size_t serializedSize = serialized.size();
 
-    if (m_RankMPI != 0 || serializedSize < 8)
+    if (rank != 0 || serializedSize < 8)
     {
         return deserialized;
     }
@@ -778,62 +1212,40 @@ BP3Serializer::DeserializeIndicesPerRankThreads(
         return deserialized;
     }
 
-    std::vector<std::future<void>> asyncs(m_Threads);
-    std::vector<size_t> asyncPositions(m_Threads);
-    std::vector<int> asyncRankSources(m_Threads);
-
-    bool launched = false;
+    // rank sources and positions, each one deserialized in a pool task
+    std::vector<std::pair<int, size_t>> rankPositions;
 
     while (serializedPosition < serializedSize)
     {
-        // extract rank and index buffer size
-        for (unsigned int t = 0; t < m_Threads; ++t)
-        {
-            if (serializedPosition >= serializedSize)
-            {
-                break;
-            }
-
-            const int rankSource = static_cast<int>(
-                ReadValue<uint32_t>(serialized, serializedPosition));
-            asyncRankSources[t] = rankSource;
-            asyncPositions[t] = serializedPosition;
-
-            const size_t bufferSize = static_cast<size_t>(
-                ReadValue<uint32_t>(serialized, serializedPosition));
-            serializedPosition += bufferSize;
-
-            if (launched)
-            {
-                asyncs[t].get();
-            }
+        const int rankSource = static_cast<int>(
+            ReadValue<uint32_t>(serialized, serializedPosition));
+        const size_t position = serializedPosition;
 
-            if (serializedPosition <= serializedSize)
-            {
-                asyncs[t] =
-                    std::async(std::launch::async, lf_Deserialize,
-                               asyncRankSources[t], std::ref(serialized),
-                               asyncPositions[t], std::ref(deserialized));
-            }
-        }
+        const size_t bufferSize = static_cast<size_t>(
+            ReadValue<uint32_t>(serialized, serializedPosition));
+        serializedPosition += bufferSize;
 
-        launched = true;
-    }
-
-    for (auto &async : asyncs)
-    {
-        if (async.valid())
+        if (serializedPosition <= serializedSize)
         {
-            async.wait();
+            rankPositions.emplace_back(rankSource, position);
         }
     }
 
+    m_ThreadPool->ParallelFor(
+        rankPositions.size(), 1, m_Threads,
+        [&](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                lf_Deserialize(rankPositions[i].first, serialized,
+                               rankPositions[i].second, deserialized);
+            }
+        });
+
     return deserialized;
 }
 
-void BP3Serializer::MergeSerializeIndices(
-    const std::unordered_map<std::string, std::vector<SerialElementIndex>>
-        &nameRankIndices) noexcept
+std::vector<char> BP3Serializer::MergeIndex(
+    const std::vector<SerialElementIndex> &indices) const
 {
     auto lf_GetCharacteristics = [&](const std::vector<char> &buffer,
                                      size_t &position, const uint8_t dataType,
@@ -982,119 +1394,128 @@ void BP3Serializer::MergeSerializeIndices(
 
     };
 
-    auto lf_MergeRank = [&](const std::vector<SerialElementIndex> &indices) {
 
-        // extract header
-        ElementIndexHeader header;
-        // index non-empty buffer
-        size_t firstRank = 0;
-        // index positions per rank
-        std::vector<size_t> positions(indices.size(), 0);
-        // merge index length
-        size_t headerSize = 0;
+    // extract header
+    ElementIndexHeader header;
+    // index non-empty buffer
+    size_t firstRank = 0;
+    // index positions per rank
+    std::vector<size_t> positions(indices.size(), 0);
+    // merge index length
+    size_t headerSize = 0;
 
-        for (size_t r = 0; r < indices.size(); ++r)
+    for (size_t r = 0; r < indices.size(); ++r)
+    {
+        const auto &buffer = indices[r].Buffer;
+        if (buffer.empty())
         {
-            const auto &buffer = indices[r].Buffer;
-            if (buffer.empty())
-            {
-                continue;
-            }
-            size_t &position = positions[r];
+            continue;
+        }
+        size_t &position = positions[r];
 
-            header = ReadElementIndexHeader(buffer, position);
-            firstRank = r;
+        header = ReadElementIndexHeader(buffer, position);
+        firstRank = r;
 
-            headerSize = position;
-            break;
+        headerSize = position;
+        break;
+    }
+    // move all positions to headerSize
+    for (size_t r = 0; r < indices.size(); ++r)
+    {
+        const auto &buffer = indices[r].Buffer;
+        if (buffer.empty())
+        {
+            continue;
         }
-        // move all positions to headerSize
-        for (size_t r = 0; r < indices.size(); ++r)
+        positions[r] = headerSize;
+    }
+
+    uint64_t setsCount = 0;
+    unsigned int currentTimeStep = 1;
+    bool marching = true;
+    // header of the first rank, length and sets count are set at the end
+    std::vector<char> merged(indices[firstRank].Buffer.begin(),
+                             indices[firstRank].Buffer.begin() + headerSize);
+
+    while (marching)
+    {
+        marching = false;
+
+        for (size_t r = firstRank; r < indices.size(); ++r)
         {
             const auto &buffer = indices[r].Buffer;
             if (buffer.empty())
             {
                 continue;
             }
-            positions[r] = headerSize;
-        }
 
-        uint64_t setsCount = 0;
-        unsigned int currentTimeStep = 1;
-        bool marching = true;
-        std::vector<char> sorted;
+            auto &position = positions[r];
+            if (position < buffer.size())
+            {
+                marching = true;
+            }
+            else
+            {
+                continue;
+            }
 
-        while (marching)
-        {
-            marching = false;
+            uint8_t count = 0;
+            uint32_t length = 0;
+            uint32_t timeStep = static_cast<uint32_t>(currentTimeStep);
 
-            for (size_t r = firstRank; r < indices.size(); ++r)
+            while (timeStep == currentTimeStep)
             {
-                const auto &buffer = indices[r].Buffer;
-                if (buffer.empty())
-                {
-                    continue;
-                }
+                size_t localPosition = position;
+                lf_GetCharacteristics(buffer, localPosition, header.DataType,
+                                      count, length, timeStep);
 
-                auto &position = positions[r];
-                if (position < buffer.size())
-                {
-                    marching = true;
-                }
-                else
+                if (timeStep != currentTimeStep)
                 {
-                    continue;
+                    break;
                 }
 
-                uint8_t count = 0;
-                uint32_t length = 0;
-                uint32_t timeStep = static_cast<uint32_t>(currentTimeStep);
-
-                while (timeStep == currentTimeStep)
-                {
-                    size_t localPosition = position;
-                    lf_GetCharacteristics(buffer, localPosition,
-                                          header.DataType, count, length,
-                                          timeStep);
-
-                    if (timeStep != currentTimeStep)
-                    {
-                        break;
-                    }
-
-                    ++setsCount;
+                ++setsCount;
 
-                    // here copy to sorted buffer
-                    InsertToBuffer(sorted, &buffer[position], length + 5);
+                // here copy to merged buffer
+                InsertToBuffer(merged, &buffer[position], length + 5);
 
-                    position += length + 5;
+                position += length + 5;
 
-                    if (position >= buffer.size())
-                    {
-                        break;
-                    }
+                if (position >= buffer.size())
+                {
+                    break;
                 }
             }
-            ++currentTimeStep;
         }
+        ++currentTimeStep;
+    }
 
-        const uint32_t entryLength =
-            static_cast<uint32_t>(headerSize + sorted.size() - 4);
-        // Copy header to metadata buffer, need mutex here
+    const uint32_t entryLength = static_cast<uint32_t>(merged.size() - 4);
+    size_t position = 0;
+    CopyToBuffer(merged, position, &entryLength);
+    position = headerSize - 8;
+    CopyToBuffer(merged, position, &setsCount);
+    return merged;
+}
+
+void BP3Serializer::MergeSerializeIndices(
+    const std::unordered_map<std::string, std::vector<SerialElementIndex>>
+        &nameRankIndices,
+    BufferSTL &bufferSTL) noexcept
+{
+    auto lf_MergeRank = [&](const std::vector<SerialElementIndex> &indices) {
+
+        const std::vector<char> merged = MergeIndex(indices);
+        // Copy merged index to metadata buffer, need mutex here
         {
             std::lock_guard<std::mutex> lock(m_Mutex);
-            auto &buffer = m_Metadata.m_Buffer;
-            auto &position = m_Metadata.m_Position;
-
-            m_Metadata.Resize(buffer.size() +
-                                  static_cast<size_t>(entryLength + 4),
-                              "in call to MergeSerializeIndices bp3 index");
-
-            CopyToBuffer(buffer, position, &entryLength);
-            CopyToBuffer(buffer, position, &indices[firstRank].Buffer[4],
-                         headerSize - 8 - 4);
-            CopyToBuffer(buffer, position, &setsCount);
-            CopyToBuffer(buffer, position, sorted.data(), sorted.size());
+            auto &buffer = bufferSTL.m_Buffer;
+            auto &position = bufferSTL.m_Position;
+
+            bufferSTL.Resize(position + merged.size(),
+                             "in call to MergeSerializeIndices bp3 index");
+
+            CopyToBuffer(buffer, position, merged.data(), merged.size());
         }
     };
 
@@ -1204,10 +1625,13 @@ BP3Serializer::SetCollectiveProfilingJSON(const std::string &rankLog) const
 
 #define declare_template_instantiation(T)                                      \
     template void BP3Serializer::PutVariableMetadata(                          \
-        const Variable<T> &variable) noexcept;                                 \
+        const Variable<T> &variable);                                          \
                                                                                \
     template void BP3Serializer::PutVariablePayload(                           \
-        const Variable<T> &variable) noexcept;
+        const Variable<T> &variable, const bool zeroCopy) noexcept;            \
+                                                                               \
+    template size_t BP3Serializer::GetPayloadMaxSize(                          \
+        const Variable<T> &variable) const;
 
 ADIOS2_FOREACH_TYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -32,6 +32,23 @@ class BP3Serializer : public BP3Base
 public:
     std::vector<std::string> m_DeferredVariables;
     size_t m_DeferredVariablesDataSize = 0;
+
+    /** Variable payload left in user memory by a zero-copy
+     * PutVariablePayload */
+    struct ExternalPayload
+    {
+        /** position in m_Data where the payload belongs, from
+         * m_Data.GetDataSize() */
+        size_t Position;
+        /** user memory, must be valid until the buffer is written */
+        const char *Data;
+        size_t Size;
+    };
+
+    /** Zero-copy payloads in m_Data order, the engine writes them interleaved
+     * with m_Data and clears them */
+    std::vector<ExternalPayload> m_ExternalPayloads;
+
     /**
      * Unique constructor
      * @param mpiComm MPI communicator for BP1 Aggregator
@@ -50,21 +67,35 @@ public:
      */
     void PutProcessGroupIndex(
         const std::string &ioName, const std::string hostLanguage,
-        const std::vector<std::string> &transportsTypes) noexcept;
+        const std::vector<std::string> &transportsTypes);
 
     /**
-     * Put in buffer metadata for a given variable
+     * Put in buffer metadata for a given variable. If the variable has
+     * operators (AddTransform) the payload is transformed here with the first
+     * operator and kept until PutVariablePayload
      * @param variable
      */
     template <class T>
-    void PutVariableMetadata(const Variable<T> &variable) noexcept;
+    void PutVariableMetadata(const Variable<T> &variable);
 
     /**
      * Put in buffer variable payload. Expensive part.
      * @param variable payload input from m_PutValues
+     * @param zeroCopy true: payload is not copied, its user memory is added
+     * to m_ExternalPayloads. Ignored for strings and variables with operators.
+     */
+    template <class T>
+    void PutVariablePayload(const Variable<T> &variable,
+                            const bool zeroCopy = false) noexcept;
+
+    /**
+     * Upper bound of the variable payload size in the data buffer, from
+     * Operator::BufferMaxSize if the variable has a compression operator
+     * @param variable
+     * @return payload size in bytes to be reserved with ResizeBuffer
      */
     template <class T>
-    void PutVariablePayload(const Variable<T> &variable) noexcept;
+    size_t GetPayloadMaxSize(const Variable<T> &variable) const;
 
     /**
      *  Serializes data buffer and close current process group
@@ -96,6 +127,14 @@ public:
      */
     void CloseStream(IO &io);
 
+    /**
+     * Clears the PG, variables and attributes indices so the next metadata
+     * serialized only describes data put after this call, attributes are
+     * written again with the next PG. Used by engines sending each step as a
+     * self-contained buffer.
+     */
+    void ResetIndices() noexcept;
+
     /**
      * Get a string with profiling information for this rank
      * @param name stream name
@@ -120,12 +159,58 @@ public:
      */
     void AggregateCollectiveMetadata();
 
+    /**
+     * Creates a collective metadata buffer from all ranks in comm
+     * @param comm ranks participating, bufferSTL is populated in comm rank 0
+     * @param bufferSTL destination buffer
+     * @param inMetadataBuffer true: m_Metadata (metadata file),
+     * false: data buffer, index starts are relative to
+     * bufferSTL.m_AbsolutePosition (sub-file footer)
+     */
+    void AggregateCollectiveMetadata(MPI_Comm comm, BufferSTL &bufferSTL,
+                                     const bool inMetadataBuffer);
+
+    /**
+     * Collective. Creates a metadata block in m_Metadata (rank 0) from all
+     * ranks with only the PG and characteristics sets added to the indices
+     * since the last call. Index starts in its minifooter are relative to the
+     * beginning of the block.
+     */
+    void AggregateCollectiveStepMetadata();
+
+    /**
+     * Adds shift to all offsets (PG, variables and attributes) written in
+     * metadata indices since the last call. Used when aggregating to sub-files
+     * as this rank's data lands at a different offset than its own stream.
+     * @param shift to be added to the offsets
+     */
+    void UpdateOffsetsInMetadata(const uint64_t shift) noexcept;
+
+    /**
+     * Used in Append mode. Seeds the PG, variables and attributes indices
+     * with the ones in existing collective metadata, so they are merged with
+     * new steps at Close without re-reading any payload. Called only in the
+     * rank writing the collective metadata.
+     * @param buffer existing collective metadata (name.bp)
+     * @param minifooter parsed from buffer with BP3Deserializer
+     */
+    void AppendMetadataIndices(const std::vector<char> &buffer,
+                               const Minifooter &minifooter);
+
 private:
     /** BP format version */
     const uint8_t m_Version = 3;
 
     static std::mutex m_Mutex;
 
+    /** characteristic_bitmap value with StatsSum: sum and sum of squares */
+    static constexpr uint32_t StatsSumBitmap =
+        (1u << statistic_sum) | (1u << statistic_sum_square);
+
+    /** transformed payload from PutVariableMetadata, reused between variables
+     * and copied to m_Data by PutVariablePayload */
+    std::vector<char> m_OperationBuffer;
+
     /**
      * Put in BP buffer all attributes defined in an IO object.
      * Called by SerializeData function
@@ -164,6 +249,16 @@ private:
     void PutAttributeInData(const Attribute<T> &attribute,
                             Stats<T> &stats) noexcept;
 
+    /**
+     * Upper bound of the bytes written by PutAttributeInData, reserved in
+     * chunked data buffers
+     * @param attribute input
+     * @return attribute record size in bytes
+     */
+    template <class T>
+    size_t GetAttributeSizeInData(const Attribute<T> &attribute) const
+        noexcept;
+
     /**
      * Writes attribute value in index characteristic value.
      * @param characteristicID
@@ -207,6 +302,17 @@ private:
         const Stats<typename TypeInfo<T>::ValueType> &stats, const bool isNew,
         SerialElementIndex &index) noexcept;
 
+    /**
+     * Transforms the variable payload into m_OperationBuffer with its first
+     * compression operator, strings are not transformed
+     * @param variable
+     * @param stats receives TransformType, TransformParameters and
+     * TransformedSize
+     */
+    template <class T>
+    void PutOperation(const Variable<T> &variable,
+                      Stats<typename TypeInfo<T>::ValueType> &stats);
+
     template <class T>
     void PutVariableCharacteristics(
         const Variable<T> &variable,
@@ -261,6 +367,17 @@ private:
                          uint8_t &characteristicsCounter,
                          std::vector<char> &buffer) noexcept;
 
+    /**
+     * Writes a characteristic_transform_type record: operator type,
+     * pre-transform type and dimensions, operator parameters and the
+     * transformed payload size
+     */
+    template <class T>
+    void PutTransformRecord(
+        const Variable<T> &variable,
+        const Stats<typename TypeInfo<T>::ValueType> &stats,
+        uint8_t &characteristicsCounter, std::vector<char> &buffer) noexcept;
+
     /** Overloaded version for data buffer */
     template <class T>
     void PutBoundsRecord(const bool singleValue, const Stats<T> &stats,
@@ -309,7 +426,26 @@ private:
      * length and attributes count and attributes length
      * @param io object containing all attributes
      */
-    void SerializeDataBuffer(IO &io) noexcept;
+    void SerializeDataBuffer(IO &io);
+
+    /**
+     * Bytes in m_ExternalPayloads after a position in m_Data, part of the
+     * lengths written in SerializeDataBuffer
+     * @param position in m_Data, from m_Data.GetDataSize()
+     * @return total size of external payloads from position
+     */
+    size_t GetExternalPayloadsSize(const size_t position) const noexcept;
+
+    /**
+     * Common function for collective metadata from a metadata set
+     * @param metadataSet indices to be aggregated
+     * @param comm ranks participating, bufferSTL is populated in comm rank 0
+     * @param bufferSTL destination buffer
+     * @param inMetadataBuffer see AggregateCollectiveMetadata
+     */
+    void AggregateMetadataSet(const MetadataSet &metadataSet, MPI_Comm comm,
+                              BufferSTL &bufferSTL,
+                              const bool inMetadataBuffer);
 
     void PutMinifooter(const uint64_t pgIndexStart,
                        const uint64_t variablesIndexStart,
@@ -321,44 +457,76 @@ private:
      * Used for PG index, aggregates without merging
      * @param index input
      * @param count total number of indices
+     * @param comm communicator for aggregation
+     * @param bufferSTL destination, populated in comm rank 0
      */
-    void AggregateIndex(const SerialElementIndex &index, const size_t count);
+    void AggregateIndex(const SerialElementIndex &index, const size_t count,
+                        MPI_Comm comm, BufferSTL &bufferSTL);
 
     /**
      * Collective operation to aggregate and merge (sort) indices (variables and
      * attributes)
      * @param indices
+     * @param comm communicator for aggregation
+     * @param bufferSTL destination, populated in comm rank 0
      */
     void AggregateMergeIndex(
-        const std::unordered_map<std::string, SerialElementIndex>
-            &indices) noexcept;
+        const std::unordered_map<std::string, SerialElementIndex> &indices,
+        MPI_Comm comm, BufferSTL &bufferSTL) noexcept;
+
+    /**
+     * AggregateMergeIndex in a k-ary tree of fan-in m_MetadataFanIn, each
+     * parent merges the indices of its children subtrees per name before
+     * forwarding them, so rank 0 receives fanIn - 1 merged indices per level
+     * instead of every rank index. Same entries as the flat merge, possibly
+     * in a different variable order.
+     * @param indices
+     * @param comm communicator for aggregation
+     * @param bufferSTL destination, populated in comm rank 0
+     */
+    void AggregateMergeIndexTree(
+        const std::unordered_map<std::string, SerialElementIndex> &indices,
+        MPI_Comm comm, BufferSTL &bufferSTL) noexcept;
 
     /**
      * Returns a serialized buffer with all indices with format:
      * Rank (4 bytes), Buffer
      * @param indices input of all indices to be serialized
+     * @param comm rank in comm is used as source
      * @return buffer with serialized indices
      */
     std::vector<char> SerializeIndices(
-        const std::unordered_map<std::string, SerialElementIndex> &indices)
-        const noexcept;
+        const std::unordered_map<std::string, SerialElementIndex> &indices,
+        MPI_Comm comm) const noexcept;
 
     /**
      * In rank=0, deserialize gathered indices
      * @param serializedIndices input gathered indices
+     * @param comm communicator used for gathering
      * @return hash[name][rank] = bp index buffer
      */
     std::unordered_map<std::string, std::vector<SerialElementIndex>>
-    DeserializeIndicesPerRankThreads(
-        const std::vector<char> &serializedIndices) const noexcept;
+    DeserializeIndicesPerRankThreads(const std::vector<char> &serializedIndices,
+                                     MPI_Comm comm) const noexcept;
 
     /**
      * Merge indices by time step (default) and write to m_HeapBuffer.m_Metadata
      * @param nameRankIndices
+     * @param bufferSTL destination
      */
     void MergeSerializeIndices(
         const std::unordered_map<std::string, std::vector<SerialElementIndex>>
-            &nameRankIndices) noexcept;
+            &nameRankIndices,
+        BufferSTL &bufferSTL) noexcept;
+
+    /**
+     * Merges the indices of one variable or attribute by time step, then by
+     * position in indices (rank order)
+     * @param indices serialized indices, empty buffers are skipped
+     * @return merged index, with the layout of a single rank index
+     */
+    std::vector<char>
+    MergeIndex(const std::vector<SerialElementIndex> &indices) const;
 
     std::vector<char>
     SetCollectiveProfilingJSON(const std::string &rankLog) const;
@@ -368,15 +536,19 @@ private:
      * @param variable input from which Payload is taken
      */
     template <class T>
-    void PutPayloadInBuffer(const Variable<T> &variable) noexcept;
+    void PutPayloadInBuffer(const Variable<T> &variable,
+                            const bool zeroCopy) noexcept;
 };
 
 #define declare_template_instantiation(T)                                      \
     extern template void BP3Serializer::PutVariablePayload(                    \
-        const Variable<T> &variable) noexcept;                                 \
+        const Variable<T> &variable, const bool zeroCopy) noexcept;            \
                                                                                \
     extern template void BP3Serializer::PutVariableMetadata(                   \
-        const Variable<T> &variable) noexcept;
+        const Variable<T> &variable);                                          \
+                                                                               \
+    extern template size_t BP3Serializer::GetPayloadMaxSize(                   \
+        const Variable<T> &variable) const;
 
 ADIOS2_FOREACH_TYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -21,12 +21,12 @@ namespace format
 {
 
 template <class T>
-inline void
-BP3Serializer::PutVariableMetadata(const Variable<T> &variable) noexcept
+inline void BP3Serializer::PutVariableMetadata(const Variable<T> &variable)
 {
     ProfilerStart("buffering");
 
     Stats<typename TypeInfo<T>::ValueType> stats = GetStats<T>(variable);
+    PutOperation(variable, stats);
 
     // Get new Index or point to existing index
     bool isNew = true; // flag to check if variable is new
@@ -49,14 +49,28 @@ BP3Serializer::PutVariableMetadata(const Variable<T> &variable) noexcept
 }
 
 template <class T>
-inline void
-BP3Serializer::PutVariablePayload(const Variable<T> &variable) noexcept
+inline void BP3Serializer::PutVariablePayload(const Variable<T> &variable,
+                                              const bool zeroCopy) noexcept
 {
     ProfilerStart("buffering");
-    PutPayloadInBuffer(variable);
+    PutPayloadInBuffer(variable, zeroCopy);
     ProfilerStop("buffering");
 }
 
+template <class T>
+size_t BP3Serializer::GetPayloadMaxSize(const Variable<T> &variable) const
+{
+    const VariableBase::OperatorInfo *operatorInfo =
+        GetCompressionOperator(variable);
+    if (operatorInfo == nullptr)
+    {
+        return variable.PayloadSize();
+    }
+
+    return operatorInfo->ADIOSOperator.BufferMaxSize(
+        variable.GetData(), variable.m_Count, operatorInfo->Parameters);
+}
+
 // PRIVATE
 template <class T>
 size_t BP3Serializer::PutAttributeHeaderInData(const Attribute<T> &attribute,
@@ -180,6 +194,33 @@ void BP3Serializer::PutAttributeInData(const Attribute<T> &attribute,
     PutAttributeLengthInData(attribute, stats, attributeLengthPosition);
 }
 
+template <>
+inline size_t BP3Serializer::GetAttributeSizeInData(
+    const Attribute<std::string> &attribute) const noexcept
+{
+    // header, type and count or size
+    size_t size = 18 + attribute.m_Name.size();
+    if (attribute.m_IsSingleValue)
+    {
+        return size + attribute.m_DataSingleValue.size();
+    }
+
+    for (const auto &element : attribute.m_DataArray)
+    {
+        size += 5 + element.size(); // size and zero terminated
+    }
+    return size;
+}
+
+template <class T>
+size_t
+BP3Serializer::GetAttributeSizeInData(const Attribute<T> &attribute) const
+    noexcept
+{
+    // header, type and size
+    return 18 + attribute.m_Name.size() + attribute.m_Elements * sizeof(T);
+}
+
 template <>
 inline void BP3Serializer::PutAttributeCharacteristicValueInIndex(
     uint8_t &characteristicsCounter, const Attribute<std::string> &attribute,
@@ -315,7 +356,7 @@ BP3Serializer::GetStats(const Variable<std::string> &variable) const noexcept
 {
     Stats<typename TypeInfo<std::string>::ValueType> stats;
     stats.Step = m_MetadataSet.TimeStep;
-    stats.FileIndex = static_cast<uint32_t>(m_RankMPI);
+    stats.FileIndex = GetFileIndex();
     return stats;
 }
 
@@ -323,20 +364,121 @@ template <class T>
 BP3Serializer::Stats<typename TypeInfo<T>::ValueType>
 BP3Serializer::GetStats(const Variable<T> &variable) const noexcept
 {
-    Stats<typename TypeInfo<T>::ValueType> stats;
+    using ValueType = typename TypeInfo<T>::ValueType;
+
+    Stats<ValueType> stats;
     const std::size_t valuesSize = variable.TotalSize();
 
-    if (m_Verbosity == 0)
+    if (!variable.m_MemoryCount.empty())
     {
-        GetMinMaxThreads(variable.GetData(), valuesSize, stats.Min, stats.Max,
-                         m_Threads);
+        // ghost values around the memory selection are not part of the stats
+        const T *values = variable.GetData();
+        bool isFirst = true;
+        stats.BitSum = 0;
+        stats.BitSumSquare = 0;
+
+        ForEachMemorySelectionRun(
+            variable.m_MemoryStart, variable.m_MemoryCount, variable.m_Count,
+            m_IsRowMajor, [&](const size_t offset, const size_t size) {
+                if (m_Verbosity == 0)
+                {
+                    ValueType min, max;
+                    GetMinMaxThreads(values + offset, size, min, max, 1,
+                                     nullptr);
+                    // NaN values are skipped, as in GetMinMaxThreads
+                    if (isFirst || min < stats.Min || stats.Min != stats.Min)
+                    {
+                        stats.Min = min;
+                    }
+                    if (isFirst || max > stats.Max || stats.Max != stats.Max)
+                    {
+                        stats.Max = max;
+                    }
+                }
+
+                if (m_StatsSum)
+                {
+                    double sum, sumSquare;
+                    GetSums(values + offset, size, sum, sumSquare);
+                    stats.BitSum += sum;
+                    stats.BitSumSquare += sumSquare;
+                }
+                isFirst = false;
+            });
+    }
+    else
+    {
+        if (m_Verbosity == 0)
+        {
+            GetMinMaxThreads(variable.GetData(), valuesSize, stats.Min,
+                             stats.Max, m_Threads, m_ThreadPool.get());
+        }
+
+        if (m_StatsSum && !variable.m_SingleValue)
+        {
+            GetSums(variable.GetData(), valuesSize, stats.BitSum,
+                    stats.BitSumSquare);
+        }
     }
 
     stats.Step = m_MetadataSet.TimeStep;
-    stats.FileIndex = static_cast<uint32_t>(m_RankMPI);
+    stats.FileIndex = GetFileIndex();
     return stats;
 }
 
+template <>
+inline void BP3Serializer::PutOperation(
+    const Variable<std::string> & /*variable*/,
+    Stats<typename TypeInfo<std::string>::ValueType> & /*stats*/)
+{
+}
+
+template <class T>
+void BP3Serializer::PutOperation(const Variable<T> &variable,
+                                 Stats<typename TypeInfo<T>::ValueType> &stats)
+{
+    // chained operators are not supported, only the first compression
+    // operator is applied, callbacks leave the payload untransformed
+    const VariableBase::OperatorInfo *operatorInfo =
+        GetCompressionOperator(variable);
+    if (operatorInfo == nullptr)
+    {
+        return;
+    }
+
+    const Operator &op = operatorInfo->ADIOSOperator;
+
+    // variable parameters from AddTransform override the operator ones
+    Params parameters(operatorInfo->Parameters);
+    const Params &operatorParameters =
+        operatorInfo->ADIOSOperator.GetParameters();
+    parameters.insert(operatorParameters.begin(), operatorParameters.end());
+
+    // operators take contiguous input
+    const T *values = variable.GetData();
+    std::vector<T> selectionValues;
+    if (!variable.m_MemoryCount.empty())
+    {
+        selectionValues.resize(variable.TotalSize());
+        CopyFromMemorySelection(
+            reinterpret_cast<char *>(selectionValues.data()),
+            reinterpret_cast<const char *>(values), variable.m_MemoryStart,
+            variable.m_MemoryCount, variable.m_Count, m_IsRowMajor, sizeof(T),
+            m_Threads, m_ThreadPool.get());
+        values = selectionValues.data();
+    }
+
+    m_OperationBuffer.resize(GetPayloadMaxSize(variable));
+    const size_t transformedSize =
+        op.Compress(values, variable.m_Count, sizeof(T), variable.m_Type,
+                    m_OperationBuffer.data(), parameters);
+    m_OperationBuffer.resize(transformedSize);
+
+    stats.TransformType = op.m_Type;
+    stats.TransformParameters = std::move(parameters);
+    stats.TransformedSize = static_cast<uint64_t>(transformedSize);
+}
+
 template <class T>
 void BP3Serializer::PutVariableMetadataInData(
     const Variable<T> &variable,
@@ -377,8 +519,11 @@ void BP3Serializer::PutVariableMetadataInData(
 
     // Back to varLength including payload size
     // not need to remove its own size (8) from length from bpdump
-    const uint64_t varLength = static_cast<uint64_t>(
-        position - varLengthPosition + variable.PayloadSize());
+    const size_t payloadSize = stats.TransformType.empty()
+                                   ? variable.PayloadSize()
+                                   : static_cast<size_t>(stats.TransformedSize);
+    const uint64_t varLength =
+        static_cast<uint64_t>(position - varLengthPosition + payloadSize);
 
     size_t backPosition = varLengthPosition;
     CopyToBuffer(buffer, backPosition, &varLength);
@@ -489,7 +634,59 @@ void BP3Serializer::PutBoundsRecord(const bool isScalar, const Stats<T> &stats,
             PutCharacteristicRecord(characteristic_max, characteristicsCounter,
                                     stats.Max, buffer);
         }
+
+        if (m_StatsSum)
+        {
+            // bitmap selects the statistics stored in the stat record
+            PutCharacteristicRecord(characteristic_bitmap,
+                                    characteristicsCounter, StatsSumBitmap,
+                                    buffer);
+
+            const uint8_t id = characteristic_stat;
+            InsertToBuffer(buffer, &id);
+            InsertToBuffer(buffer, &stats.BitSum);
+            InsertToBuffer(buffer, &stats.BitSumSquare);
+            ++characteristicsCounter;
+        }
+    }
+}
+
+template <class T>
+void BP3Serializer::PutTransformRecord(
+    const Variable<T> &variable,
+    const Stats<typename TypeInfo<T>::ValueType> &stats,
+    uint8_t &characteristicsCounter, std::vector<char> &buffer) noexcept
+{
+    const uint8_t id = characteristic_transform_type;
+    InsertToBuffer(buffer, &id);
+    PutNameRecord(stats.TransformType, buffer);
+
+    const uint8_t dataType = GetDataType<T>();
+    InsertToBuffer(buffer, &dataType); // pre-transform type
+
+    // pre-transform dimensions
+    const uint8_t dimensions = static_cast<uint8_t>(variable.m_Count.size());
+    InsertToBuffer(buffer, &dimensions); // count
+    const uint16_t dimensionsLength = static_cast<uint16_t>(8 * dimensions);
+    InsertToBuffer(buffer, &dimensionsLength); // length
+    for (const size_t count : variable.m_Count)
+    {
+        const uint64_t count64 = static_cast<uint64_t>(count);
+        InsertToBuffer(buffer, &count64);
+    }
+
+    // parameters required to invert the transform (e.g. Zfp accuracy)
+    const uint8_t parametersCount =
+        static_cast<uint8_t>(stats.TransformParameters.size());
+    InsertToBuffer(buffer, &parametersCount);
+    for (const auto &parameter : stats.TransformParameters)
+    {
+        PutNameRecord(parameter.first, buffer);
+        PutNameRecord(parameter.second, buffer);
     }
+
+    InsertToBuffer(buffer, &stats.TransformedSize);
+    ++characteristicsCounter;
 }
 
 template <class T>
@@ -519,6 +716,19 @@ void BP3Serializer::PutBoundsRecord(const bool singleValue,
             PutCharacteristicRecord(characteristic_max, characteristicsCounter,
                                     stats.Max, buffer, position);
         }
+
+        if (m_StatsSum)
+        {
+            PutCharacteristicRecord(characteristic_bitmap,
+                                    characteristicsCounter, StatsSumBitmap,
+                                    buffer, position);
+
+            const uint8_t id = characteristic_stat;
+            CopyToBuffer(buffer, position, &id);
+            CopyToBuffer(buffer, position, &stats.BitSum);
+            CopyToBuffer(buffer, position, &stats.BitSumSquare);
+            ++characteristicsCounter;
+        }
     }
 }
 
@@ -631,6 +841,13 @@ void BP3Serializer::PutVariableCharacteristics(
                         buffer);
     ++characteristicsCounter;
 
+    if (!stats.TransformType.empty())
+    {
+        PutTransformRecord(variable, stats, characteristicsCounter, buffer);
+    }
+
+    // offset and payload offset must be the last records, see
+    // UpdateOffsetsInMetadata
     PutCharacteristicRecord(characteristic_offset, characteristicsCounter,
                             stats.Offset, buffer);
 
@@ -690,18 +907,52 @@ void BP3Serializer::PutVariableCharacteristics(
 }
 
 template <>
-inline void BP3Serializer::PutPayloadInBuffer(
-    const Variable<std::string> &variable) noexcept
+inline void
+BP3Serializer::PutPayloadInBuffer(const Variable<std::string> &variable,
+                                  const bool /*zeroCopy*/) noexcept
 {
     PutNameRecord(*variable.GetData(), m_Data.m_Buffer, m_Data.m_Position);
     m_Data.m_AbsolutePosition += variable.GetData()->size() + 2;
 }
 
 template <class T>
-void BP3Serializer::PutPayloadInBuffer(const Variable<T> &variable) noexcept
+void BP3Serializer::PutPayloadInBuffer(const Variable<T> &variable,
+                                       const bool zeroCopy) noexcept
 {
+    if (GetCompressionOperator(variable) != nullptr)
+    {
+        // transformed in PutVariableMetadata
+        CopyToBuffer(m_Data.m_Buffer, m_Data.m_Position,
+                     m_OperationBuffer.data(), m_OperationBuffer.size());
+        m_Data.m_AbsolutePosition += m_OperationBuffer.size();
+        return;
+    }
+
+    if (zeroCopy)
+    {
+        // m_Position stays, the payload is written from user memory
+        const char *data = reinterpret_cast<const char *>(variable.GetData());
+        m_ExternalPayloads.push_back(
+            {m_Data.GetDataSize(), data, variable.PayloadSize()});
+        m_Data.m_AbsolutePosition += variable.PayloadSize();
+        return;
+    }
+
+    if (!variable.m_MemoryCount.empty())
+    {
+        // strided gather of the selection, without a contiguous copy
+        CopyFromMemorySelection(
+            m_Data.m_Buffer.data() + m_Data.m_Position,
+            reinterpret_cast<const char *>(variable.GetData()),
+            variable.m_MemoryStart, variable.m_MemoryCount, variable.m_Count,
+            m_IsRowMajor, sizeof(T), m_Threads, m_ThreadPool.get());
+        m_Data.m_Position += variable.PayloadSize();
+        m_Data.m_AbsolutePosition += variable.PayloadSize();
+        return;
+    }
+
     CopyToBufferThreads(m_Data.m_Buffer, m_Data.m_Position, variable.GetData(),
-                        variable.TotalSize(), m_Threads);
+                        variable.TotalSize(), m_Threads, m_ThreadPool.get());
     m_Data.m_AbsolutePosition += variable.PayloadSize();
 }
 
@@ -215,6 +215,7 @@ WS_ReaderInfo writer_participate_in_reader_open(SstStream Stream)
     cpInfo.ContactInfo =
         attr_list_to_string(CMget_contact_list(Stream->CPInfo->cm));
     cpInfo.WriterID = CP_WSR_Stream;
+    cpInfo.MarshalMethod = Stream->MarshalMethod;
 
     combined_init.CP_Info = (void **)&cpInfo;
     combined_init.DP_Info = DP_WriterInfo;
@@ -279,7 +280,11 @@ SstStream SstWriterOpen(const char *Name, const char *params, MPI_Comm comm)
     CP_parseParams(Stream, params);
 
     char *Filename = TrimSuffix(Name);
-    Stream->DP_Interface = LoadDP("dummy");
+    Stream->DP_Interface = LoadDP(Stream->DataTransport);
+    if (Stream->DP_Interface == NULL)
+    {
+        return NULL;
+    }
 
     Stream->CPInfo = CP_getCPInfo(Stream->DP_Interface);
 
@@ -384,6 +389,14 @@ void SstWriterClose(SstStream Stream)
     }
     pthread_mutex_unlock(&Stream->DataLock);
 
+    /* formats of trailing discarded timesteps, never sent */
+    while (Stream->PendingFormats)
+    {
+        FFSFormatList Next = Stream->PendingFormats->Next;
+        free(Stream->PendingFormats);
+        Stream->PendingFormats = Next;
+    }
+
     gettimeofday(&CloseTime, NULL);
     timersub(&CloseTime, &Stream->ValidStartTime, &Diff);
     if (Stream->Stats)
@@ -423,6 +436,76 @@ static FFSFormatList AddUniqueFormats(FFSFormatList List,
     return Candidates;
 }
 
+/*
+ * Links Tail after the last entry of List, returns the joined list.
+ */
+static FFSFormatList AppendFormats(FFSFormatList List, FFSFormatList Tail)
+{
+    FFSFormatList Last = List;
+
+    if (!List)
+        return Tail;
+
+    while (Last->Next)
+    {
+        Last = Last->Next;
+    }
+    Last->Next = Tail;
+    return List;
+}
+
+/*
+ * Enforces QueueLimit before a new timestep is queued.  With the Block
+ * policy the writer waits for readers to release timesteps, with Discard
+ * the new timestep is dropped if the queue of any writer rank is full, so
+ * that all ranks agree.  Returns 1 if the timestep must be discarded.
+ *
+ * Only readers release timesteps, so Block waits without bound while no
+ * reader is attached (or the attached readers stop advancing).  Writers
+ * that must keep running without readers should use Discard.
+ */
+static int waitForQueueSpace(SstStream s, long Timestep)
+{
+    int Full, AnyFull;
+
+    if (s->QueueLimit == 0)
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&s->DataLock);
+    if (s->QueueFullPolicy == SstQueueFullBlock)
+    {
+        struct timeval Start, Stop, Diff;
+        gettimeofday(&Start, NULL);
+        while (s->QueuedTimestepCount >= s->QueueLimit)
+        {
+            CP_verbose(s, "Queue is full (%d timesteps), blocking timestep "
+                          "%ld until a timestep is released\n",
+                       s->QueuedTimestepCount, Timestep);
+            pthread_cond_wait(&s->DataCondition, &s->DataLock);
+        }
+        gettimeofday(&Stop, NULL);
+        timersub(&Stop, &Start, &Diff);
+        if (s->Stats)
+            s->Stats->QueueBlockedTimeSecs +=
+                (double)Diff.tv_usec / 1e6 + Diff.tv_sec;
+        pthread_mutex_unlock(&s->DataLock);
+        return 0;
+    }
+    Full = (s->QueuedTimestepCount >= s->QueueLimit);
+    pthread_mutex_unlock(&s->DataLock);
+
+    MPI_Allreduce(&Full, &AnyFull, 1, MPI_INT, MPI_LOR, s->mpiComm);
+    if (AnyFull)
+    {
+        CP_verbose(s, "Queue is full, discarding timestep %ld\n", Timestep);
+        if (s->Stats)
+            s->Stats->DiscardedTimesteps++;
+    }
+    return AnyFull;
+}
+
 extern void SstInternalProvideTimestep(SstStream s, SstData LocalMetadata,
                                        SstData Data, long Timestep,
                                        FFSFormatList Formats,
@@ -436,6 +519,26 @@ extern void SstInternalProvideTimestep(SstStream s, SstData LocalMetadata,
     CPTimestepList Entry = malloc(sizeof(struct _CPTimestepEntry));
     FFSFormatList XmitFormats = NULL;
 
+    if (waitForQueueSpace(s, Timestep))
+    {
+        /*
+         * formats are only sent when the field lists change, readers need
+         * them to decode every later timestep
+         */
+        s->PendingFormats = AppendFormats(Formats, s->PendingFormats);
+        if (DataFreeFunc)
+        {
+            ((void (*)(void *))DataFreeFunc)(FreeClientData);
+        }
+        free(Data);
+        free(LocalMetadata);
+        free(Entry);
+        return;
+    }
+
+    Formats = AppendFormats(Formats, s->PendingFormats);
+    s->PendingFormats = NULL;
+
     s->DP_Interface->provideTimestep(&Svcs, s->DP_Stream, Data, LocalMetadata,
                                      Timestep, &DP_TimestepInfo);
 
@@ -504,6 +607,17 @@ extern void SstInternalProvideTimestep(SstStream s, SstData LocalMetadata,
                             &Msg.RS_Stream);
 }
 
+extern void SstProvideTimestep(SstStream s, SstData LocalMetadata,
+                               SstData Data, long Timestep,
+                               SstFreeFunc FreeData, void *FreeClientData)
+{
+    CP_verbose(s, "Providing externally marshaled timestep %ld, metadata "
+                  "size %zu, data size %zu\n",
+               Timestep, LocalMetadata->DataSize, Data->DataSize);
+    SstInternalProvideTimestep(s, LocalMetadata, Data, Timestep, NULL,
+                               (void *)FreeData, FreeClientData);
+}
+
 static void **participate_in_reader_init_data_exchange(SstStream Stream,
                                                        void *dpInfo,
                                                        void **ret_data_block)
@@ -545,7 +659,11 @@ SstStream SstReaderOpen(const char *Name, const char *params, MPI_Comm comm)
 
     CP_parseParams(Stream, params);
 
-    Stream->DP_Interface = LoadDP("dummy");
+    Stream->DP_Interface = LoadDP(Stream->DataTransport);
+    if (Stream->DP_Interface == NULL)
+    {
+        return NULL;
+    }
 
     Stream->CPInfo = CP_getCPInfo(Stream->DP_Interface);
 
@@ -629,6 +747,9 @@ SstStream SstReaderOpen(const char *Name, const char *params, MPI_Comm comm)
     //    printf("\n");
 
     Stream->WriterCohortSize = ReturnData->WriterCohortSize;
+    /* all writer ranks marshal the same way */
+    Stream->MarshalMethod =
+        (SstMarshalMethod)ReturnData->CP_WriterInfo[0]->MarshalMethod;
     Stream->ConnectionsToWriter =
         calloc(sizeof(CP_PeerConnection), ReturnData->WriterCohortSize);
     for (i = 0; i < ReturnData->WriterCohortSize; i++)
@@ -850,7 +971,7 @@ extern CPTimestepList dequeueTimestep(SstStream Stream, long Timestep)
     /* main thread might be waiting on timesteps going away */
     pthread_cond_signal(&Stream->DataCondition);
     pthread_mutex_unlock(&Stream->DataLock);
-    return NULL;
+    return Ret;
 }
 
 extern void CP_ReleaseTimestepHandler(CManager cm, CMConnection conn,
@@ -879,6 +1000,11 @@ extern void CP_ReleaseTimestepHandler(CManager cm, CMConnection conn,
         &Svcs, Reader->ParentStream->DP_Stream, Msg->Timestep);
 
     Entry = dequeueTimestep(Reader->ParentStream, Msg->Timestep);
+    /* the queue only bounds writer memory if released data is freed */
+    if (Entry->DataFreeFunc)
+    {
+        Entry->DataFreeFunc(Entry->FreeClientData);
+    }
     free(Entry);
 }
 
@@ -1097,10 +1223,18 @@ extern void SstReaderClose(SstStream Stream)
     CMsleep(Stream->CPInfo->cm, 1);
 }
 
+extern SstMarshalMethod SstReaderMarshalMethod(SstStream Stream)
+{
+    return Stream->MarshalMethod;
+}
+
 extern SstStatusValue SstWaitForCompletion(SstStream Stream, void *handle)
 {
-    //   We need a way to return an error from DP */
-    Stream->DP_Interface->waitForCompletion(&Svcs, handle);
+    if (Stream->DP_Interface->waitForCompletion(&Svcs, handle) != 1)
+    {
+        CP_verbose(Stream, "Data plane read failed\n");
+        return SstFatalError;
+    }
     return SstSuccess;
 }
 
@@ -1,6 +1,8 @@
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <sys/stat.h>
 
 #include <atl.h>
@@ -11,9 +13,115 @@
 
 #include "cp_internal.h"
 
+/*
+ * Trims leading and trailing white space of Str in place
+ */
+static char *trimSpace(char *Str)
+{
+    char *End;
+    while (isspace((unsigned char)*Str))
+    {
+        Str++;
+    }
+    End = Str + strlen(Str);
+    while (End > Str && isspace((unsigned char)End[-1]))
+    {
+        End--;
+    }
+    *End = 0;
+    return Str;
+}
+
+/*
+ * Params is a list of "Key=Value" pairs separated by commas, or NULL.
+ * Keys are case insensitive, unknown keys are ignored.
+ */
 void CP_parseParams(SstStream Stream, const char *Params)
 {
+    char *Copy, *Pair, *Save;
+
     Stream->WaitForFirstReader = 1;
+    Stream->DataTransport = NULL;
+    Stream->QueueLimit = 0;
+    Stream->QueueFullPolicy = SstQueueFullBlock;
+    Stream->MarshalMethod = SstMarshalFFS;
+
+    if (Params != NULL)
+    {
+        Copy = strdup(Params);
+        for (Pair = strtok_r(Copy, ",", &Save); Pair != NULL;
+             Pair = strtok_r(NULL, ",", &Save))
+        {
+            char *Key = Pair;
+            char *Value = strchr(Pair, '=');
+            if (Value == NULL)
+            {
+                continue;
+            }
+            *Value++ = 0;
+            Key = trimSpace(Key);
+            Value = trimSpace(Value);
+
+            if (strcasecmp(Key, "DataTransport") == 0)
+            {
+                free(Stream->DataTransport);
+                Stream->DataTransport = strdup(Value);
+            }
+            else if (strcasecmp(Key, "QueueLimit") == 0)
+            {
+                Stream->QueueLimit = atoi(Value);
+                if (Stream->QueueLimit < 0)
+                {
+                    Stream->QueueLimit = 0;
+                }
+            }
+            else if (strcasecmp(Key, "QueueFullPolicy") == 0)
+            {
+                if (strcasecmp(Value, "Block") == 0)
+                {
+                    Stream->QueueFullPolicy = SstQueueFullBlock;
+                }
+                else if (strcasecmp(Value, "Discard") == 0)
+                {
+                    Stream->QueueFullPolicy = SstQueueFullDiscard;
+                }
+                else if (strcasecmp(Value, "DiscardOldest") == 0)
+                {
+                    /*
+                     * queued timesteps have already been announced to the
+                     * readers and can't be taken back
+                     */
+                    fprintf(stderr, "QueueFullPolicy DiscardOldest is not "
+                                    "supported, using Discard\n");
+                    Stream->QueueFullPolicy = SstQueueFullDiscard;
+                }
+                else
+                {
+                    fprintf(stderr, "Unknown QueueFullPolicy %s, using "
+                                    "Block\n",
+                            Value);
+                    Stream->QueueFullPolicy = SstQueueFullBlock;
+                }
+            }
+            else if (strcasecmp(Key, "MarshalMethod") == 0)
+            {
+                if (strcasecmp(Value, "BP") == 0)
+                {
+                    Stream->MarshalMethod = SstMarshalBP;
+                }
+                else
+                {
+                    Stream->MarshalMethod = SstMarshalFFS;
+                }
+            }
+        }
+        free(Copy);
+    }
+
+    if (Stream->DataTransport == NULL)
+    {
+        Stream->DataTransport = strdup("dummy");
+    }
 }
 
 static FMField CP_ReaderInitList[] = {
@@ -32,6 +140,8 @@ static FMField CP_WriterInitList[] = {
      FMOffset(CP_WriterInitInfo, ContactInfo)},
     {"WriterID", "integer", sizeof(void *),
      FMOffset(CP_WriterInitInfo, WriterID)},
+    {"MarshalMethod", "integer", sizeof(int),
+     FMOffset(CP_WriterInitInfo, MarshalMethod)},
     {NULL, NULL, 0, 0}};
 
 static FMStructDescRec CP_WriterInitStructs[] = {
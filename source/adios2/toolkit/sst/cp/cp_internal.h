@@ -62,6 +62,12 @@ typedef struct _TimestepMetadataList
     struct _TimestepMetadataList *Next;
 } * TSMetadataList;
 
+enum QueueFullPolicy
+{
+    SstQueueFullBlock = 0,
+    SstQueueFullDiscard
+};
+
 enum StreamRole
 {
     ReaderRole,
@@ -88,6 +94,10 @@ struct _SstStream
 
     /* params */
     int WaitForFirstReader;
+    char *DataTransport;
+    int QueueLimit; /* 0: unbounded */
+    enum QueueFullPolicy QueueFullPolicy; /* Block waits for a release */
+    SstMarshalMethod MarshalMethod;       /* on readers, the writer's */
 
     /* state */
     int Verbose;
@@ -111,6 +121,8 @@ struct _SstStream
     CPTimestepList QueuedTimesteps;
     int QueuedTimestepCount;
     int LastProvidedTimestep;
+    /* formats of discarded timesteps, sent with the next provided one */
+    struct FFSFormatBlock *PendingFormats;
 
     /* rendezvous condition */
     int FirstReaderCondition;
@@ -224,6 +236,7 @@ typedef struct _CP_WriterInitInfo
 {
     char *ContactInfo;
     void *WriterID;
+    int MarshalMethod;
 } * CP_WriterInitInfo;
 
 /*
@@ -722,9 +722,10 @@ static void DecodeAndPrepareData(SstStream Stream, int Writer)
     }
 }
 
-static void WaitForReadRequests(SstStream Stream)
+static SstStatusValue WaitForReadRequests(SstStream Stream)
 {
     struct FFSReaderMarshalBase *Info = Stream->ReaderMarshalData;
+    SstStatusValue Return = SstSuccess;
 
     for (int i = 0; i < Stream->WriterCohortSize; i++)
     {
@@ -739,10 +740,13 @@ static void WaitForReadRequests(SstStream Stream)
             }
             else
             {
-                /* handle errors here */
+                /* keep waiting on the other handles so none are leaked */
+                Info->WriterInfo[i].Status = Empty;
+                Return = Result;
             }
         }
     }
+    return Return;
 }
 
 static void MapLocalToGlobalIndex(size_t Dims, const size_t *LocalIndex,
@@ -904,17 +908,23 @@ static void FillReadRequests(SstStream Stream, FFSArrayRequest Reqs)
     }
 }
 
-extern void SstPerformGets(SstStream Stream)
+extern SstStatusValue SstPerformGets(SstStream Stream)
 {
     struct FFSReaderMarshalBase *Info = Stream->ReaderMarshalData;
+    SstStatusValue Result;
 
     IssueReadRequests(Stream, Info->PendingVarRequests);
 
-    WaitForReadRequests(Stream);
+    Result = WaitForReadRequests(Stream);
 
-    FillReadRequests(Stream, Info->PendingVarRequests);
+    if (Result == SstSuccess)
+    {
+        FillReadRequests(Stream, Info->PendingVarRequests);
+    }
 
     ClearReadRequests(Stream);
+
+    return Result;
 }
 
 extern void SstWriterEndStep(SstStream Stream)
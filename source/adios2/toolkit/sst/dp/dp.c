@@ -9,6 +9,7 @@
 #include "dp_interface.h"
 
 extern CP_DP_Interface LoadDummyDP();
+extern CP_DP_Interface LoadShmDP();
 
 CP_DP_Interface LoadDP(char *dp_name)
 {
@@ -16,6 +17,10 @@ CP_DP_Interface LoadDP(char *dp_name)
     {
         return LoadDummyDP();
     }
+    else if (strcmp(dp_name, "shm") == 0)
+    {
+        return LoadShmDP();
+    }
     else
     {
         fprintf(stderr, "Unknown DP interface %s, load failed\n", dp_name);
@@ -461,7 +461,7 @@ static void *DummyReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
     return ret;
 }
 
-static void DummyWaitForCompletion(CP_Services Svcs, void *Handle_v)
+static int DummyWaitForCompletion(CP_Services Svcs, void *Handle_v)
 {
     DummyCompletionHandle Handle = (DummyCompletionHandle)Handle_v;
     Svcs->verbose(
@@ -479,6 +479,7 @@ static void DummyWaitForCompletion(CP_Services Svcs, void *Handle_v)
         "Remote memory read to rank %d with condition %d has completed\n",
         Handle->Rank, Handle->CMcondition);
     free(Handle);
+    return 1;
 }
 
 static void DummyProvideTimestep(CP_Services Svcs, DP_WS_Stream Stream_v,
@@ -0,0 +1,554 @@
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atl.h>
+#include <evpath.h>
+
+#include "sst_data.h"
+
+#include "dp_interface.h"
+
+/*
+ *  The "shm" data plane is for readers that run on the same host as the
+ *  writers, for example analysis ranks sharing nodes with a simulation.
+ *
+ *  In ProvideTimestep the writer publishes the data block of the timestep
+ *  in a POSIX shared memory segment whose name is derived from the writer
+ *  process ID, a number identifying the stream within that process and the
+ *  timestep.  ReadRemoteMemory on the reader maps the
+ *  segment of the writer rank (once per timestep) and memcpy's the
+ *  requested range straight into the reader buffer, so no request or reply
+ *  messages are exchanged.  The read is complete when ReadRemoteMemory
+ *  returns.  ReleaseTimestep unmaps and unlinks the segment on the writer,
+ *  existing reader mappings stay valid until they are unmapped.
+ *
+ *  The contact information exchanged at init time carries the host name
+ *  and the process ID of each rank, and the stream number of each writer
+ *  rank.  If the writer fails to publish a timestep no segment exists and
+ *  the reads of that timestep fail.  A read from a writer on a different
+ *  host fails, those streams must use the "dummy" data plane.
+ */
+
+#define SHM_NAME_SIZE 64
+
+typedef struct _ShmMapping
+{
+    long Timestep;
+    char *Address;
+    size_t Size;
+} * ShmMapping;
+
+typedef struct _Shm_RS_Stream
+{
+    void *CP_Stream;
+    int Rank;
+    char *HostName;
+
+    /* writer info */
+    int WriterCohortSize;
+    CP_PeerCohort PeerCohort;
+    struct _ShmWriterContactInfo *WriterContactInfo;
+
+    /* segment of the last timestep read from each writer rank */
+    struct _ShmMapping *Mappings;
+} * Shm_RS_Stream;
+
+typedef struct _Shm_WSR_Stream
+{
+    struct _Shm_WS_Stream *WS_Stream;
+    CP_PeerCohort PeerCohort;
+    int ReaderCohortSize;
+} * Shm_WSR_Stream;
+
+typedef struct _TimestepEntry
+{
+    long Timestep;
+    char *Address;
+    size_t Size;
+    struct _TimestepEntry *Next;
+
+} * TimestepList;
+
+typedef struct _Shm_WS_Stream
+{
+    void *CP_Stream;
+    int Rank;
+    int ProcessID;
+    int StreamID;
+    char *HostName;
+
+    TimestepList Timesteps;
+
+    int ReaderCount;
+    Shm_WSR_Stream *Readers;
+} * Shm_WS_Stream;
+
+typedef struct _ShmReaderContactInfo
+{
+    char *HostName;
+    void *RS_Stream;
+} * ShmReaderContactInfo;
+
+typedef struct _ShmWriterContactInfo
+{
+    char *HostName;
+    int ProcessID;
+    int StreamID;
+    void *WS_Stream;
+} * ShmWriterContactInfo;
+
+typedef struct _ShmCompletionHandle
+{
+    void *CPStream;
+    int Rank;
+    int Failed;
+} * ShmCompletionHandle;
+
+static char *ShmHostName()
+{
+    char HostName[256];
+    if (gethostname(HostName, sizeof(HostName)) != 0)
+    {
+        strcpy(HostName, "unknown");
+    }
+    HostName[sizeof(HostName) - 1] = 0;
+    return strdup(HostName);
+}
+
+/* number of the next writer stream opened in this process */
+static int ShmNextStreamID = 0;
+
+static void ShmSegmentName(char *Name, int ProcessID, int StreamID,
+                           long Timestep)
+{
+    snprintf(Name, SHM_NAME_SIZE, "/adios2_sst_%d_%d_%ld", ProcessID,
+             StreamID, Timestep);
+}
+
+static DP_RS_Stream ShmInitReader(CP_Services Svcs, void *CP_Stream,
+                                  void **ReaderContactInfoPtr)
+{
+    Shm_RS_Stream Stream = malloc(sizeof(struct _Shm_RS_Stream));
+    ShmReaderContactInfo Contact = malloc(sizeof(struct _ShmReaderContactInfo));
+    MPI_Comm comm = Svcs->getMPIComm(CP_Stream);
+
+    memset(Stream, 0, sizeof(*Stream));
+    memset(Contact, 0, sizeof(*Contact));
+
+    /*
+     * save the CP_stream value of later use
+     */
+    Stream->CP_Stream = CP_Stream;
+
+    MPI_Comm_rank(comm, &Stream->Rank);
+    Stream->HostName = ShmHostName();
+
+    Contact->HostName = strdup(Stream->HostName);
+    Contact->RS_Stream = Stream;
+
+    *ReaderContactInfoPtr = Contact;
+
+    return Stream;
+}
+
+static DP_WS_Stream ShmInitWriter(CP_Services Svcs, void *CP_Stream)
+{
+    Shm_WS_Stream Stream = malloc(sizeof(struct _Shm_WS_Stream));
+    MPI_Comm comm = Svcs->getMPIComm(CP_Stream);
+
+    memset(Stream, 0, sizeof(struct _Shm_WS_Stream));
+
+    MPI_Comm_rank(comm, &Stream->Rank);
+    Stream->ProcessID = (int)getpid();
+    Stream->StreamID = ShmNextStreamID++;
+    Stream->HostName = ShmHostName();
+
+    /*
+     * save the CP_stream value of later use
+     */
+    Stream->CP_Stream = CP_Stream;
+
+    return (void *)Stream;
+}
+
+static DP_WSR_Stream ShmInitWriterPerReader(CP_Services Svcs,
+                                            DP_WS_Stream WS_Stream_v,
+                                            int readerCohortSize,
+                                            CP_PeerCohort PeerCohort,
+                                            void **providedReaderInfo_v,
+                                            void **WriterContactInfoPtr)
+{
+    Shm_WS_Stream WS_Stream = (Shm_WS_Stream)WS_Stream_v;
+    Shm_WSR_Stream WSR_Stream = malloc(sizeof(*WSR_Stream));
+    ShmWriterContactInfo ContactInfo;
+    ShmReaderContactInfo *providedReaderInfo =
+        (ShmReaderContactInfo *)providedReaderInfo_v;
+
+    WSR_Stream->WS_Stream = WS_Stream; /* pointer to writer struct */
+    WSR_Stream->PeerCohort = PeerCohort;
+    WSR_Stream->ReaderCohortSize = readerCohortSize;
+
+    for (int i = 0; i < readerCohortSize; i++)
+    {
+        if (strcmp(providedReaderInfo[i]->HostName, WS_Stream->HostName) != 0)
+        {
+            fprintf(stderr, "Shm DP: reader rank %d on host %s can't read "
+                            "shared memory of writer rank %d on host %s\n",
+                    i, providedReaderInfo[i]->HostName, WS_Stream->Rank,
+                    WS_Stream->HostName);
+        }
+    }
+
+    /*
+     * add this writer-side reader-specific stream to the parent writer stream
+     * structure
+     */
+    WS_Stream->Readers = realloc(
+        WS_Stream->Readers, sizeof(*WSR_Stream) * (WS_Stream->ReaderCount + 1));
+    WS_Stream->Readers[WS_Stream->ReaderCount] = WSR_Stream;
+    WS_Stream->ReaderCount++;
+
+    ContactInfo = malloc(sizeof(struct _ShmWriterContactInfo));
+    memset(ContactInfo, 0, sizeof(struct _ShmWriterContactInfo));
+    ContactInfo->HostName = strdup(WS_Stream->HostName);
+    ContactInfo->ProcessID = WS_Stream->ProcessID;
+    ContactInfo->StreamID = WS_Stream->StreamID;
+    ContactInfo->WS_Stream = WSR_Stream;
+    *WriterContactInfoPtr = ContactInfo;
+
+    return WSR_Stream;
+}
+
+static void ShmProvideWriterDataToReader(CP_Services Svcs,
+                                         DP_RS_Stream RS_Stream_v,
+                                         int writerCohortSize,
+                                         CP_PeerCohort PeerCohort,
+                                         void **providedWriterInfo_v)
+{
+    Shm_RS_Stream RS_Stream = (Shm_RS_Stream)RS_Stream_v;
+    ShmWriterContactInfo *providedWriterInfo =
+        (ShmWriterContactInfo *)providedWriterInfo_v;
+
+    RS_Stream->PeerCohort = PeerCohort;
+    RS_Stream->WriterCohortSize = writerCohortSize;
+
+    /*
+     * make a copy of writer contact information (original will not be
+     * preserved)
+     */
+    RS_Stream->WriterContactInfo =
+        malloc(sizeof(struct _ShmWriterContactInfo) * writerCohortSize);
+    RS_Stream->Mappings = malloc(sizeof(struct _ShmMapping) * writerCohortSize);
+    for (int i = 0; i < writerCohortSize; i++)
+    {
+        RS_Stream->WriterContactInfo[i].HostName =
+            strdup(providedWriterInfo[i]->HostName);
+        RS_Stream->WriterContactInfo[i].ProcessID =
+            providedWriterInfo[i]->ProcessID;
+        RS_Stream->WriterContactInfo[i].StreamID =
+            providedWriterInfo[i]->StreamID;
+        RS_Stream->WriterContactInfo[i].WS_Stream =
+            providedWriterInfo[i]->WS_Stream;
+        RS_Stream->Mappings[i].Timestep = -1;
+        RS_Stream->Mappings[i].Address = NULL;
+        RS_Stream->Mappings[i].Size = 0;
+        Svcs->verbose(RS_Stream->CP_Stream,
+                      "Received contact info host %s, process %d, stream %d "
+                      "for WSR Rank %d\n",
+                      RS_Stream->WriterContactInfo[i].HostName,
+                      RS_Stream->WriterContactInfo[i].ProcessID,
+                      RS_Stream->WriterContactInfo[i].StreamID, i);
+    }
+}
+
+/*
+ * Maps the segment of writer rank Rank for Timestep, the mapping of the
+ * previous timestep read from that rank is released first.  Returns NULL
+ * on failure.
+ */
+static ShmMapping ShmMapTimestep(CP_Services Svcs, Shm_RS_Stream Stream,
+                                 int Rank, long Timestep)
+{
+    ShmMapping Mapping = &Stream->Mappings[Rank];
+    ShmWriterContactInfo Writer = &Stream->WriterContactInfo[Rank];
+    char Name[SHM_NAME_SIZE];
+    struct stat Status;
+    int FD;
+
+    if (Mapping->Timestep == Timestep)
+    {
+        return Mapping;
+    }
+
+    if (Mapping->Address != NULL)
+    {
+        munmap(Mapping->Address, Mapping->Size);
+        Mapping->Address = NULL;
+        Mapping->Size = 0;
+        Mapping->Timestep = -1;
+    }
+
+    if (strcmp(Writer->HostName, Stream->HostName) != 0)
+    {
+        fprintf(stderr, "Shm DP: writer rank %d is on host %s, not on %s\n",
+                Rank, Writer->HostName, Stream->HostName);
+        return NULL;
+    }
+
+    ShmSegmentName(Name, Writer->ProcessID, Writer->StreamID, Timestep);
+    FD = shm_open(Name, O_RDONLY, 0);
+    if (FD == -1)
+    {
+        fprintf(stderr, "Shm DP: failed to open segment %s, %s\n", Name,
+                strerror(errno));
+        return NULL;
+    }
+
+    if (fstat(FD, &Status) == -1)
+    {
+        fprintf(stderr, "Shm DP: failed to stat segment %s, %s\n", Name,
+                strerror(errno));
+        close(FD);
+        return NULL;
+    }
+
+    Mapping->Size = (size_t)Status.st_size;
+    if (Mapping->Size > 0)
+    {
+        void *Address =
+            mmap(NULL, Mapping->Size, PROT_READ, MAP_SHARED, FD, 0);
+        if (Address == MAP_FAILED)
+        {
+            fprintf(stderr, "Shm DP: failed to map segment %s, %s\n", Name,
+                    strerror(errno));
+            close(FD);
+            Mapping->Size = 0;
+            return NULL;
+        }
+        Mapping->Address = Address;
+    }
+    /* the mapping stays valid after close */
+    close(FD);
+
+    Mapping->Timestep = Timestep;
+    Svcs->verbose(Stream->CP_Stream,
+                  "Mapped segment %s of %zu bytes for Timestep %ld\n", Name,
+                  Mapping->Size, Timestep);
+    return Mapping;
+}
+
+static void *ShmReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
+                                 int Rank, long Timestep, size_t Offset,
+                                 size_t Length, void *Buffer,
+                                 void *DP_TimestepInfo)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)
+        Stream_v; /* DP_RS_Stream is the return from InitReader */
+    ShmCompletionHandle ret = malloc(sizeof(struct _ShmCompletionHandle));
+    ShmMapping Mapping;
+
+    ret->CPStream = Stream->CP_Stream;
+    ret->Rank = Rank;
+    ret->Failed = 0;
+
+    Svcs->verbose(Stream->CP_Stream,
+                  "Adios requesting to read shared memory for Timestep %ld "
+                  "from Rank %d, offset %zu, length %zu\n",
+                  Timestep, Rank, Offset, Length);
+
+    Mapping = ShmMapTimestep(Svcs, Stream, Rank, Timestep);
+    if (Mapping == NULL || Offset + Length > Mapping->Size)
+    {
+        fprintf(stderr, "Shm DP: failed to read Timestep %ld from writer "
+                        "rank %d, offset %zu, length %zu\n",
+                Timestep, Rank, Offset, Length);
+        ret->Failed = 1;
+        return ret;
+    }
+
+    /*
+     * the data is read when this returns, there is nothing to wait for
+     */
+    memcpy(Buffer, Mapping->Address + Offset, Length);
+    return ret;
+}
+
+static int ShmWaitForCompletion(CP_Services Svcs, void *Handle_v)
+{
+    ShmCompletionHandle Handle = (ShmCompletionHandle)Handle_v;
+    int Ret = !Handle->Failed;
+    Svcs->verbose(Handle->CPStream,
+                  "Shared memory read to rank %d has completed%s\n",
+                  Handle->Rank, Handle->Failed ? " with errors" : "");
+    free(Handle);
+    return Ret;
+}
+
+static void ShmProvideTimestep(CP_Services Svcs, DP_WS_Stream Stream_v,
+                               struct _SstData *Data,
+                               struct _SstData *LocalMetadata, long Timestep,
+                               void **TimestepInfoPtr)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)Stream_v;
+    TimestepList Entry = malloc(sizeof(struct _TimestepEntry));
+    char Name[SHM_NAME_SIZE];
+    int FD;
+
+    memset(Entry, 0, sizeof(*Entry));
+    Entry->Timestep = Timestep;
+    Entry->Size = Data->DataSize;
+
+    /* the entry is kept on failure so that the release finds it */
+    Entry->Next = Stream->Timesteps;
+    Stream->Timesteps = Entry;
+
+    /* readers derive the segment name, no per timestep info */
+    *TimestepInfoPtr = NULL;
+
+    ShmSegmentName(Name, Stream->ProcessID, Stream->StreamID, Timestep);
+    FD = shm_open(Name, O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (FD == -1)
+    {
+        fprintf(stderr, "Shm DP: failed to create segment %s, %s\n", Name,
+                strerror(errno));
+        return;
+    }
+
+    if (ftruncate(FD, (off_t)Entry->Size) == -1)
+    {
+        fprintf(stderr, "Shm DP: failed to size segment %s to %zu bytes, "
+                        "%s\n",
+                Name, Entry->Size, strerror(errno));
+        close(FD);
+        shm_unlink(Name);
+        return;
+    }
+
+    if (Entry->Size > 0)
+    {
+        void *Address = mmap(NULL, Entry->Size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, FD, 0);
+        if (Address == MAP_FAILED)
+        {
+            /* readers must not find a segment without the data */
+            fprintf(stderr, "Shm DP: failed to map segment %s, %s\n", Name,
+                    strerror(errno));
+            close(FD);
+            shm_unlink(Name);
+            return;
+        }
+        Entry->Address = Address;
+        memcpy(Entry->Address, Data->block, Entry->Size);
+    }
+    close(FD);
+
+    Svcs->verbose(Stream->CP_Stream,
+                  "Published Timestep %ld in segment %s, %zu bytes\n",
+                  Timestep, Name, Entry->Size);
+}
+
+static void ShmFreeTimestep(Shm_WS_Stream Stream, TimestepList Entry)
+{
+    char Name[SHM_NAME_SIZE];
+
+    if (Entry->Address != NULL)
+    {
+        munmap(Entry->Address, Entry->Size);
+    }
+    /* a segment that failed to publish is already gone */
+    ShmSegmentName(Name, Stream->ProcessID, Stream->StreamID,
+                   Entry->Timestep);
+    shm_unlink(Name);
+    free(Entry);
+}
+
+static void ShmReleaseTimestep(CP_Services Svcs, DP_WS_Stream Stream_v,
+                               long Timestep)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)Stream_v;
+    TimestepList List = Stream->Timesteps;
+
+    Svcs->verbose(Stream->CP_Stream, "Releasing timestep %ld\n", Timestep);
+    if (Stream->Timesteps->Timestep == Timestep)
+    {
+        Stream->Timesteps = List->Next;
+        ShmFreeTimestep(Stream, List);
+    }
+    else
+    {
+        TimestepList last = List;
+        List = List->Next;
+        while (List != NULL)
+        {
+            if (List->Timestep == Timestep)
+            {
+                last->Next = List->Next;
+                ShmFreeTimestep(Stream, List);
+                return;
+            }
+            last = List;
+            List = List->Next;
+        }
+        /*
+         * Shouldn't ever get here because we should never release a
+         * timestep that we don't have.
+         */
+        fprintf(stderr, "Failed to release Timestep %ld, not found\n",
+                Timestep);
+        assert(0);
+    }
+}
+
+static FMField ShmReaderContactList[] = {
+    {"HostName", "string", sizeof(char *),
+     FMOffset(ShmReaderContactInfo, HostName)},
+    {"reader_ID", "integer", sizeof(void *),
+     FMOffset(ShmReaderContactInfo, RS_Stream)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmReaderContactStructs[] = {
+    {"ShmReaderContactInfo", ShmReaderContactList,
+     sizeof(struct _ShmReaderContactInfo), NULL},
+    {NULL, NULL, 0, NULL}};
+
+static FMField ShmWriterContactList[] = {
+    {"HostName", "string", sizeof(char *),
+     FMOffset(ShmWriterContactInfo, HostName)},
+    {"ProcessID", "integer", sizeof(int),
+     FMOffset(ShmWriterContactInfo, ProcessID)},
+    {"StreamID", "integer", sizeof(int),
+     FMOffset(ShmWriterContactInfo, StreamID)},
+    {"writer_ID", "integer", sizeof(void *),
+     FMOffset(ShmWriterContactInfo, WS_Stream)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmWriterContactStructs[] = {
+    {"ShmWriterContactInfo", ShmWriterContactList,
+     sizeof(struct _ShmWriterContactInfo), NULL},
+    {NULL, NULL, 0, NULL}};
+
+static struct _CP_DP_Interface shmDPInterface;
+
+extern CP_DP_Interface LoadShmDP()
+{
+    memset(&shmDPInterface, 0, sizeof(shmDPInterface));
+    shmDPInterface.ReaderContactFormats = ShmReaderContactStructs;
+    shmDPInterface.WriterContactFormats = ShmWriterContactStructs;
+    shmDPInterface.TimestepInfoFormats = NULL;
+    shmDPInterface.initReader = ShmInitReader;
+    shmDPInterface.initWriter = ShmInitWriter;
+    shmDPInterface.initWriterPerReader = ShmInitWriterPerReader;
+    shmDPInterface.provideWriterDataToReader = ShmProvideWriterDataToReader;
+    shmDPInterface.readRemoteMemory = ShmReadRemoteMemory;
+    shmDPInterface.waitForCompletion = ShmWaitForCompletion;
+    shmDPInterface.provideTimestep = ShmProvideTimestep;
+    shmDPInterface.releaseTimestep = ShmReleaseTimestep;
+    return &shmDPInterface;
+}
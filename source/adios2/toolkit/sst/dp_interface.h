@@ -152,9 +152,11 @@ typedef DP_CompletionHandle (*CP_DP_ReadRemoteMemoryFunc)(
  * CP_DP_WaitForCompletionFunc is the type of a dataplane function that
  * suspends the execution of the current thread until the asynchronous
  * CP_DP_ReadRemoteMemory call that returned its `handle` parameter.
+ * It returns 1 if the data was delivered into the buffer and 0 if the read
+ * failed.
  */
-typedef void (*CP_DP_WaitForCompletionFunc)(CP_Services Svcs,
-                                            DP_CompletionHandle Handle);
+typedef int (*CP_DP_WaitForCompletionFunc)(CP_Services Svcs,
+                                           DP_CompletionHandle Handle);
 
 /*!
  * CP_DP_ProvideTimestepFunc is the type of a dataplane function that
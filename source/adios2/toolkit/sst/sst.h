@@ -29,6 +29,11 @@ typedef struct _SstData *SstData;
 
 typedef enum { SstSuccess, SstEndOfStream, SstFatalError } SstStatusValue;
 
+/*
+ *  How the writer marshals timesteps, FFS in SST or BP above SST
+ */
+typedef enum { SstMarshalFFS, SstMarshalBP } SstMarshalMethod;
+
 /*
  * Struct that represents statistics tracked by SST
  */
@@ -38,6 +43,8 @@ typedef struct _SstStats
     double CloseTimeSecs;
     double ValidTimeSecs;
     size_t BytesTransferred;
+    double QueueBlockedTimeSecs;
+    size_t DiscardedTimesteps;
 } * SstStats;
 
 /*
@@ -45,8 +52,17 @@ typedef struct _SstStats
  */
 extern SstStream SstWriterOpen(const char *filename, const char *params,
                                MPI_Comm comm);
-extern void SstProvideTimestep(SstStream s, SstMetadata local_metadata,
-                               SstData data, long timestep);
+
+/*
+ *  For marshaling done above SST (e.g. BP).  local_metadata and data are
+ *  malloc'd records pointing to this rank's blocks for timestep, their
+ *  blocks must stay valid until free_data(free_client_data) is called, once
+ *  the timestep is released or discarded.
+ */
+typedef void (*SstFreeFunc)(void *client_data);
+extern void SstProvideTimestep(SstStream s, SstData local_metadata,
+                               SstData data, long timestep,
+                               SstFreeFunc free_data, void *free_client_data);
 extern void SstWriterClose(SstStream stream);
 
 /*
@@ -63,6 +79,7 @@ extern void SstReleaseStep(SstStream stream);
 extern SstStatusValue SstAdvanceStep(SstStream stream, int mode,
                                      const float timeout_sec);
 extern void SstReaderClose(SstStream stream);
+extern SstMarshalMethod SstReaderMarshalMethod(SstStream stream);
 
 typedef void *(*VarSetupUpcallFunc)(void *Reader, const char *Name,
                                     const char *Type, void *Data);
@@ -82,7 +99,7 @@ extern void SstGetDeferred(SstStream Stream, void *Variable, const char *Name,
                            size_t DimCount, const unsigned long *Start,
                            const unsigned long *Count, void *Data);
 
-extern void SstPerformGets(SstStream Stream);
+extern SstStatusValue SstPerformGets(SstStream Stream);
 
 extern int SstWriterBeginStep(SstStream Stream, int mode,
                               const float timeout_sec);
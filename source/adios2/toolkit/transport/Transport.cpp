@@ -30,11 +30,29 @@ void Transport::IWrite(const char *buffer, size_t size, Status &status,
     throw std::invalid_argument("ERROR: this class doesn't implement IWrite\n");
 }
 
+void Transport::WriteV(const IOVec *iov, const size_t iovCount, size_t start)
+{
+    for (size_t i = 0; i < iovCount; ++i)
+    {
+        Write(iov[i].Base, iov[i].Length, start);
+        if (start != MaxSizeT)
+        {
+            start += iov[i].Length;
+        }
+    }
+}
+
 void Transport::IRead(char *buffer, size_t size, Status &status, size_t start)
 {
     throw std::invalid_argument("ERROR: this class doesn't implement IRead\n");
 }
 
+const char *Transport::GetData(const size_t /*start*/,
+                               const size_t /*size*/) const
+{
+    return nullptr;
+}
+
 void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit)
 {
     m_Profiler.IsActive = true;
@@ -42,19 +60,14 @@ void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit)
     m_Profiler.Timers.emplace(std::make_pair(
         "open", profiling::Timer("open", TimeUnit::Microseconds, m_DebugMode)));
 
-    if (openMode == Mode::Write)
+    // Append writes at the end of existing files
+    if (openMode == Mode::Write || openMode == Mode::Append)
     {
         m_Profiler.Timers.emplace(
             "write", profiling::Timer("write", timeUnit, m_DebugMode));
 
         m_Profiler.Bytes.emplace("write", 0);
     }
-    else if (openMode == Mode::Append)
-    {
-        m_Profiler.Timers.emplace(
-            "append", profiling::Timer("append", timeUnit, m_DebugMode));
-        m_Profiler.Bytes.emplace("append", 0);
-    }
     else if (openMode == Mode::Read)
     {
         m_Profiler.Timers.emplace(
@@ -38,6 +38,13 @@ public:
     int m_SizeMPI = 1;     ///< from MPI_Comm_Size
     profiling::IOChrono m_Profiler; ///< profiles Open, Write/Read, Close
 
+    /** Contiguous piece of memory in a gather write */
+    struct IOVec
+    {
+        const char *Base;
+        size_t Length;
+    };
+
     struct Status
     {
         size_t Bytes;
@@ -87,6 +94,17 @@ public:
     virtual void IWrite(const char *buffer, size_t size, Status &status,
                         size_t start = MaxSizeT);
 
+    /**
+     * Gather write, pieces land contiguously in the order given, as if they
+     * were a single buffer passed to Write. Default calls Write per piece.
+     * @param iov pieces of memory to be written
+     * @param iovCount number of pieces in iov
+     * @param start starting position for writing, if not passed then start
+     * at current stream position
+     */
+    virtual void WriteV(const IOVec *iov, const size_t iovCount,
+                        size_t start = MaxSizeT);
+
     /**
      * Reads from transport "size" bytes from a certain position. Note that size
      * and position and non-const due to the nature of underlying transport
@@ -102,6 +120,15 @@ public:
     virtual void IRead(char *buffer, size_t size, Status &status,
                        size_t start = MaxSizeT);
 
+    /**
+     * Gives direct access to transport contents without copying, only for
+     * transports holding them in memory (e.g. mapped files)
+     * @param start position of the first byte
+     * @param size number of bytes to be accessed from start
+     * @return pointer to contents at start, nullptr if not supported
+     */
+    virtual const char *GetData(const size_t start, const size_t size) const;
+
     /**
      * Returns the size of current data in transport
      * @return size as size_t
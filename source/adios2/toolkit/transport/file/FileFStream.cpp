@@ -41,8 +41,9 @@ void FileFStream::Open(const std::string &name, const Mode openMode)
 
     case (Mode::Append):
         ProfilerStart("open");
+        MkDir(m_Name);
         m_FileStream.open(name, std::fstream::in | std::fstream::out |
-                                    std::fstream::binary);
+                                    std::fstream::app | std::fstream::binary);
         ProfilerStop("open");
         break;
 
@@ -0,0 +1,213 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileMMap.cpp read-only file transport using POSIX mmap
+ *
+ *  Created on: Jan 15, 2018
+ */
+#include "FileMMap.h"
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // open, fstat
+#include <sys/types.h> // open
+#include <unistd.h>    // close
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <cstring> //std::memcpy
+#include <ios>     //std::ios_base::failure
+/// \endcond
+
+namespace adios2
+{
+namespace transport
+{
+
+FileMMap::FileMMap(MPI_Comm mpiComm, const bool debugMode)
+: Transport("File", "mmap", mpiComm, debugMode)
+{
+}
+
+FileMMap::~FileMMap()
+{
+    if (m_IsOpen)
+    {
+        Unmap();
+        close(m_FileDescriptor);
+    }
+}
+
+void FileMMap::Open(const std::string &name, const Mode openMode)
+{
+    m_Name = name;
+    CheckName();
+    m_OpenMode = openMode;
+
+    if (m_OpenMode != Mode::Read)
+    {
+        throw std::invalid_argument("ERROR: file " + m_Name +
+                                    " can only be opened with Mode::Read "
+                                    "using library mmap, in call to Open\n");
+    }
+
+    ProfilerStart("open");
+    m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
+
+    if (m_FileDescriptor == -1)
+    {
+        ProfilerStop("open");
+        throw std::ios_base::failure(
+            "ERROR: couldn't open file " + m_Name +
+            ", check permissions or path existence, in call to mmap open\n");
+    }
+
+    try
+    {
+        Remap("in call to mmap open");
+    }
+    catch (std::ios_base::failure &)
+    {
+        ProfilerStop("open");
+        close(m_FileDescriptor);
+        throw;
+    }
+    ProfilerStop("open");
+
+    m_Position = 0;
+    m_IsOpen = true;
+}
+
+void FileMMap::Write(const char * /*buffer*/, size_t /*size*/,
+                     size_t /*start*/)
+{
+    throw std::invalid_argument("ERROR: file " + m_Name +
+                                " is mapped read-only, in call to mmap "
+                                "Write\n");
+}
+
+void FileMMap::Read(char *buffer, size_t size, size_t start)
+{
+    if (start == MaxSizeT)
+    {
+        start = m_Position;
+    }
+
+    if (start > m_Size || size > m_Size - start)
+    {
+        // file might have grown since it was mapped, e.g. followed streams
+        Remap("in call to mmap Read");
+    }
+    CheckRange(start, size, "in call to mmap Read");
+
+    ProfilerStart("read");
+    if (size > 0)
+    {
+        std::memcpy(buffer, m_Data + start, size);
+    }
+    ProfilerStop("read");
+
+    m_Position = start + size;
+}
+
+const char *FileMMap::GetData(const size_t start, const size_t size) const
+{
+    if (start > m_Size || size > m_Size - start)
+    {
+        Remap("in call to mmap GetData");
+    }
+    CheckRange(start, size, "in call to mmap GetData");
+    return m_Data + start;
+}
+
+size_t FileMMap::GetSize()
+{
+    Remap("in call to mmap GetSize");
+    return m_Size;
+}
+
+void FileMMap::Flush() {}
+
+void FileMMap::Close()
+{
+    ProfilerStart("close");
+    const int unmapStatus = Unmap();
+    const int status = close(m_FileDescriptor);
+    ProfilerStop("close");
+
+    m_IsOpen = false;
+
+    if (unmapStatus == -1 || status == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't close file " + m_Name +
+                                     ", in call to mmap close\n");
+    }
+}
+
+void FileMMap::Remap(const std::string hint) const
+{
+    struct stat fileStat;
+    if (fstat(m_FileDescriptor, &fileStat) == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't get size of file " +
+                                     m_Name + ", " + hint + "\n");
+    }
+    const size_t size = static_cast<size_t>(fileStat.st_size);
+
+    // mmap rejects zero length mappings, files only grow while mapped
+    if (size <= m_Size)
+    {
+        return;
+    }
+
+    void *data =
+        mmap(nullptr, size, PROT_READ, MAP_SHARED, m_FileDescriptor, 0);
+
+    if (data == MAP_FAILED)
+    {
+        throw std::ios_base::failure("ERROR: couldn't map file " + m_Name +
+                                     ", " + hint + "\n");
+    }
+
+    // pointers from previous GetData calls stay valid until Close
+    if (m_Data != nullptr)
+    {
+        m_RetiredMaps.emplace_back(m_Data, m_Size);
+    }
+    m_Data = static_cast<char *>(data);
+    m_Size = size;
+}
+
+int FileMMap::Unmap() noexcept
+{
+    int status = (m_Data == nullptr) ? 0 : munmap(m_Data, m_Size);
+
+    for (const auto &map : m_RetiredMaps)
+    {
+        if (munmap(map.first, map.second) == -1)
+        {
+            status = -1;
+        }
+    }
+
+    m_RetiredMaps.clear();
+    m_Data = nullptr;
+    m_Size = 0;
+    return status;
+}
+
+void FileMMap::CheckRange(const size_t start, const size_t size,
+                          const std::string hint) const
+{
+    if (start > m_Size || size > m_Size - start)
+    {
+        throw std::ios_base::failure(
+            "ERROR: range [" + std::to_string(start) + ", " +
+            std::to_string(start + size) + ") is out of bounds in file " +
+            m_Name + " of size " + std::to_string(m_Size) + ", " + hint +
+            "\n");
+    }
+}
+
+} // end namespace transport
+} // end namespace adios2
@@ -0,0 +1,99 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileMMap.h read-only file transport mapping the whole file in memory
+ *
+ *  Created on: Jan 15, 2018
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <utility> //std::pair
+#include <vector>
+/// \endcond
+
+#include "adios2/ADIOSConfig.h"
+#include "adios2/toolkit/transport/Transport.h"
+
+namespace adios2
+{
+namespace transport
+{
+
+/**
+ * Read-only file transport using POSIX mmap. The file is mapped at Open so
+ * readers can use its contents in place through GetData. Files that grow
+ * while open (e.g. sub-files of a followed stream) are remapped when a range
+ * past the current mapping is requested.
+ */
+class FileMMap : public Transport
+{
+
+public:
+    FileMMap(MPI_Comm mpiComm, const bool debugMode);
+
+    ~FileMMap();
+
+    /** Only Mode::Read is supported */
+    void Open(const std::string &name, const Mode openMode) final;
+
+    /** Throws, files are mapped read-only */
+    void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    /** Copies from mapped memory, does not change the file state */
+    void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    const char *GetData(const size_t start, const size_t size) const final;
+
+    size_t GetSize() final;
+
+    /** Does nothing, files are read-only */
+    void Flush() final;
+
+    void Close() final;
+
+private:
+    /** POSIX file handle returned by Open */
+    int m_FileDescriptor = -1;
+
+    /** start of the current mapping, nullptr for empty files, updated by
+     * Remap from const GetData */
+    mutable char *m_Data = nullptr;
+
+    /** file size at the last Remap, length of the current mapping */
+    mutable size_t m_Size = 0;
+
+    /** previous mappings (start, length), kept until Close as readers may
+     * still hold pointers from GetData */
+    mutable std::vector<std::pair<char *, size_t>> m_RetiredMaps;
+
+    /** position for Read calls without a start */
+    size_t m_Position = 0;
+
+    /**
+     * Maps the whole file again if it grew since the last mapping
+     * @param hint exception message
+     */
+    void Remap(const std::string hint) const;
+
+    /**
+     * Unmaps the current and retired mappings
+     * @return -1 if any munmap failed, 0 otherwise
+     */
+    int Unmap() noexcept;
+
+    /**
+     * Checks that [start, start + size) is inside the mapped file
+     * @param hint exception message
+     */
+    void CheckRange(const size_t start, const size_t size,
+                    const std::string hint) const;
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_ */
@@ -10,13 +10,18 @@
 #include "FilePOSIX.h"
 
 #include <fcntl.h>     // open
+#include <limits.h>    // IOV_MAX
 #include <stddef.h>    // write output
 #include <sys/stat.h>  // open, fstat
 #include <sys/types.h> // open
+#include <sys/uio.h>   // writev
 #include <unistd.h>    // write, close
 
 /// \cond EXCLUDE_FROM_DOXYGEN
-#include <ios> //std::ios_base::failure
+#include <algorithm> //std::min
+#include <cerrno>    //errno
+#include <ios>       //std::ios_base::failure
+#include <vector>
 /// \endcond
 
 namespace adios2
@@ -56,7 +61,13 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode)
 
     case (Mode::Append):
         ProfilerStart("open");
-        m_FileDescriptor = open(m_Name.c_str(), O_RDWR);
+        MkDir(m_Name);
+        m_FileDescriptor = open(m_Name.c_str(), O_RDWR | O_CREAT, 0777);
+        // writes continue at the end of existing contents
+        if (m_FileDescriptor != -1)
+        {
+            lseek(m_FileDescriptor, 0, SEEK_END);
+        }
         ProfilerStop("open");
         break;
 
@@ -133,6 +144,86 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
     }
 }
 
+void FilePOSIX::WriteV(const IOVec *iov, const size_t iovCount, size_t start)
+{
+    if (start != MaxSizeT)
+    {
+        const auto newPosition = lseek(m_FileDescriptor, start, SEEK_SET);
+
+        if (static_cast<size_t>(newPosition) != start)
+        {
+            throw std::ios_base::failure(
+                "ERROR: couldn't move to start position " +
+                std::to_string(start) + " in file " + m_Name +
+                ", in call to POSIX lseek\n");
+        }
+    }
+
+#ifdef IOV_MAX
+    const size_t maxPieces = static_cast<size_t>(IOV_MAX);
+#else
+    const size_t maxPieces = 1024;
+#endif
+
+    // partial writes advance through the remaining pieces
+    std::vector<struct iovec> pieces;
+    pieces.reserve(std::min(iovCount, maxPieces));
+
+    size_t next = 0;
+    while (next < iovCount || !pieces.empty())
+    {
+        while (next < iovCount && pieces.size() < maxPieces)
+        {
+            if (iov[next].Length > 0)
+            {
+                struct iovec piece;
+                piece.iov_base = const_cast<char *>(iov[next].Base);
+                piece.iov_len = iov[next].Length;
+                pieces.push_back(piece);
+            }
+            ++next;
+        }
+
+        if (pieces.empty())
+        {
+            break;
+        }
+
+        ProfilerStart("write");
+        const auto writtenSize = writev(m_FileDescriptor, pieces.data(),
+                                        static_cast<int>(pieces.size()));
+        ProfilerStop("write");
+
+        if (writtenSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::ios_base::failure("ERROR: couldn't write to file " +
+                                         m_Name +
+                                         ", in call to POSIX writev\n");
+        }
+
+        size_t remainder = static_cast<size_t>(writtenSize);
+        auto itPiece = pieces.begin();
+        while (itPiece != pieces.end() && remainder >= itPiece->iov_len)
+        {
+            remainder -= itPiece->iov_len;
+            ++itPiece;
+        }
+        pieces.erase(pieces.begin(), itPiece);
+
+        if (!pieces.empty())
+        {
+            pieces.front().iov_base =
+                static_cast<char *>(pieces.front().iov_base) + remainder;
+            pieces.front().iov_len -= remainder;
+        }
+    }
+}
+
 void FilePOSIX::Read(char *buffer, size_t size, size_t start)
 {
     auto lf_Read = [&](char *buffer, size_t size) {
@@ -32,6 +32,10 @@ public:
 
     void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
 
+    /** Single writev call per IOV_MAX pieces, no intermediate copy */
+    void WriteV(const IOVec *iov, const size_t iovCount,
+                size_t start = MaxSizeT) final;
+
     void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
 
     size_t GetSize() final;
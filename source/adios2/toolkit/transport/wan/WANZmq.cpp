@@ -19,10 +19,26 @@ namespace transport
 {
 
 WANZmq::WANZmq(const std::string ipAddress, const std::string port,
-               MPI_Comm mpiComm, const bool debugMode)
+               MPI_Comm mpiComm, const bool debugMode,
+               const std::string pattern, const int highWaterMark)
 : Transport("wan", "zmq", mpiComm, debugMode), m_IPAddress(ipAddress),
-  m_Port(port)
+  m_Port(port), m_HighWaterMark(highWaterMark)
 {
+    if (pattern == "pipeline")
+    {
+        m_Pattern = Pattern::Pipeline;
+    }
+    else if (pattern == "pubsub")
+    {
+        m_Pattern = Pattern::PubSub;
+    }
+    else if (pattern != "reqrep")
+    {
+        throw std::invalid_argument(
+            "ERROR: WAN transport Pattern=" + pattern +
+            " must be reqrep, pipeline or pubsub, in call to Open\n");
+    }
+
     m_Context = zmq_ctx_new();
     if (m_Context == nullptr || m_Context == NULL)
     {
@@ -32,6 +48,7 @@ WANZmq::WANZmq(const std::string ipAddress, const std::string port,
     {
         std::cout << "[WANZmq] IP Address " << ipAddress << std::endl;
         std::cout << "[WANZmq] Port " << port << std::endl;
+        std::cout << "[WANZmq] Pattern " << pattern << std::endl;
     }
 }
 
@@ -52,26 +69,37 @@ void WANZmq::Open(const std::string &name, const Mode openMode)
     m_Name = name;
     m_OpenMode = openMode;
 
+    const std::string fullIP("tcp://" + m_IPAddress + ":" + m_Port);
+
     if (m_OpenMode == Mode::Write)
     {
-        if (m_Profiler.IsActive)
+        ProfilerStart("open");
+
+        int err = 0;
+        if (m_Pattern == Pattern::PubSub)
         {
-            m_Profiler.Timers.at("open").Resume();
+            // many readers connect to one publisher
+            m_Socket = zmq_socket(m_Context, ZMQ_PUB);
+            SetHighWaterMark(ZMQ_SNDHWM);
+            err = zmq_bind(m_Socket, fullIP.c_str());
+        }
+        else
+        {
+            m_Socket = zmq_socket(m_Context, (m_Pattern == Pattern::Pipeline)
+                                                 ? ZMQ_PUSH
+                                                 : ZMQ_REQ);
+            SetHighWaterMark(ZMQ_SNDHWM);
+            err = zmq_connect(m_Socket, fullIP.c_str());
         }
 
-        m_Socket = zmq_socket(m_Context, ZMQ_REQ);
-        const std::string fullIP("tcp://" + m_IPAddress + ":" + m_Port);
-        int err = zmq_connect(m_Socket, fullIP.c_str());
         if (err)
         {
-            throw std::runtime_error("ERROR: zmq_connect() failed with " +
+            throw std::runtime_error("ERROR: zmq_connect() or zmq_bind() to " +
+                                     fullIP + " failed with " +
                                      std::to_string(err));
         }
 
-        if (m_Profiler.IsActive)
-        {
-            m_Profiler.Timers.at("open").Pause();
-        }
+        ProfilerStop("open");
         if (m_DebugMode)
         {
             std::cout << "[WANZmq] Open Mode Write" << std::endl;
@@ -93,9 +121,21 @@ void WANZmq::Open(const std::string &name, const Mode openMode)
     else if (m_OpenMode == Mode::Read)
     {
         ProfilerStart("open");
-        m_Socket = zmq_socket(m_Context, ZMQ_REP);
-        const std::string fullIP("tcp://" + m_IPAddress + ":" + m_Port);
-        zmq_bind(m_Socket, fullIP.c_str());
+        if (m_Pattern == Pattern::PubSub)
+        {
+            m_Socket = zmq_socket(m_Context, ZMQ_SUB);
+            SetHighWaterMark(ZMQ_RCVHWM);
+            zmq_setsockopt(m_Socket, ZMQ_SUBSCRIBE, "", 0);
+            zmq_connect(m_Socket, fullIP.c_str());
+        }
+        else
+        {
+            m_Socket = zmq_socket(m_Context, (m_Pattern == Pattern::Pipeline)
+                                                 ? ZMQ_PULL
+                                                 : ZMQ_REP);
+            SetHighWaterMark(ZMQ_RCVHWM);
+            zmq_bind(m_Socket, fullIP.c_str());
+        }
         // TODO need to capture return of zmq_bind function
         ProfilerStop("open");
         if (m_DebugMode)
@@ -121,13 +161,17 @@ void WANZmq::SetBuffer(char *buffer, size_t size) {}
 void WANZmq::Write(const char *buffer, size_t size, size_t start)
 {
     ProfilerStart("write");
+    // pipeline and pubsub only block when the high-water mark is reached
     const int status = zmq_send(m_Socket, buffer, size, 0);
-    char ret[10];
-    zmq_recv(m_Socket, ret, 10, 0);
+    std::string retString("OK");
+    if (m_Pattern == Pattern::ReqRep)
+    {
+        char ret[10];
+        zmq_recv(m_Socket, ret, 10, 0);
+        retString = std::string(ret);
+    }
     ProfilerStop("write");
 
-    const std::string retString(ret);
-
     if (status == -1 || retString != "OK")
     {
         throw std::ios_base::failure("ERROR: couldn't send message " + m_Name +
@@ -135,6 +179,31 @@ void WANZmq::Write(const char *buffer, size_t size, size_t start)
     }
 }
 
+void WANZmq::WriteV(const IOVec *iov, const size_t iovCount, size_t start)
+{
+    ProfilerStart("write");
+    int status = 0;
+    for (size_t i = 0; i < iovCount && status != -1; ++i)
+    {
+        const int flags = (i + 1 < iovCount) ? ZMQ_SNDMORE : 0;
+        status = zmq_send(m_Socket, iov[i].Base, iov[i].Length, flags);
+    }
+    std::string retString("OK");
+    if (m_Pattern == Pattern::ReqRep && status != -1)
+    {
+        char ret[10];
+        zmq_recv(m_Socket, ret, 10, 0);
+        retString = std::string(ret);
+    }
+    ProfilerStop("write");
+
+    if (status == -1 || retString != "OK")
+    {
+        throw std::ios_base::failure("ERROR: couldn't send message " + m_Name +
+                                     ", in call to WANZmq WriteV\n");
+    }
+}
+
 void WANZmq::IWrite(const char *buffer, size_t size, Status &status,
                     size_t start)
 {
@@ -143,13 +212,27 @@ void WANZmq::IWrite(const char *buffer, size_t size, Status &status,
 void WANZmq::Read(char *buffer, size_t size, size_t start)
 {
     zmq_recv(m_Socket, buffer, size, 0);
-    int status = zmq_send(m_Socket, "OK", 4, 0);
+    Acknowledge();
 }
 
 void WANZmq::IRead(char *buffer, size_t size, Status &status, size_t start)
 {
-    int bytes = zmq_recv(m_Socket, buffer, size, ZMQ_DONTWAIT);
-    int ret = zmq_send(m_Socket, "OK", 4, 0);
+    zmq_pollitem_t item;
+    item.socket = m_Socket;
+    item.fd = 0;
+    item.events = ZMQ_POLLIN;
+    item.revents = 0;
+
+    int bytes = -1;
+    if (zmq_poll(&item, 1, m_PollTimeout) > 0)
+    {
+        bytes = zmq_recv(m_Socket, buffer, size, ZMQ_DONTWAIT);
+        if (bytes >= 0)
+        {
+            Acknowledge();
+        }
+    }
+
     if (bytes > 0)
     {
         status.Bytes = bytes;
@@ -180,5 +263,30 @@ void WANZmq::Close()
     }
 }
 
+void WANZmq::SetHighWaterMark(const int option)
+{
+    if (m_Socket != nullptr && m_HighWaterMark > 0)
+    {
+        zmq_setsockopt(m_Socket, option, &m_HighWaterMark,
+                       sizeof(m_HighWaterMark));
+    }
+}
+
+void WANZmq::Acknowledge()
+{
+    if (m_Pattern != Pattern::ReqRep)
+    {
+        return;
+    }
+
+    int more = 0;
+    size_t moreSize = sizeof(more);
+    zmq_getsockopt(m_Socket, ZMQ_RCVMORE, &more, &moreSize);
+    if (!more)
+    {
+        zmq_send(m_Socket, "OK", 4, 0);
+    }
+}
+
 } // end namespace transport
 } // end namespace adios2
@@ -28,9 +28,16 @@ public:
      * @param port
      * @param mpiComm
      * @param debugMode
+     * @param pattern reqrep (default): each Write waits for an ack,
+     * pipeline: PUSH/PULL stream, Write only blocks at the high-water mark,
+     * pubsub: PUB/SUB, one writer fans out to every connected reader,
+     * messages past the high-water mark or sent before a reader connects
+     * are dropped
+     * @param highWaterMark max queued messages per socket, 0: zmq default
      */
     WANZmq(const std::string ipAddress, const std::string port,
-           MPI_Comm mpiComm, const bool debugMode);
+           MPI_Comm mpiComm, const bool debugMode,
+           const std::string pattern = "reqrep", const int highWaterMark = 0);
 
     ~WANZmq();
 
@@ -40,11 +47,20 @@ public:
 
     void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
 
+    /** Sends iov as the frames of a single multipart message */
+    void WriteV(const IOVec *iov, const size_t iovCount,
+                size_t start = MaxSizeT) final;
+
     void IWrite(const char *buffer, size_t size, Status &status,
                 size_t start = MaxSizeT) final;
 
     void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
 
+    /**
+     * Receives the next frame, waits up to m_PollTimeout milliseconds for
+     * one to arrive so callers looping on IRead don't spin. reqrep only
+     * acknowledges after the last frame of a message.
+     */
     void IRead(char *buffer, size_t size, Status &status,
                size_t start = MaxSizeT) final;
 
@@ -58,11 +74,30 @@ private:
     const std::string m_IPAddress;
     std::string m_Port;
 
+    enum class Pattern
+    {
+        ReqRep,
+        Pipeline,
+        PubSub
+    };
+
+    Pattern m_Pattern = Pattern::ReqRep;
+    const int m_HighWaterMark;
+
+    /** milliseconds IRead waits for a frame */
+    const long m_PollTimeout = 100;
+
     /** context handler created by zmq, thread safe */
     void *m_Context = nullptr;
 
     /** socket handler created by zmq */
     void *m_Socket = nullptr;
+
+    /** sets ZMQ_SNDHWM or ZMQ_RCVHWM if m_HighWaterMark > 0 */
+    void SetHighWaterMark(const int option);
+
+    /** reqrep: replies OK once the last frame of a request was received */
+    void Acknowledge();
 };
 
 } // end namespace transport
@@ -18,6 +18,7 @@
 
 /// transports
 #ifndef _WIN32
+#include "adios2/toolkit/transport/file/FileMMap.h"
 #include "adios2/toolkit/transport/file/FilePOSIX.h"
 #endif
 
@@ -157,6 +158,29 @@ void TransportMan::WriteFiles(const char *buffer, const size_t size,
     }
 }
 
+void TransportMan::WriteFilesV(const Transport::IOVec *iov,
+                               const size_t iovCount, const int transportIndex)
+{
+    if (transportIndex == -1)
+    {
+        for (auto &transportPair : m_Transports)
+        {
+            auto &transport = transportPair.second;
+            if (transport->m_Type == "File")
+            {
+                transport->WriteV(iov, iovCount);
+            }
+        }
+    }
+    else
+    {
+        auto itTransport = m_Transports.find(transportIndex);
+        CheckFile(itTransport, ", in call to WriteFilesV with index " +
+                                   std::to_string(transportIndex));
+        itTransport->second->WriteV(iov, iovCount);
+    }
+}
+
 size_t TransportMan::GetFileSize(const size_t transportIndex) const
 {
     auto itTransport = m_Transports.find(transportIndex);
@@ -174,6 +198,15 @@ void TransportMan::ReadFile(char *buffer, const size_t size, const size_t start,
     itTransport->second->Read(buffer, size, start);
 }
 
+const char *TransportMan::GetFileData(const size_t size, const size_t start,
+                                      const size_t transportIndex) const
+{
+    auto itTransport = m_Transports.find(transportIndex);
+    CheckFile(itTransport, ", in call to GetFileData with index " +
+                               std::to_string(transportIndex));
+    return itTransport->second->GetData(start, size);
+}
+
 void TransportMan::CloseFiles(const int transportIndex)
 {
     if (transportIndex == -1)
@@ -201,6 +234,29 @@ void TransportMan::CloseFiles(const int transportIndex)
     }
 }
 
+void TransportMan::FlushFiles(const int transportIndex)
+{
+    if (transportIndex == -1)
+    {
+        for (auto &transportPair : m_Transports)
+        {
+            auto &transport = transportPair.second;
+
+            if (transport->m_Type == "File")
+            {
+                transport->Flush();
+            }
+        }
+    }
+    else
+    {
+        auto itTransport = m_Transports.find(transportIndex);
+        CheckFile(itTransport, ", in call to FlushFiles with index " +
+                                   std::to_string(transportIndex));
+        itTransport->second->Flush();
+    }
+}
+
 bool TransportMan::AllTransportsClosed() const noexcept
 {
     bool allClose = true;
@@ -241,6 +297,11 @@ TransportMan::OpenFileTransport(const std::string &fileName,
             transport =
                 std::make_shared<transport::FilePOSIX>(m_MPIComm, m_DebugMode);
         }
+        else if (library == "mmap")
+        {
+            transport =
+                std::make_shared<transport::FileMMap>(m_MPIComm, m_DebugMode);
+        }
 #endif
         else
         {
@@ -248,7 +309,7 @@ TransportMan::OpenFileTransport(const std::string &fileName,
             {
                 throw std::invalid_argument(
                     "ERROR: invalid IO AddTransport library " + library +
-                    ", only POSIX, stdio, fstream are supported\n");
+                    ", only POSIX, mmap, stdio, fstream are supported\n");
             }
         }
     };
@@ -108,6 +108,15 @@ public:
     void WriteFiles(const char *buffer, const size_t size,
                     const int transportIndex = -1);
 
+    /**
+     * Gather write to file transports, pieces land contiguously
+     * @param iov pieces of memory to be written in order
+     * @param iovCount number of pieces in iov
+     * @param transportIndex
+     */
+    void WriteFilesV(const Transport::IOVec *iov, const size_t iovCount,
+                     const int transportIndex = -1);
+
     size_t GetFileSize(const size_t transportIndex = 0) const;
 
     /**
@@ -120,6 +129,18 @@ public:
     void ReadFile(char *buffer, const size_t size, const size_t start = 0,
                   const size_t transportIndex = 0);
 
+    /**
+     * Direct access to the contents of a single file, avoids the copy in
+     * ReadFile for transports that keep the file in memory (Library=mmap)
+     * @param size
+     * @param start
+     * @param transportIndex
+     * @return pointer to file contents at start, nullptr if the transport
+     * doesn't support direct access, use ReadFile instead
+     */
+    const char *GetFileData(const size_t size, const size_t start = 0,
+                            const size_t transportIndex = 0) const;
+
     /**
      * Close file or files depending on transport index. Throws an exception
      * if transport is not a file when transportIndex > -1.
@@ -127,6 +148,13 @@ public:
      */
     void CloseFiles(const int transportIndex = -1);
 
+    /**
+     * Flush file or files depending on transport index, so written bytes are
+     * visible to other processes
+     * @param transportIndex -1: all transports, otherwise index in m_Transports
+     */
+    void FlushFiles(const int transportIndex = -1);
+
     /** Checks if all transports are closed */
     bool AllTransportsClosed() const noexcept;
 
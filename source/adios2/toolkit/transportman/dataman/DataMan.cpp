@@ -8,8 +8,11 @@
  *      Author: Jason Wang wangr1@ornl.gov
  */
 
-#include <fstream>  //TODO go away
-#include <iostream> //TODO go away
+#include <algorithm> //std::max
+#include <chrono>    //std::chrono::milliseconds
+#include <exception> //std::exception_ptr
+#include <fstream>   //TODO go away
+#include <iostream>  //TODO go away
 
 #include "DataMan.h"
 
@@ -26,21 +29,35 @@ namespace transportman
 {
 
 DataMan::DataMan(MPI_Comm mpiComm, const bool debugMode)
-: TransportMan(mpiComm, debugMode)
+: TransportMan(mpiComm, debugMode),
+  m_BufferPool(std::make_shared<BufferPool>()),
+  m_Queue(m_QueueCapacity + 1), m_QueueHead(0), m_QueueTail(0),
+  m_Listening(false)
 {
 }
 
 DataMan::~DataMan()
 {
-    for (auto &readThread : m_ReadThreads)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_Listening = false;
+    }
+    m_Condition.notify_all();
+    for (auto &readThread : m_ReadThreads)
+    {
         readThread.join();
     }
 }
 
 void DataMan::SetMaxReceiveBuffer(size_t size) { m_MaxReceiveBuffer = size; }
 
+void DataMan::SetSegmentSize(size_t size) { m_SegmentSize = size; }
+
+void DataMan::SetStripeSteps(const bool stripeSteps)
+{
+    m_StripeSteps = stripeSteps;
+}
+
 void DataMan::OpenWANTransports(const std::vector<std::string> &streamNames,
                                 const Mode mode,
                                 const std::vector<Params> &paramsVector,
@@ -79,6 +96,21 @@ void DataMan::OpenWANTransports(const std::vector<std::string> &streamNames,
             port = std::to_string(stoi(port) + mpiRank + i * mpiSize);
         }
 
+        // reqrep (default), pipeline or pubsub
+        std::string pattern(GetParameter("Pattern", paramsVector[i], false,
+                                         m_DebugMode,
+                                         "Transport Pattern Parameter"));
+        std::transform(pattern.begin(), pattern.end(), pattern.begin(),
+                       ::tolower);
+        if (pattern.empty())
+        {
+            pattern = "reqrep";
+        }
+
+        const std::string highWaterMark(
+            GetParameter("HighWaterMark", paramsVector[i], false, m_DebugMode,
+                         "Transport HighWaterMark Parameter"));
+
         std::shared_ptr<Transport> wanTransport;
 
         if (library == "zmq" || library == "ZMQ")
@@ -86,17 +118,10 @@ void DataMan::OpenWANTransports(const std::vector<std::string> &streamNames,
 #ifdef ADIOS2_HAVE_ZEROMQ
 
             wanTransport = std::make_shared<transport::WANZmq>(
-                ipAddress, port, m_MPIComm, m_DebugMode);
+                ipAddress, port, m_MPIComm, m_DebugMode, pattern,
+                highWaterMark.empty() ? 0 : std::stoi(highWaterMark));
             wanTransport->Open(streamNames[i], mode);
-            m_Transports.emplace(i, wanTransport);
-
-            if (mode == Mode::Read)
-            {
-
-                m_Listening = true;
-                m_ReadThreads.emplace_back(
-                    std::thread(&DataMan::ReadThread, this, wanTransport));
-            }
+            AddWANTransport(wanTransport, mode, pattern);
 
 #else
             throw std::invalid_argument(
@@ -117,39 +142,330 @@ void DataMan::OpenWANTransports(const std::vector<std::string> &streamNames,
     }
 }
 
+void DataMan::AddWANTransport(std::shared_ptr<Transport> transport,
+                              const Mode openMode, const std::string &pattern)
+{
+    m_Transports.emplace(m_Transports.size(), transport);
+
+    if (openMode == Mode::Read)
+    {
+        size_t channel;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Lossy = m_Lossy || pattern == "pubsub";
+            channel = m_ChannelSteps.size();
+            m_ChannelSteps.push_back(0);
+        }
+        m_Listening = true;
+        m_ReadThreads.emplace_back(
+            std::thread(&DataMan::ReadThread, this, transport, channel));
+    }
+}
+
 void DataMan::WriteWAN(const std::vector<char> &buffer, size_t size)
 {
-    if (m_CurrentTransport >= m_Transports.size())
+    const size_t channels = m_Transports.size();
+    if (channels == 0)
     {
         throw std::runtime_error(
             "ERROR: No valid transports found, from DataMan::WriteWAN()");
     }
 
-    m_Transports[m_CurrentTransport]->Write(
-        reinterpret_cast<const char *>(buffer.data()), size);
+    size_t segmentSize = size;
+    if (!m_StripeSteps)
+    {
+        segmentSize = (m_SegmentSize > 0) ? m_SegmentSize
+                                          : (size + channels - 1) / channels;
+    }
+    if (segmentSize == 0)
+    {
+        segmentSize = 1;
+    }
+
+    SegmentHeader header;
+    header.Step = m_WriteStep;
+    header.Size = static_cast<uint64_t>(size);
+    header.Count = (size == 0) ? 1 : (size + segmentSize - 1) / segmentSize;
+
+    const size_t usedChannels =
+        std::min(channels, static_cast<size_t>(header.Count));
+    std::vector<std::exception_ptr> exceptions(usedChannels);
+
+    // segment s goes to channel (m_CurrentTransport + s) % channels
+    auto lf_WriteChannel = [&](const size_t first) {
+        const size_t channel = (m_CurrentTransport + first) % channels;
+        try
+        {
+            for (size_t s = first; s < header.Count; s += channels)
+            {
+                SegmentHeader segmentHeader = header;
+                segmentHeader.Offset = s * segmentSize;
+                segmentHeader.Length =
+                    std::min(segmentSize, size - segmentHeader.Offset);
+
+                // header and segment frames, no copy of the segment
+                const Transport::IOVec iov[2] = {
+                    {reinterpret_cast<const char *>(&segmentHeader),
+                     sizeof(SegmentHeader)},
+                    {buffer.data() + segmentHeader.Offset,
+                     segmentHeader.Length}};
+                m_Transports.at(channel)->WriteV(iov, 2);
+            }
+        }
+        catch (...)
+        {
+            exceptions[first] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> writeThreads;
+    writeThreads.reserve(usedChannels - 1);
+    for (size_t first = 1; first < usedChannels; ++first)
+    {
+        writeThreads.emplace_back(lf_WriteChannel, first);
+    }
+    lf_WriteChannel(0);
+
+    for (auto &writeThread : writeThreads)
+    {
+        writeThread.join();
+    }
+
+    ++m_WriteStep;
+    m_CurrentTransport = (m_CurrentTransport + header.Count) % channels;
+
+    for (auto &exception : exceptions)
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
 }
 
-std::shared_ptr<std::vector<char>> DataMan::ReadWAN()
+std::shared_ptr<std::vector<char>>
+DataMan::ReadWAN(const int timeoutMilliseconds)
 {
+    std::shared_ptr<std::vector<char>> buffer = PopBufferQueue();
+    if (buffer || timeoutMilliseconds <= 0)
+    {
+        return buffer;
+    }
+
+    // pushes notify with m_Mutex held, so none is missed between the
+    // check and the wait
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait_for(
+            lock, std::chrono::milliseconds(timeoutMilliseconds), [this] {
+                return !m_Listening ||
+                       m_QueueHead.load(std::memory_order_relaxed) !=
+                           m_QueueTail.load(std::memory_order_acquire);
+            });
+    }
     return PopBufferQueue();
 }
 
-void DataMan::PushBufferQueue(std::shared_ptr<std::vector<char>> v)
+bool DataMan::PushBufferQueue(std::shared_ptr<std::vector<char>> buffer,
+                              std::unique_lock<std::mutex> &lock)
 {
-    std::lock_guard<std::mutex> l(m_Mutex);
-    m_BufferQueue.push(v);
+    const size_t slots = m_Queue.size();
+    const size_t tail = m_QueueTail.load(std::memory_order_relaxed);
+    const size_t next = (tail + 1) % slots;
+
+    // full, back-pressure on the transports until ReadWAN catches up, other
+    // read threads keep receiving meanwhile. ReadWAN notifies without
+    // m_Mutex, the timeout covers a pop between the check and the wait
+    while (next == m_QueueHead.load(std::memory_order_acquire))
+    {
+        if (!m_Listening)
+        {
+            return false;
+        }
+        m_Condition.wait_for(lock, std::chrono::milliseconds(1));
+    }
+
+    m_Queue[tail] = std::move(buffer);
+    m_QueueTail.store(next, std::memory_order_release);
+    m_Condition.notify_all();
+    return true;
 }
 
 std::shared_ptr<std::vector<char>> DataMan::PopBufferQueue()
 {
-    std::lock_guard<std::mutex> l(m_Mutex);
-    if (m_BufferQueue.size() > 0)
+    const size_t head = m_QueueHead.load(std::memory_order_relaxed);
+    if (head == m_QueueTail.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<std::vector<char>> buffer = std::move(m_Queue[head]);
+    m_QueueHead.store((head + 1) % m_Queue.size(), std::memory_order_release);
+    m_Condition.notify_all();
+    return buffer;
+}
+
+std::shared_ptr<std::vector<char>> DataMan::GetPoolBuffer(const size_t size)
+{
+    std::unique_ptr<std::vector<char>> buffer;
+    {
+        std::lock_guard<std::mutex> lock(m_BufferPool->Mutex);
+        if (!m_BufferPool->Free.empty())
+        {
+            buffer = std::move(m_BufferPool->Free.back());
+            m_BufferPool->Free.pop_back();
+        }
+    }
+    if (!buffer)
+    {
+        buffer.reset(new std::vector<char>());
+    }
+    // keeps capacity of recycled buffers
+    buffer->resize(size);
+
+    std::shared_ptr<BufferPool> pool(m_BufferPool);
+    const size_t maxPoolBuffers = m_MaxPoolBuffers;
+    return std::shared_ptr<std::vector<char>>(
+        buffer.release(), [pool, maxPoolBuffers](std::vector<char> *released) {
+            std::unique_ptr<std::vector<char>> recycled(released);
+            std::lock_guard<std::mutex> lock(pool->Mutex);
+            if (pool->Free.size() < maxPoolBuffers)
+            {
+                pool->Free.push_back(std::move(recycled));
+            }
+        });
+}
+
+std::shared_ptr<std::vector<char>>
+DataMan::ReserveSegment(const SegmentHeader &header, const size_t channel)
+{
+    if (header.Length > m_MaxReceiveBuffer ||
+        header.Offset + header.Length > header.Size)
+    {
+        return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    if (m_FirstSegment)
+    {
+        m_NextReadStep = header.Step;
+        m_FirstSegment = false;
+    }
+
+    if (m_Lossy)
+    {
+        // steps all channels are past won't get their missing segments,
+        // a merely slower channel holds its steps back
+        m_ChannelSteps[channel] =
+            std::max(m_ChannelSteps[channel], header.Step);
+        const uint64_t channelsStep =
+            *std::min_element(m_ChannelSteps.begin(), m_ChannelSteps.end());
+        if (channelsStep > m_NextReadStep)
+        {
+            DropSteps(channelsStep, true);
+        }
+
+        // newer steps win over steps held back by lost segments
+        if (header.Step >= m_NextReadStep + m_MaxPartialBuffers)
+        {
+            DropSteps(header.Step + 1 - m_MaxPartialBuffers, false);
+        }
+    }
+    else
+    {
+        // back-pressure on this channel until older steps are pushed
+        while (m_Listening &&
+               header.Step >= m_NextReadStep + m_MaxPartialBuffers)
+        {
+            m_Condition.wait(lock);
+        }
+        if (!m_Listening)
+        {
+            return nullptr;
+        }
+    }
+
+    if (header.Step < m_NextReadStep)
+    {
+        return nullptr;
+    }
+
+    PartialBuffer &partial = m_PartialBuffers[header.Step];
+    if (!partial.Buffer)
+    {
+        partial.Buffer = GetPoolBuffer(static_cast<size_t>(header.Size));
+        partial.Count = header.Count;
+    }
+    return partial.Buffer;
+}
+
+void DataMan::CompleteSegment(const SegmentHeader &header,
+                              const bool received)
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    auto itSegment = m_PartialBuffers.find(header.Step);
+    if (itSegment == m_PartialBuffers.end())
+    {
+        // step dropped while its segment was being received
+        return;
+    }
+
+    PartialBuffer &segmentPartial = itSegment->second;
+    ++segmentPartial.Received;
+    segmentPartial.Failed = segmentPartial.Failed || !received;
+
+    if (m_Pushing)
+    {
+        // picked up by the pushing thread once the queue has room
+        return;
+    }
+
+    m_Pushing = true;
+    while (!m_PartialBuffers.empty())
+    {
+        auto itPartial = m_PartialBuffers.begin();
+        PartialBuffer &partial = itPartial->second;
+        if (itPartial->first > m_NextReadStep ||
+            partial.Received < partial.Count)
+        {
+            break;
+        }
+
+        std::shared_ptr<std::vector<char>> buffer;
+        if (!partial.Failed)
+        {
+            buffer = std::move(partial.Buffer);
+        }
+        m_NextReadStep = std::max(m_NextReadStep, itPartial->first + 1);
+        m_PartialBuffers.erase(itPartial);
+        m_Condition.notify_all();
+
+        if (buffer && !PushBufferQueue(std::move(buffer), lock))
+        {
+            break;
+        }
+    }
+    m_Pushing = false;
+}
+
+void DataMan::DropSteps(const uint64_t step, const bool keepComplete)
+{
+    auto itPartial = m_PartialBuffers.begin();
+    while (itPartial != m_PartialBuffers.end() && itPartial->first < step)
     {
-        std::shared_ptr<std::vector<char>> vec = m_BufferQueue.front();
-        m_BufferQueue.pop();
-        return vec;
+        const PartialBuffer &partial = itPartial->second;
+        if (keepComplete && !partial.Failed &&
+            partial.Received == partial.Count)
+        {
+            ++itPartial;
+        }
+        else
+        {
+            itPartial = m_PartialBuffers.erase(itPartial);
+        }
     }
-    return nullptr;
+    m_NextReadStep = std::max(m_NextReadStep, step);
+    m_Condition.notify_all();
 }
 
 void DataMan::SetBP3Deserializer(format::BP3Deserializer &bp3Deserializer) {}
@@ -158,95 +474,38 @@ void DataMan::SetIO(IO &io) {}
 
 void DataMan::SetCallback(std::function<void(std::vector<char>)> callback) {}
 
-void DataMan::ReadThread(std::shared_ptr<Transport> transport)
+void DataMan::ReadThread(std::shared_ptr<Transport> transport,
+                         const size_t channel)
 {
+    SegmentHeader header;
 
-    // Initialize buffer
-    std::vector<char> buffer(m_MaxReceiveBuffer);
-
-    // Main loop
     while (m_Listening)
     {
-
+        // IRead waits for a message, doesn't spin while idle
         Transport::Status status;
-        transport->IRead(buffer.data(), m_MaxReceiveBuffer, status);
+        transport->IRead(reinterpret_cast<char *>(&header),
+                         sizeof(SegmentHeader), status);
 
-        if (status.Bytes > 0)
+        if (status.Bytes != sizeof(SegmentHeader))
         {
+            continue;
+        }
 
-            std::shared_ptr<std::vector<char>> bufferQ =
-                std::make_shared<std::vector<char>>(status.Bytes);
-
-            std::memcpy(bufferQ->data(), buffer.data(), status.Bytes);
-
-            PushBufferQueue(bufferQ);
-
-            /*
-                            // TODO: move to engine
-                            if (GetBoolParameter(trans_params, "DumpFile"))
-                            {
-                                std::ofstream bpfile(stream_name,
-            std::ios_base::binary);
-                                bpfile.write(reinterpret_cast<const char
-            *>(buffer->data()),
-                                             status.Bytes);
-                                bpfile.close();
-                            }
-
-                            m_BP3Deserializer->m_Data.Resize(
-                                status.Bytes, "in DataMan Streaming Listener");
-                            std::memcpy(m_BP3Deserializer->m_Data.m_Buffer.data(),
-                                        buffer.data(), status.Bytes);
-                            m_BP3Deserializer->ParseMetadata(m_BP3Deserializer->m_Data,
-                                                             *m_IO);
-
-                            const auto variablesInfo =
-            m_IO->GetAvailableVariables();
-                            for (const auto &variableInfoPair : variablesInfo)
-                            {
-
-                                std::string var = variableInfoPair.first;
-                                std::string type = "null";
-
-                                for (const auto &parameter :
-            variableInfoPair.second)
-                                {
-                                    //  ** print out all parameters from BP
-            metadata
-                                        std::cout << "\tKey: " <<
-            parameter.first
-                                                  << "\t Value: " <<
-            parameter.second <<
-                                       "\n";
-                                    if (parameter.first == "Type")
-                                    {
-                                        type = parameter.second;
-                                    }
-                                }
-
-                                if (type == "compound")
-                                {
-                                    // not supported
-                                }
-            #define declare_type(T) \
-                else if (type == GetType<T>()) \
-                { \
-                    adios2::Variable<T> *v = m_IO->InquireVariable<T>(var); \
-                    m_BP3Deserializer->GetSyncVariableDataFromStream( \
-                        *v, m_BP3Deserializer->m_Data); \
-                    if (v->GetData() == nullptr) \
-                    { \
-                        throw("Data pointer obtained from BP deserializer is a
-            nullptr");  \
-                    } \
-                    RunCallback(v->GetData(), "stream", var, type, v->m_Shape);
-            \
-                }
-                                ADIOS2_FOREACH_TYPE_1ARG(declare_type)
-            #undef declare_type
-                            }
-                                    */
+        std::shared_ptr<std::vector<char>> buffer =
+            ReserveSegment(header, channel);
+        if (buffer == nullptr)
+        {
+            // discard segment frame
+            char discard;
+            transport->IRead(&discard, 1, status);
+            continue;
         }
+
+        // segment frame lands in its place in the step buffer
+        transport->IRead(buffer->data() + header.Offset,
+                         static_cast<size_t>(header.Length), status);
+
+        CompleteSegment(header, status.Bytes == header.Length);
     }
 }
 
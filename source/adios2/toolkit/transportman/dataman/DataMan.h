@@ -11,7 +11,10 @@
 #ifndef ADIOS2_TOOLKIT_TRANSPORTMAN_DATAMAN_DATAMAN_H_
 #define ADIOS2_TOOLKIT_TRANSPORTMAN_DATAMAN_DATAMAN_H_
 
-#include <queue>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <thread>
 
 #include "adios2/core/IO.h"
@@ -37,24 +40,161 @@ public:
                            const std::vector<Params> &params,
                            const bool profile);
 
+    /**
+     * Adds an open WAN transport as the next channel, called by
+     * OpenWANTransports for each stream
+     * @param transport open in openMode
+     * @param openMode Mode::Read starts a thread receiving its segments
+     * @param pattern "pubsub" may lose segments, reassembly then skips the
+     * steps they belong to
+     */
+    void AddWANTransport(std::shared_ptr<Transport> transport,
+                         const Mode openMode, const std::string &pattern);
+
+    /**
+     * Sends buffer as one or more segments, each with a SegmentHeader.
+     * Segments are striped across all open transports (channels), one
+     * thread per channel, or the whole buffer goes to the next channel in
+     * round-robin if SetStripeSteps(true)
+     * @param buffer
+     * @param size bytes to send from buffer
+     */
     void WriteWAN(const std::vector<char> &buffer, size_t size);
 
-    std::shared_ptr<std::vector<char>> ReadWAN();
+    /**
+     * Next buffer rebuilt from its segments, in WriteWAN order. Buffers
+     * come from a pool and return to it when the last copy is released.
+     * @param timeoutMilliseconds waits this long for a buffer if none is
+     * available, 0 (default) returns at once
+     * @return nullptr if no complete buffer is available
+     */
+    std::shared_ptr<std::vector<char>>
+    ReadWAN(const int timeoutMilliseconds = 0);
 
     void SetBP3Deserializer(format::BP3Deserializer &bp3Deserializer);
     void SetIO(IO &io);
 
     void SetCallback(std::function<void(std::vector<char>)> callback);
+    /** larger incoming segments are discarded */
     void SetMaxReceiveBuffer(size_t size);
 
+    /** 0 (default): buffers are split in one segment per channel */
+    void SetSegmentSize(size_t size);
+
+    /** true: each buffer is sent whole, round-robin across channels */
+    void SetStripeSteps(const bool stripeSteps);
+
 private:
+    /** first frame of each segment message sent by WriteWAN, the second
+     * frame is the segment itself */
+    struct SegmentHeader
+    {
+        /** WriteWAN call index, buffers are rebuilt in this order */
+        uint64_t Step;
+        /** full buffer size */
+        uint64_t Size;
+        /** segment position in full buffer */
+        uint64_t Offset;
+        /** segment size */
+        uint64_t Length;
+        /** number of segments of full buffer */
+        uint64_t Count;
+    };
+
+    /** buffer being rebuilt from segments arriving on any channel */
+    struct PartialBuffer
+    {
+        std::shared_ptr<std::vector<char>> Buffer;
+        uint64_t Count = 0;
+        /** received and failed segments */
+        uint64_t Received = 0;
+        /** a segment failed to arrive, the step is dropped in its turn */
+        bool Failed = false;
+    };
+
+    /** released receive buffers, shared with the deleter of each buffer
+     * handed out so it outlives DataMan if needed */
+    struct BufferPool
+    {
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<std::vector<char>>> Free;
+    };
+
     std::function<void(std::vector<char>)> m_Callback;
-    void ReadThread(std::shared_ptr<Transport> trans);
 
-    std::queue<std::shared_ptr<std::vector<char>>> m_BufferQueue;
-    void PushBufferQueue(std::shared_ptr<std::vector<char>> v);
-    std::shared_ptr<std::vector<char>> PopBufferQueue();
+    /** waits for segment messages in transport and receives each segment
+     * straight into its pooled step buffer
+     * @param channel index of transport in m_ChannelSteps */
+    void ReadThread(std::shared_ptr<Transport> transport,
+                    const size_t channel);
+
+    /** @return buffer of size bytes, from m_BufferPool if available */
+    std::shared_ptr<std::vector<char>> GetPoolBuffer(const size_t size);
+
+    std::shared_ptr<BufferPool> m_BufferPool;
+    /** max released buffers kept in m_BufferPool */
+    const size_t m_MaxPoolBuffers = 16;
+
+    /**
+     * Destination of the segment described by header
+     * @param channel read channel the header arrived on
+     * @return step buffer, nullptr if the segment must be discarded
+     */
+    std::shared_ptr<std::vector<char>>
+    ReserveSegment(const SegmentHeader &header, const size_t channel);
+
+    /** counts a segment, complete buffers are pushed to the queue in step
+     * order by one read thread at a time
+     * @param received false if the segment frame failed to arrive */
+    void CompleteSegment(const SegmentHeader &header, const bool received);
+
+    /** gives up on steps before step, call with m_Mutex locked
+     * @param keepComplete true: only incomplete buffers are dropped */
+    void DropSteps(const uint64_t step, const bool keepComplete);
+
+    /** key: step, incomplete buffers and complete ones waiting for a
+     * previous step, guarded by m_Mutex */
+    std::map<uint64_t, PartialBuffer> m_PartialBuffers;
+    /** steps before it are pushed or dropped */
+    uint64_t m_NextReadStep = 0;
+    /** a subscriber may join late, first segment sets m_NextReadStep */
+    bool m_FirstSegment = true;
+    /** a read thread is pushing complete buffers to the queue */
+    bool m_Pushing = false;
+    /** steps from m_NextReadStep being rebuilt at once, further segments
+     * wait for the window to move, or drop older steps if m_Lossy */
+    const uint64_t m_MaxPartialBuffers = 64;
+    /** a channel uses the pubsub pattern, segments may be lost */
+    bool m_Lossy = false;
+    /** last step each read channel delivered a segment of, 0 if none.
+     * Channels deliver in order, so once every channel is past a step its
+     * missing segments are lost */
+    std::vector<uint64_t> m_ChannelSteps;
     std::mutex m_Mutex;
+    /** signals queue space and items, window progress and stop, waited on
+     * with m_Mutex */
+    std::condition_variable m_Condition;
+
+    /**
+     * Bounded lock-free single-producer single-consumer ring between the
+     * read threads, one at a time through m_Pushing, and ReadWAN. Has
+     * m_QueueCapacity + 1 slots, head == tail is empty.
+     */
+    const size_t m_QueueCapacity = 32; // declared first, sizes m_Queue
+    std::vector<std::shared_ptr<std::vector<char>>> m_Queue;
+    std::atomic<size_t> m_QueueHead;
+    std::atomic<size_t> m_QueueTail;
+
+    /** waits while the queue is full, releasing lock meanwhile
+     * @param lock holds m_Mutex
+     * @return false if stopped listening while waiting */
+    bool PushBufferQueue(std::shared_ptr<std::vector<char>> buffer,
+                         std::unique_lock<std::mutex> &lock);
+    std::shared_ptr<std::vector<char>> PopBufferQueue();
+
+    uint64_t m_WriteStep = 0;
+    size_t m_SegmentSize = 0;
+    bool m_StripeSteps = false;
 
     bool GetBoolParameter(const Params &params, std::string key);
 
@@ -64,7 +204,7 @@ private:
     size_t m_MaxReceiveBuffer = 128 * 1024 * 1024;
 
     size_t m_CurrentTransport = 0;
-    bool m_Listening = false;
+    std::atomic<bool> m_Listening;
     const int m_DefaultPort = 12306;
     int m_Timeout = 5;
 };
@@ -0,0 +1,256 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../SmallTestData.h"
+
+class BPWriteAggregateReadTestADIOS2 : public ::testing::Test
+{
+public:
+    BPWriteAggregateReadTestADIOS2() = default;
+
+    SmallTestData m_TestData;
+    SmallTestData m_OriginalData;
+
+    /**
+     * Writes aggregated sub-files and reads the neighbor's blocks back
+     * @param fname
+     * @param readParameters reader IO parameters
+     * @param readTransportParameters reader file transport parameters
+     * @param writeParameters writer IO parameters added to Aggregators
+     */
+    void WriteAggregateRead(const std::string &fname,
+                            const adios2::Params &readParameters,
+                            const adios2::Params &readTransportParameters = {},
+                            const adios2::Params &writeParameters = {});
+};
+
+void BPWriteAggregateReadTestADIOS2::WriteAggregateRead(
+    const std::string &fname, const adios2::Params &readParameters,
+    const adios2::Params &readTransportParameters,
+    const adios2::Params &writeParameters)
+{
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows
+    const size_t Nx = 8;
+    // 2D is Ny x Nx2
+    const size_t Ny = 2;
+    const size_t Nx2 = 4;
+
+    // Number of steps
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    // half of the ranks write sub-files
+    const int subStreams = (mpiSize > 1) ? mpiSize / 2 : 1;
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+
+        {
+            const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+            const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+            const adios2::Dims count{Nx};
+
+            io.DefineVariable<int32_t>("i32", shape, start, count,
+                                       adios2::ConstantDims,
+                                       m_TestData.I32.data());
+            io.DefineVariable<uint64_t>("u64", shape, start, count,
+                                        adios2::ConstantDims,
+                                        m_TestData.U64.data());
+            io.DefineVariable<double>("r64", shape, start, count,
+                                      adios2::ConstantDims,
+                                      m_TestData.R64.data());
+
+            const adios2::Dims shape2{Ny, static_cast<size_t>(Nx2 * mpiSize)};
+            const adios2::Dims start2{0, static_cast<size_t>(Nx2 * mpiRank)};
+            const adios2::Dims count2{Ny, Nx2};
+
+            io.DefineVariable<float>("r32_2d", shape2, start2, count2,
+                                     adios2::ConstantDims,
+                                     m_TestData.R32.data());
+        }
+
+        io.DefineAttribute<std::string>("units", "meters");
+
+        io.SetEngine("BPFile");
+        io.SetParameters(writeParameters);
+        io.SetParameter("Aggregators", std::to_string(subStreams));
+        io.AddTransport("file");
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            UpdateSmallTestData(m_TestData, static_cast<int>(step), mpiRank,
+                                mpiSize);
+            EXPECT_EQ(bpWriter.CurrentStep(), step);
+            bpWriter.WriteStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        io.SetParameters(readParameters);
+        io.AddTransport("file", readTransportParameters);
+
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto attr_units = io.InquireAttribute<std::string>("units");
+        ASSERT_NE(attr_units, nullptr);
+        EXPECT_EQ(attr_units->m_DataSingleValue, "meters");
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_NE(var_i32, nullptr);
+        ASSERT_EQ(var_i32->m_AvailableStepsCount, NSteps);
+        ASSERT_EQ(var_i32->m_Shape[0], mpiSize * Nx);
+
+        auto var_u64 = io.InquireVariable<uint64_t>("u64");
+        ASSERT_NE(var_u64, nullptr);
+        ASSERT_EQ(var_u64->m_AvailableStepsCount, NSteps);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        ASSERT_EQ(var_r64->m_AvailableStepsCount, NSteps);
+
+        auto var_r32_2d = io.InquireVariable<float>("r32_2d");
+        ASSERT_NE(var_r32_2d, nullptr);
+        ASSERT_EQ(var_r32_2d->m_AvailableStepsCount, NSteps);
+        ASSERT_EQ(var_r32_2d->m_Shape[0], Ny);
+        ASSERT_EQ(var_r32_2d->m_Shape[1], static_cast<size_t>(mpiSize * Nx2));
+
+        std::array<int32_t, Nx> I32;
+        std::array<uint64_t, Nx> U64;
+        std::array<double, Nx> R64;
+        std::array<float, Ny * Nx2> R32;
+
+        // read the neighbor's block to cross sub-files
+        const size_t readRank = static_cast<size_t>((mpiRank + 1) % mpiSize);
+
+        const adios2::Box<adios2::Dims> sel({readRank * Nx}, {Nx});
+        var_i32->SetSelection(sel);
+        var_u64->SetSelection(sel);
+        var_r64->SetSelection(sel);
+
+        const adios2::Box<adios2::Dims> sel2({0, readRank * Nx2}, {Ny, Nx2});
+        var_r32_2d->SetSelection(sel2);
+
+        unsigned int t = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            EXPECT_EQ(bpReader.CurrentStep(), static_cast<size_t>(t));
+
+            bpReader.GetDeferred(*var_i32, I32.data());
+            bpReader.GetDeferred(*var_u64, U64.data());
+            bpReader.GetDeferred(*var_r64, R64.data());
+            bpReader.GetDeferred(*var_r32_2d, R32.data());
+
+            bpReader.PerformGets();
+
+            bpReader.EndStep();
+
+            UpdateSmallTestData(m_OriginalData, static_cast<int>(t),
+                                static_cast<int>(readRank), mpiSize);
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                std::stringstream ss;
+                ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+                std::string msg = ss.str();
+
+                EXPECT_EQ(I32[i], m_OriginalData.I32[i]) << msg;
+                EXPECT_EQ(U64[i], m_OriginalData.U64[i]) << msg;
+                EXPECT_EQ(R64[i], m_OriginalData.R64[i]) << msg;
+                EXPECT_EQ(R32[i], m_OriginalData.R32[i]) << msg;
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 1D 1x8 and 2D 2x4 test data, all ranks aggregated into sub-files
+//******************************************************************************
+
+TEST_F(BPWriteAggregateReadTestADIOS2, ADIOS2BPWriteAggregateRead)
+{
+    WriteAggregateRead("ADIOS2BPWriteAggregateRead.bp", {});
+}
+
+//******************************************************************************
+// same data, sub-files read by threads without merging reads across gaps
+//******************************************************************************
+
+TEST_F(BPWriteAggregateReadTestADIOS2, ADIOS2BPWriteAggregateReadThreads)
+{
+    WriteAggregateRead("ADIOS2BPWriteAggregateReadThreads.bp",
+                       {{"Threads", "2"}, {"ReadGapSize", "0Kb"}});
+}
+
+//******************************************************************************
+// same data, metadata indices merged in a binary tree of ranks
+//******************************************************************************
+
+TEST_F(BPWriteAggregateReadTestADIOS2, ADIOS2BPWriteAggregateReadMetadataTree)
+{
+    WriteAggregateRead("ADIOS2BPWriteAggregateReadMetadataTree.bp", {}, {},
+                       {{"MetadataFanIn", "2"}});
+}
+
+#ifndef _WIN32
+//******************************************************************************
+// same data, metadata and sub-files mapped in memory and clipped in place
+//******************************************************************************
+
+TEST_F(BPWriteAggregateReadTestADIOS2, ADIOS2BPWriteAggregateReadMMap)
+{
+    WriteAggregateRead("ADIOS2BPWriteAggregateReadMMap.bp",
+                       {{"Threads", "2"}}, {{"Library", "mmap"}});
+}
+#endif
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,190 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../SmallTestData.h"
+
+class BPWriteAppendReadTestADIOS2 : public ::testing::Test
+{
+public:
+    BPWriteAppendReadTestADIOS2() = default;
+
+    SmallTestData m_TestData;
+    SmallTestData m_OriginalData;
+
+    /**
+     * Writes NSteps in Mode::Write, then NAppendSteps in Mode::Append and
+     * reads all steps back
+     */
+    void WriteAppendRead(const std::string &fname,
+                         const adios2::Params &parameters);
+};
+
+void BPWriteAppendReadTestADIOS2::WriteAppendRead(
+    const std::string &fname, const adios2::Params &parameters)
+{
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows
+    const size_t Nx = 8;
+
+    // Number of steps in each session
+    const size_t NSteps = 3;
+    const size_t NAppendSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    auto lf_Write = [&](const std::string ioName, const adios2::Mode mode,
+                        const size_t stepStart, const size_t steps) {
+
+        adios2::IO &io = adios.DeclareIO(ioName);
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        io.DefineVariable<int32_t>("i32", shape, start, count,
+                                   adios2::ConstantDims,
+                                   m_TestData.I32.data());
+        io.DefineVariable<double>("r64", shape, start, count,
+                                  adios2::ConstantDims, m_TestData.R64.data());
+        io.DefineAttribute<std::string>("units", "meters");
+
+        io.SetEngine("BPFile");
+        io.SetParameters(parameters);
+        io.AddTransport("file");
+
+        adios2::Engine &bpWriter = io.Open(fname, mode);
+
+        for (size_t step = stepStart; step < stepStart + steps; ++step)
+        {
+            UpdateSmallTestData(m_TestData, static_cast<int>(step), mpiRank,
+                                mpiSize);
+            EXPECT_EQ(bpWriter.CurrentStep(), step);
+            bpWriter.WriteStep();
+        }
+
+        bpWriter.Close();
+    };
+
+    lf_Write("WriteIO", adios2::Mode::Write, 0, NSteps);
+    // continues at the end of existing sub-files and indices
+    lf_Write("AppendIO", adios2::Mode::Append, NSteps, NAppendSteps);
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto attr_units = io.InquireAttribute<std::string>("units");
+        ASSERT_NE(attr_units, nullptr);
+        EXPECT_EQ(attr_units->m_DataSingleValue, "meters");
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_NE(var_i32, nullptr);
+        ASSERT_EQ(var_i32->m_AvailableStepsCount, NSteps + NAppendSteps);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        ASSERT_EQ(var_r64->m_AvailableStepsCount, NSteps + NAppendSteps);
+
+        std::array<int32_t, Nx> I32;
+        std::array<double, Nx> R64;
+
+        const adios2::Box<adios2::Dims> sel({mpiRank * Nx}, {Nx});
+        var_i32->SetSelection(sel);
+        var_r64->SetSelection(sel);
+
+        unsigned int t = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            EXPECT_EQ(bpReader.CurrentStep(), static_cast<size_t>(t));
+
+            bpReader.GetDeferred(*var_i32, I32.data());
+            bpReader.GetDeferred(*var_r64, R64.data());
+            bpReader.PerformGets();
+            bpReader.EndStep();
+
+            UpdateSmallTestData(m_OriginalData, static_cast<int>(t), mpiRank,
+                                mpiSize);
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                std::stringstream ss;
+                ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+                std::string msg = ss.str();
+
+                EXPECT_EQ(I32[i], m_OriginalData.I32[i]) << msg;
+                EXPECT_EQ(R64[i], m_OriginalData.R64[i]) << msg;
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps + NAppendSteps);
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 1D 1x8 test data, one sub-file per rank
+//******************************************************************************
+
+TEST_F(BPWriteAppendReadTestADIOS2, ADIOS2BPWriteAppendRead1D8)
+{
+    WriteAppendRead("ADIOS2BPWriteAppendRead1D8.bp", {});
+}
+
+//******************************************************************************
+// 1D 1x8 test data, all ranks aggregated into sub-files
+//******************************************************************************
+
+TEST_F(BPWriteAppendReadTestADIOS2, ADIOS2BPWriteAppendReadAggregate1D8)
+{
+    int mpiSize = 1;
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const int subStreams = (mpiSize > 1) ? mpiSize / 2 : 1;
+
+    WriteAppendRead("ADIOS2BPWriteAppendReadAggregate1D8.bp",
+                    {{"Aggregators", std::to_string(subStreams)}});
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -6,6 +6,7 @@
 #include <cstring>
 
 #include <iostream>
+#include <numeric> //std::iota
 #include <stdexcept>
 
 #include <adios2.h>
@@ -911,6 +912,113 @@ TEST_F(BPWriteReadTestADIOS2, ADIOS2BPWriteRead2D4x2)
     }
 }
 
+//******************************************************************************
+// 1D 1x300000 data per rank, Threads > 1 share the ADIOS thread pool
+//******************************************************************************
+
+TEST_F(BPWriteReadTestADIOS2, ADIOS2BPWriteReadThreads1D)
+{
+    // large enough for copies and min/max to be split across workers
+    const std::string fname("ADIOS2BPWriteReadThreads1D.bp");
+    const std::string fnameSmall("ADIOS2BPWriteReadThreads1DSmall.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 300000;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    auto lf_Fill = [&](std::vector<double> &r64, const size_t step,
+                       const int rank) {
+        std::iota(r64.begin(), r64.end(),
+                  static_cast<double>(step * 10 + rank * Nx));
+    };
+
+    {
+        // two IOs with different Threads reuse the same workers
+        adios2::IO &io = adios.DeclareIO("TestIO");
+        io.SetParameters({{"Threads", "4"}});
+        io.AddTransport("file");
+
+        adios2::IO &ioSmall = adios.DeclareIO("TestIOSmall");
+        ioSmall.SetParameters({{"Threads", "3"}});
+        ioSmall.AddTransport("file");
+
+        std::vector<double> R64(Nx);
+        std::vector<int32_t> I32(8);
+
+        io.DefineVariable<double>(
+            "r64", {static_cast<size_t>(Nx * mpiSize)},
+            {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims,
+            R64.data());
+
+        // below the minimum chunk, copies stay in the calling thread
+        ioSmall.DefineVariable<int32_t>(
+            "i32", {static_cast<size_t>(8 * mpiSize)},
+            {static_cast<size_t>(8 * mpiRank)}, {8}, adios2::ConstantDims,
+            I32.data());
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+        adios2::Engine &bpWriterSmall =
+            ioSmall.Open(fnameSmall, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            lf_Fill(R64, step, mpiRank);
+            std::iota(I32.begin(), I32.end(), static_cast<int32_t>(step));
+            bpWriter.WriteStep();
+            bpWriterSmall.WriteStep();
+        }
+
+        bpWriter.Close();
+        bpWriterSmall.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        io.SetParameters({{"Threads", "4"}});
+
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        ASSERT_EQ(var_r64->m_AvailableStepsCount, NSteps);
+        ASSERT_EQ(var_r64->m_Shape[0], mpiSize * Nx);
+        EXPECT_EQ(var_r64->m_Min, 0.);
+        EXPECT_EQ(var_r64->m_Max,
+                  static_cast<double>((NSteps - 1) * 10 + mpiSize * Nx - 1));
+
+        var_r64->SetSelection({{mpiRank * Nx}, {Nx}});
+
+        std::vector<double> R64(Nx);
+        std::vector<double> original(Nx);
+
+        for (size_t t = 0; t < NSteps; ++t)
+        {
+            var_r64->SetStepSelection({t, 1});
+            bpReader.GetSync(*var_r64, R64.data());
+
+            lf_Fill(original, t, mpiRank);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(R64[i], original[i]) << "t=" << t << " i=" << i
+                                               << " rank=" << mpiRank;
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
 //******************************************************************************
 // main
 //******************************************************************************
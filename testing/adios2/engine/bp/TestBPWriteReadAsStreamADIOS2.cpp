@@ -1526,6 +1526,597 @@ TEST_F(BPWriteReadAsStreamTestADIOS2, ADIOS2BPWriteRead2D4x2MissingPerformGets)
     }
 }
 
+//******************************************************************************
+// 1D 1x8 test data, AsyncWrite=true
+//******************************************************************************
+
+TEST_F(BPWriteReadAsStreamTestADIOS2, ADIOS2BPWriteReadAsyncWrite1D8)
+{
+    const std::string fname("ADIOS2BPWriteReadAsStreamAsyncWrite1D8.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows
+    const size_t Nx = 8;
+
+    // Number of steps
+    const size_t NSteps = 5;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        io.DefineVariable<int32_t>("i32", shape, start, count,
+                                   adios2::ConstantDims,
+                                   m_TestData.I32.data());
+        io.DefineVariable<double>("r64", shape, start, count,
+                                  adios2::ConstantDims, m_TestData.R64.data());
+
+        io.SetEngine("BPFile");
+        io.SetParameters({{"AsyncWrite", "true"}});
+        io.AddTransport("file");
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            // buffer is reused while previous step is being written
+            UpdateSmallTestData(m_TestData, static_cast<int>(step), mpiRank,
+                                mpiSize);
+            EXPECT_EQ(bpWriter.CurrentStep(), step);
+            bpWriter.WriteStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_NE(var_i32, nullptr);
+        ASSERT_EQ(var_i32->m_AvailableStepsCount, NSteps);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        ASSERT_EQ(var_r64->m_AvailableStepsCount, NSteps);
+
+        std::array<int32_t, Nx> I32;
+        std::array<double, Nx> R64;
+
+        const adios2::Box<adios2::Dims> sel({mpiRank * Nx}, {Nx});
+        var_i32->SetSelection(sel);
+        var_r64->SetSelection(sel);
+
+        unsigned int t = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            EXPECT_EQ(bpReader.CurrentStep(), static_cast<size_t>(t));
+
+            bpReader.GetDeferred(*var_i32, I32.data());
+            bpReader.GetDeferred(*var_r64, R64.data());
+            bpReader.PerformGets();
+            bpReader.EndStep();
+
+            UpdateSmallTestData(m_OriginalData, static_cast<int>(t), mpiRank,
+                                mpiSize);
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                std::stringstream ss;
+                ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+                std::string msg = ss.str();
+
+                EXPECT_EQ(I32[i], m_OriginalData.I32[i]) << msg;
+                EXPECT_EQ(R64[i], m_OriginalData.R64[i]) << msg;
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 1D 1x8 test data, ZeroCopy=true, deferred payloads written from user memory
+//******************************************************************************
+
+TEST_F(BPWriteReadAsStreamTestADIOS2, ADIOS2BPWriteReadZeroCopy1D8)
+{
+    const std::string fname("ADIOS2BPWriteReadAsStreamZeroCopy1D8.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows
+    const size_t Nx = 8;
+
+    // Number of steps
+    const size_t NSteps = 5;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        auto &var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count,
+                                                   adios2::ConstantDims);
+        auto &var_r64 = io.DefineVariable<double>("r64", shape, start, count,
+                                                  adios2::ConstantDims);
+        auto &var_i16 = io.DefineVariable<int16_t>("i16", shape, start, count,
+                                                   adios2::ConstantDims);
+
+        io.SetEngine("BPFile");
+        io.SetParameters({{"ZeroCopy", "true"}});
+        io.AddTransport("file");
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            UpdateSmallTestData(m_TestData, static_cast<int>(step), mpiRank,
+                                mpiSize);
+            EXPECT_EQ(bpWriter.CurrentStep(), step);
+
+            bpWriter.BeginStep();
+            bpWriter.PutDeferred(var_i32, m_TestData.I32.data());
+            // copied payload between payloads left in user memory
+            bpWriter.PutSync(var_i16, m_TestData.I16.data());
+            bpWriter.PutDeferred(var_r64, m_TestData.R64.data());
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_NE(var_i32, nullptr);
+        ASSERT_EQ(var_i32->m_AvailableStepsCount, NSteps);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        ASSERT_EQ(var_r64->m_AvailableStepsCount, NSteps);
+
+        auto var_i16 = io.InquireVariable<int16_t>("i16");
+        ASSERT_NE(var_i16, nullptr);
+        ASSERT_EQ(var_i16->m_AvailableStepsCount, NSteps);
+
+        std::array<int32_t, Nx> I32;
+        std::array<double, Nx> R64;
+        std::array<int16_t, Nx> I16;
+
+        const adios2::Box<adios2::Dims> sel({mpiRank * Nx}, {Nx});
+        var_i32->SetSelection(sel);
+        var_r64->SetSelection(sel);
+        var_i16->SetSelection(sel);
+
+        unsigned int t = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            EXPECT_EQ(bpReader.CurrentStep(), static_cast<size_t>(t));
+
+            bpReader.GetDeferred(*var_i32, I32.data());
+            bpReader.GetDeferred(*var_r64, R64.data());
+            bpReader.GetDeferred(*var_i16, I16.data());
+            bpReader.PerformGets();
+            bpReader.EndStep();
+
+            UpdateSmallTestData(m_OriginalData, static_cast<int>(t), mpiRank,
+                                mpiSize);
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                std::stringstream ss;
+                ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+                std::string msg = ss.str();
+
+                EXPECT_EQ(I32[i], m_OriginalData.I32[i]) << msg;
+                EXPECT_EQ(R64[i], m_OriginalData.R64[i]) << msg;
+                EXPECT_EQ(I16[i], m_OriginalData.I16[i]) << msg;
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 1D test data, BufferChunkSize=1Kb, records and payloads span several chunks
+//******************************************************************************
+
+TEST_F(BPWriteReadAsStreamTestADIOS2, ADIOS2BPWriteReadBufferChunks1D)
+{
+    const std::string fname("ADIOS2BPWriteReadAsStreamBufferChunks1D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows, small variables
+    const size_t Nx = 8;
+    // Number of rows, variables larger than a chunk
+    const size_t NxLarge = 2500;
+
+    // Number of steps
+    const size_t NSteps = 5;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    auto lf_LargeData = [&](const size_t step) {
+        std::vector<double> data(NxLarge);
+        for (size_t i = 0; i < NxLarge; ++i)
+        {
+            data[i] = static_cast<double>(step * 1000 + mpiRank * NxLarge + i);
+        }
+        return data;
+    };
+
+    std::vector<double> attributeArray(200);
+    for (size_t i = 0; i < attributeArray.size(); ++i)
+    {
+        attributeArray[i] = 0.5 * static_cast<double>(i);
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        auto &var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count,
+                                                   adios2::ConstantDims);
+        auto &var_i16 = io.DefineVariable<int16_t>("i16", shape, start, count,
+                                                   adios2::ConstantDims);
+        auto &var_r64 = io.DefineVariable<double>(
+            "r64", {NxLarge * mpiSize}, {NxLarge * mpiRank}, {NxLarge},
+            adios2::ConstantDims);
+
+        // attributes record is larger than a chunk
+        io.DefineAttribute<std::string>("units", "meters");
+        io.DefineAttribute<double>("coefficients", attributeArray.data(),
+                                   attributeArray.size());
+
+        io.SetEngine("BPFile");
+        io.SetParameters({{"BufferChunkSize", "1Kb"}, {"ZeroCopy", "true"}});
+        io.AddTransport("file");
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            UpdateSmallTestData(m_TestData, static_cast<int>(step), mpiRank,
+                                mpiSize);
+            const std::vector<double> r64 = lf_LargeData(step);
+            EXPECT_EQ(bpWriter.CurrentStep(), step);
+
+            bpWriter.BeginStep();
+            bpWriter.PutDeferred(var_i32, m_TestData.I32.data());
+            bpWriter.PutSync(var_r64, r64.data());
+            bpWriter.PutSync(var_i16, m_TestData.I16.data());
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto attr_units = io.InquireAttribute<std::string>("units");
+        ASSERT_NE(attr_units, nullptr);
+        EXPECT_EQ(attr_units->m_DataSingleValue, "meters");
+
+        auto attr_coefficients = io.InquireAttribute<double>("coefficients");
+        ASSERT_NE(attr_coefficients, nullptr);
+        EXPECT_EQ(attr_coefficients->m_DataArray, attributeArray);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_NE(var_i32, nullptr);
+        ASSERT_EQ(var_i32->m_AvailableStepsCount, NSteps);
+
+        auto var_i16 = io.InquireVariable<int16_t>("i16");
+        ASSERT_NE(var_i16, nullptr);
+        ASSERT_EQ(var_i16->m_AvailableStepsCount, NSteps);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        ASSERT_EQ(var_r64->m_AvailableStepsCount, NSteps);
+
+        std::array<int32_t, Nx> I32;
+        std::array<int16_t, Nx> I16;
+        std::vector<double> R64(NxLarge);
+
+        var_i32->SetSelection({{mpiRank * Nx}, {Nx}});
+        var_i16->SetSelection({{mpiRank * Nx}, {Nx}});
+        var_r64->SetSelection({{mpiRank * NxLarge}, {NxLarge}});
+
+        unsigned int t = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            EXPECT_EQ(bpReader.CurrentStep(), static_cast<size_t>(t));
+
+            bpReader.GetDeferred(*var_i32, I32.data());
+            bpReader.GetDeferred(*var_i16, I16.data());
+            bpReader.GetDeferred(*var_r64, R64.data());
+            bpReader.PerformGets();
+            bpReader.EndStep();
+
+            UpdateSmallTestData(m_OriginalData, static_cast<int>(t), mpiRank,
+                                mpiSize);
+            EXPECT_EQ(R64, lf_LargeData(t)) << "t=" << t;
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                std::stringstream ss;
+                ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+                std::string msg = ss.str();
+
+                EXPECT_EQ(I32[i], m_OriginalData.I32[i]) << msg;
+                EXPECT_EQ(I16[i], m_OriginalData.I16[i]) << msg;
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 1D 1x8 test data, reader follows the writer step by step
+//******************************************************************************
+
+TEST_F(BPWriteReadAsStreamTestADIOS2, ADIOS2BPWriteFollowRead1D8)
+{
+    const std::string fname("ADIOS2BPWriteFollowRead1D8.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows
+    const size_t Nx = 8;
+
+    // Number of steps
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    adios2::IO &writeIO = adios.DeclareIO("TestIO");
+    {
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        writeIO.DefineVariable<int32_t>("i32", shape, start, count,
+                                        adios2::ConstantDims,
+                                        m_TestData.I32.data());
+        writeIO.DefineVariable<double>("r64", shape, start, count,
+                                       adios2::ConstantDims,
+                                       m_TestData.R64.data());
+        writeIO.SetEngine("BPFile");
+        writeIO.AddTransport("file");
+    }
+
+    adios2::Engine &bpWriter = writeIO.Open(fname, adios2::Mode::Write);
+
+    UpdateSmallTestData(m_TestData, 0, mpiRank, mpiSize);
+    bpWriter.WriteStep();
+
+    // only the first step is available at Open
+    adios2::IO &readIO = adios.DeclareIO("ReadIO");
+    adios2::Engine &bpReader = readIO.Open(fname, adios2::Mode::Read);
+
+    auto var_i32 = readIO.InquireVariable<int32_t>("i32");
+    ASSERT_NE(var_i32, nullptr);
+    auto var_r64 = readIO.InquireVariable<double>("r64");
+    ASSERT_NE(var_r64, nullptr);
+
+    const adios2::Box<adios2::Dims> sel({mpiRank * Nx}, {Nx});
+    var_i32->SetSelection(sel);
+    var_r64->SetSelection(sel);
+
+    std::array<int32_t, Nx> I32;
+    std::array<double, Nx> R64;
+
+    for (size_t t = 0; t < NSteps; ++t)
+    {
+        if (t > 0)
+        {
+            // nothing new until the writer ends its next step
+            EXPECT_EQ(bpReader.BeginStep(adios2::StepMode::NextAvailable, 0.f),
+                      adios2::StepStatus::NotReady);
+
+            UpdateSmallTestData(m_TestData, static_cast<int>(t), mpiRank,
+                                mpiSize);
+            bpWriter.WriteStep();
+        }
+
+        ASSERT_EQ(bpReader.BeginStep(adios2::StepMode::NextAvailable, 1.f),
+                  adios2::StepStatus::OK);
+        EXPECT_EQ(bpReader.CurrentStep(), t);
+        EXPECT_EQ(var_i32->m_AvailableStepsCount, t + 1);
+
+        bpReader.GetDeferred(*var_i32, I32.data());
+        bpReader.GetDeferred(*var_r64, R64.data());
+        bpReader.EndStep();
+
+        UpdateSmallTestData(m_OriginalData, static_cast<int>(t), mpiRank,
+                            mpiSize);
+
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            std::stringstream ss;
+            ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+            std::string msg = ss.str();
+
+            EXPECT_EQ(I32[i], m_OriginalData.I32[i]) << msg;
+            EXPECT_EQ(R64[i], m_OriginalData.R64[i]) << msg;
+        }
+    }
+
+    bpWriter.Close();
+
+    // waits for the end of stream record
+    EXPECT_EQ(bpReader.BeginStep(adios2::StepMode::NextAvailable, -1.f),
+              adios2::StepStatus::EndOfStream);
+    bpReader.Close();
+}
+
+#ifndef _WIN32
+//******************************************************************************
+// 1D 1x8 test data, reader follows the writer with mapped sub-files that grow
+// after they are first read
+//******************************************************************************
+
+TEST_F(BPWriteReadAsStreamTestADIOS2, ADIOS2BPWriteFollowReadMMap1D8)
+{
+    const std::string fname("ADIOS2BPWriteFollowReadMMap1D8.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows
+    const size_t Nx = 8;
+
+    // Number of steps
+    const size_t NSteps = 4;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    adios2::IO &writeIO = adios.DeclareIO("TestIO");
+    {
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        writeIO.DefineVariable<int32_t>("i32", shape, start, count,
+                                        adios2::ConstantDims,
+                                        m_TestData.I32.data());
+        writeIO.DefineVariable<double>("r64", shape, start, count,
+                                       adios2::ConstantDims,
+                                       m_TestData.R64.data());
+        writeIO.SetEngine("BPFile");
+        writeIO.AddTransport("file");
+    }
+
+    adios2::Engine &bpWriter = writeIO.Open(fname, adios2::Mode::Write);
+
+    UpdateSmallTestData(m_TestData, 0, mpiRank, mpiSize);
+    bpWriter.WriteStep();
+
+    adios2::IO &readIO = adios.DeclareIO("ReadIO");
+    readIO.AddTransport("file", {{"Library", "mmap"}});
+    adios2::Engine &bpReader = readIO.Open(fname, adios2::Mode::Read);
+
+    auto var_i32 = readIO.InquireVariable<int32_t>("i32");
+    ASSERT_NE(var_i32, nullptr);
+    auto var_r64 = readIO.InquireVariable<double>("r64");
+    ASSERT_NE(var_r64, nullptr);
+
+    const adios2::Box<adios2::Dims> sel({mpiRank * Nx}, {Nx});
+    var_i32->SetSelection(sel);
+    var_r64->SetSelection(sel);
+
+    std::array<int32_t, Nx> I32;
+    std::array<double, Nx> R64;
+
+    for (size_t t = 0; t < NSteps; ++t)
+    {
+        if (t > 0)
+        {
+            // sub-files were mapped when step t - 1 was read
+            UpdateSmallTestData(m_TestData, static_cast<int>(t), mpiRank,
+                                mpiSize);
+            bpWriter.WriteStep();
+        }
+
+        ASSERT_EQ(bpReader.BeginStep(adios2::StepMode::NextAvailable, 1.f),
+                  adios2::StepStatus::OK);
+        EXPECT_EQ(bpReader.CurrentStep(), t);
+
+        bpReader.GetDeferred(*var_i32, I32.data());
+        bpReader.GetDeferred(*var_r64, R64.data());
+        bpReader.EndStep();
+
+        UpdateSmallTestData(m_OriginalData, static_cast<int>(t), mpiRank,
+                            mpiSize);
+
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            std::stringstream ss;
+            ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+            std::string msg = ss.str();
+
+            EXPECT_EQ(I32[i], m_OriginalData.I32[i]) << msg;
+            EXPECT_EQ(R64[i], m_OriginalData.R64[i]) << msg;
+        }
+    }
+
+    bpWriter.Close();
+
+    EXPECT_EQ(bpReader.BeginStep(adios2::StepMode::NextAvailable, -1.f),
+              adios2::StepStatus::EndOfStream);
+    bpReader.Close();
+}
+#endif
+
 //******************************************************************************
 // main
 //******************************************************************************
@@ -0,0 +1,509 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <algorithm> //std::fill, std::min
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class BPWriteReadBlocksTestADIOS2 : public ::testing::Test
+{
+public:
+    BPWriteReadBlocksTestADIOS2() = default;
+};
+
+//******************************************************************************
+// 2D (8*5*mpiSize)x(8*5) global array, each rank writes 8x8 blocks of 5x5
+//******************************************************************************
+
+TEST_F(BPWriteReadBlocksTestADIOS2, ADIOS2BPWriteReadManyBlocks2D)
+{
+    const std::string fname("ADIOS2BPWriteReadManyBlocks2D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+
+    // blocks per rank in each dimension and block size
+    const size_t NBlocks = 8;
+    const size_t Nb = 5;
+    const size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t Ny = NBlocks * Nb * static_cast<size_t>(mpiSize);
+    const size_t Nx = NBlocks * Nb;
+
+    // value from global coordinates, so any selection can be checked
+    auto lf_Value = [&](const size_t step, const size_t j, const size_t i) {
+        return static_cast<int32_t>(step * 100000 + j * Nx + i);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+        io.AddTransport("file");
+
+        auto &var_i32 = io.DefineVariable<int32_t>("i32", {Ny, Nx});
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<int32_t> block(Nb * Nb);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t by = 0; by < NBlocks; ++by)
+            {
+                for (size_t bx = 0; bx < NBlocks; ++bx)
+                {
+                    const size_t y0 = (mpiRank * NBlocks + by) * Nb;
+                    const size_t x0 = bx * Nb;
+                    for (size_t j = 0; j < Nb; ++j)
+                    {
+                        for (size_t i = 0; i < Nb; ++i)
+                        {
+                            block[j * Nb + i] = lf_Value(step, y0 + j, x0 + i);
+                        }
+                    }
+                    var_i32.SetSelection({{y0, x0}, {Nb, Nb}});
+                    bpWriter.PutSync(var_i32, block.data());
+                }
+            }
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_NE(var_i32, nullptr);
+        ASSERT_EQ(var_i32->m_AvailableStepsCount, NSteps);
+        ASSERT_EQ(var_i32->m_Shape[0], Ny);
+        ASSERT_EQ(var_i32->m_Shape[1], Nx);
+
+        // inside a block, across blocks, a single point, a full row, all
+        const std::vector<adios2::Box<adios2::Dims>> selections = {
+            {{1, 1}, {3, 3}},
+            {{Nb - 2, Nb + 3}, {Nb + 4, 2 * Nb + 1}},
+            {{Ny - 1, Nx - 1}, {1, 1}},
+            {{Ny / 2, 0}, {1, Nx}},
+            {{0, 0}, {Ny, Nx}}};
+
+        for (const auto &selection : selections)
+        {
+            const adios2::Dims &start = selection.first;
+            const adios2::Dims &count = selection.second;
+            std::vector<int32_t> I32(count[0] * count[1]);
+
+            var_i32->SetSelection(selection);
+
+            for (size_t step = 0; step < NSteps; ++step)
+            {
+                var_i32->SetStepSelection({step, 1});
+                bpReader.GetSync(*var_i32, I32.data());
+
+                for (size_t j = 0; j < count[0]; ++j)
+                {
+                    for (size_t i = 0; i < count[1]; ++i)
+                    {
+                        ASSERT_EQ(I32[j * count[1] + i],
+                                  lf_Value(step, start[0] + j, start[1] + i))
+                            << "step=" << step << " j=" << start[0] + j
+                            << " i=" << start[1] + i << " rank=" << mpiRank;
+                    }
+                }
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 1D (8*10*mpiSize) global array, blocks are read only if their min/max
+// overlap the variable value selection
+//******************************************************************************
+
+TEST_F(BPWriteReadBlocksTestADIOS2, ADIOS2BPWriteReadValueSelection1D)
+{
+    const std::string fname("ADIOS2BPWriteReadValueSelection1D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+
+    const size_t NBlocks = 8;
+    const size_t Nb = 10;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t blocks = NBlocks * static_cast<size_t>(mpiSize);
+    const size_t Nx = blocks * Nb;
+
+    // global block g has values in [1000 * g, 1000 * g + Nb - 1]
+    auto lf_Value = [&](const size_t i) {
+        return static_cast<double>(1000 * (i / Nb) + i % Nb);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+        io.AddTransport("file");
+
+        auto &var_r64 = io.DefineVariable<double>("r64", {Nx});
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> block(Nb);
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            const size_t x0 = (mpiRank * NBlocks + b) * Nb;
+            for (size_t i = 0; i < Nb; ++i)
+            {
+                block[i] = lf_Value(x0 + i);
+            }
+            var_r64.SetSelection({{x0}, {Nb}});
+            bpWriter.PutSync(var_r64, block.data());
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        ASSERT_EQ(var_r64->m_Shape[0], Nx);
+
+        EXPECT_THROW(var_r64->SetValueSelection(2.0, 1.0),
+                     std::invalid_argument);
+
+        const double sentinel = -1.0;
+        std::vector<double> R64(Nx, sentinel);
+
+        // overlaps the tail of block 2 and the head of block 4 only
+        const double min = 2005.0;
+        const double max = 4000.0;
+        const size_t lastBlock = std::min<size_t>(blocks - 1, 4);
+
+        var_r64->SetSelection({{0}, {Nx}});
+        var_r64->SetValueSelection(min, max);
+        bpReader.GetSync(*var_r64, R64.data());
+
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            const size_t g = i / Nb;
+            if (g >= 2 && g <= lastBlock)
+            {
+                ASSERT_EQ(R64[i], lf_Value(i)) << "i=" << i;
+            }
+            else
+            {
+                ASSERT_EQ(R64[i], sentinel) << "i=" << i;
+            }
+        }
+
+        // no block in range, nothing is read
+        std::fill(R64.begin(), R64.end(), sentinel);
+        var_r64->SetValueSelection(2010.0, 2999.0);
+        bpReader.GetSync(*var_r64, R64.data());
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            ASSERT_EQ(R64[i], sentinel) << "i=" << i;
+        }
+
+        var_r64->RemoveValueSelection();
+        bpReader.GetSync(*var_r64, R64.data());
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            ASSERT_EQ(R64[i], lf_Value(i)) << "i=" << i;
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 3D (16*mpiSize)x16x16 global array, planes and pencils read only the
+// contiguous pieces of each block
+//******************************************************************************
+
+TEST_F(BPWriteReadBlocksTestADIOS2, ADIOS2BPWriteReadSlices3D)
+{
+    const std::string fname("ADIOS2BPWriteReadSlices3D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+
+    const size_t Nb = 16;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t Nz = Nb * static_cast<size_t>(mpiSize);
+
+    auto lf_Value = [&](const size_t k, const size_t j, const size_t i) {
+        return static_cast<double>((k * Nb + j) * Nb + i);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+        io.AddTransport("file");
+
+        const size_t z0 = mpiRank * Nb;
+        auto &var_r64 = io.DefineVariable<double>("r64", {Nz, Nb, Nb},
+                                                  {z0, 0, 0}, {Nb, Nb, Nb});
+
+        std::vector<double> block(Nb * Nb * Nb);
+        for (size_t k = 0; k < Nb; ++k)
+        {
+            for (size_t j = 0; j < Nb; ++j)
+            {
+                for (size_t i = 0; i < Nb; ++i)
+                {
+                    block[(k * Nb + j) * Nb + i] = lf_Value(z0 + k, j, i);
+                }
+            }
+        }
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.PutSync(var_r64, block.data());
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        // no gaps are read, every run is a separate read
+        io.SetParameters({{"ReadGapSize", "0Kb"}});
+
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+
+        // z-plane, y-plane, x-plane, pencils along z and x, sub-cube
+        const std::vector<adios2::Box<adios2::Dims>> selections = {
+            {{Nz / 2, 0, 0}, {1, Nb, Nb}},
+            {{0, 3, 0}, {Nz, 1, Nb}},
+            {{0, 0, Nb - 1}, {Nz, Nb, 1}},
+            {{0, 5, 7}, {Nz, 1, 1}},
+            {{Nz - 1, 2, 0}, {1, 1, Nb}},
+            {{1, 2, 3}, {Nz - 2, 4, 5}}};
+
+        for (const auto &selection : selections)
+        {
+            const adios2::Dims &start = selection.first;
+            const adios2::Dims &count = selection.second;
+            std::vector<double> R64(count[0] * count[1] * count[2]);
+
+            var_r64->SetSelection(selection);
+            bpReader.GetSync(*var_r64, R64.data());
+
+            for (size_t k = 0; k < count[0]; ++k)
+            {
+                for (size_t j = 0; j < count[1]; ++j)
+                {
+                    for (size_t i = 0; i < count[2]; ++i)
+                    {
+                        ASSERT_EQ(R64[(k * count[1] + j) * count[2] + i],
+                                  lf_Value(start[0] + k, start[1] + j,
+                                           start[2] + i))
+                            << "k=" << start[0] + k << " j=" << start[1] + j
+                            << " i=" << start[2] + i << " rank=" << mpiRank;
+                    }
+                }
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 2D (Ny*mpiSize)xNx global array, each rank puts a block surrounded by ghost
+// cells with a memory selection, read back into padded memory
+//******************************************************************************
+
+TEST_F(BPWriteReadBlocksTestADIOS2, ADIOS2BPWriteReadMemorySelection2D)
+{
+    const std::string fname("ADIOS2BPWriteReadMemorySelection2D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+
+    const size_t Ny = 6;
+    const size_t Nx = 10;
+    const size_t ghosts = 1;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t NyGlobal = Ny * static_cast<size_t>(mpiSize);
+
+    auto lf_Value = [&](const size_t j, const size_t i) {
+        return static_cast<double>(j * Nx + i);
+    };
+
+    // ghost cells are out of the data range, they must not reach stats
+    const double ghost = -1.0e9;
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+        io.AddTransport("file");
+
+        const size_t y0 = mpiRank * Ny;
+        auto &var_r64 = io.DefineVariable<double>("r64", {NyGlobal, Nx},
+                                                  {y0, 0}, {Ny, Nx});
+        auto &var_i32 = io.DefineVariable<int32_t>("i32", {NyGlobal, Nx},
+                                                   {y0, 0}, {Ny, Nx});
+
+        const size_t memoryNy = Ny + 2 * ghosts;
+        const size_t memoryNx = Nx + 2 * ghosts;
+        std::vector<double> r64(memoryNy * memoryNx, ghost);
+        std::vector<int32_t> i32(memoryNy * memoryNx, -1);
+        for (size_t j = 0; j < Ny; ++j)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                const size_t index = (j + ghosts) * memoryNx + i + ghosts;
+                r64[index] = lf_Value(y0 + j, i);
+                i32[index] = static_cast<int32_t>(lf_Value(y0 + j, i));
+            }
+        }
+
+        var_r64.SetMemorySelection({{ghosts, ghosts}, {memoryNy, memoryNx}});
+        var_i32.SetMemorySelection({{ghosts, ghosts}, {memoryNy, memoryNx}});
+
+        EXPECT_THROW(var_i32.SetMemorySelection({{ghosts}, {memoryNx}}),
+                     std::invalid_argument);
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.PutSync(var_r64, r64.data());
+        bpWriter.PutDeferred(var_i32, i32.data());
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_NE(var_i32, nullptr);
+
+        EXPECT_EQ(var_r64->m_Min, 0.);
+        EXPECT_EQ(var_r64->m_Max, lf_Value(NyGlobal - 1, Nx - 1));
+        EXPECT_EQ(var_i32->m_Min, 0);
+
+        // global array in padded memory, ghosts keep the sentinel
+        const size_t memoryNy = NyGlobal + 2 * ghosts;
+        const size_t memoryNx = Nx + 2 * ghosts;
+        std::vector<double> R64(memoryNy * memoryNx, ghost);
+        std::vector<int32_t> I32(memoryNy * memoryNx, -1);
+
+        var_r64->SetSelection({{0, 0}, {NyGlobal, Nx}});
+        var_r64->SetMemorySelection({{ghosts, ghosts}, {memoryNy, memoryNx}});
+        bpReader.GetSync(*var_r64, R64.data());
+
+        // sub-selection at the top right corner of the memory block
+        const size_t subNy = 3;
+        const size_t subNx = 4;
+        var_i32->SetSelection({{1, Nx - subNx}, {subNy, subNx}});
+        var_i32->SetMemorySelection({{0, memoryNx - subNx}, {subNy, memoryNx}});
+        bpReader.GetSync(*var_i32, I32.data());
+
+        for (size_t j = 0; j < memoryNy; ++j)
+        {
+            for (size_t i = 0; i < memoryNx; ++i)
+            {
+                const size_t index = j * memoryNx + i;
+                const bool isGhost = j < ghosts || j >= NyGlobal + ghosts ||
+                                     i < ghosts || i >= Nx + ghosts;
+                if (isGhost)
+                {
+                    ASSERT_EQ(R64[index], ghost) << "j=" << j << " i=" << i;
+                }
+                else
+                {
+                    ASSERT_EQ(R64[index], lf_Value(j - ghosts, i - ghosts))
+                        << "j=" << j << " i=" << i;
+                }
+
+                if (j < subNy && i >= memoryNx - subNx)
+                {
+                    ASSERT_EQ(I32[index],
+                              static_cast<int32_t>(
+                                  lf_Value(1 + j, i + Nx - memoryNx)))
+                        << "j=" << j << " i=" << i;
+                }
+                else
+                {
+                    ASSERT_EQ(I32[index], -1) << "j=" << j << " i=" << i;
+                }
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
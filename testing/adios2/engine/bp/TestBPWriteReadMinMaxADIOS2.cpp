@@ -0,0 +1,317 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <algorithm> //std::minmax_element, std::min, std::max
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class BPWriteReadMinMaxTestADIOS2 : public ::testing::Test
+{
+public:
+    BPWriteReadMinMaxTestADIOS2() = default;
+
+    /** Nx is not a multiple of any vector width, exercises kernel tails */
+    static constexpr size_t Nx = 1003;
+};
+
+constexpr size_t BPWriteReadMinMaxTestADIOS2::Nx;
+
+namespace
+{
+
+/**
+ * Deterministic values per rank, the extremes of each rank are placed in the
+ * middle, the last element (vector tail) and the first element
+ */
+template <class T>
+std::vector<T> GenerateData(const size_t size, const int rank)
+{
+    std::vector<T> data(size);
+    uint64_t state = 12345 + static_cast<uint64_t>(rank) * 7919;
+    for (size_t i = 0; i < size; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        // small range avoids overflows in narrow types
+        data[i] = static_cast<T>(static_cast<int>((state >> 33) % 100) - 40);
+    }
+
+    data[size / 2] = std::numeric_limits<T>::max() - static_cast<T>(rank);
+    data[size - 1] = std::numeric_limits<T>::lowest() + static_cast<T>(rank);
+    data[0] = static_cast<T>(rank % 2);
+    return data;
+}
+
+template <class T>
+void GetExpectedMinMax(const int mpiSize, T &min, T &max)
+{
+    for (int rank = 0; rank < mpiSize; ++rank)
+    {
+        const std::vector<T> data = GenerateData<T>(
+            BPWriteReadMinMaxTestADIOS2::Nx, rank);
+        const auto bounds = std::minmax_element(data.begin(), data.end());
+        if (rank == 0 || *bounds.first < min)
+        {
+            min = *bounds.first;
+        }
+        if (rank == 0 || *bounds.second > max)
+        {
+            max = *bounds.second;
+        }
+    }
+}
+
+template <class T>
+void DefineAndPut(adios2::IO &io, adios2::Engine &engine,
+                  const std::string &name, const std::vector<T> &data,
+                  const int mpiRank, const int mpiSize)
+{
+    const size_t Nx = BPWriteReadMinMaxTestADIOS2::Nx;
+    auto &variable = io.DefineVariable<T>(
+        name, {static_cast<size_t>(mpiSize) * Nx},
+        {static_cast<size_t>(mpiRank) * Nx}, {Nx}, adios2::ConstantDims);
+    engine.PutSync(variable, data.data());
+}
+
+template <class T>
+void CheckMinMax(adios2::IO &io, const std::string &name, const int mpiSize)
+{
+    auto variable = io.InquireVariable<T>(name);
+    ASSERT_NE(variable, nullptr) << name;
+
+    T min, max;
+    GetExpectedMinMax(mpiSize, min, max);
+    EXPECT_EQ(variable->m_Min, min) << name;
+    EXPECT_EQ(variable->m_Max, max) << name;
+}
+
+} // end anonymous namespace
+
+//******************************************************************************
+// 1D 1x1003 per rank, min and max of all primitive types
+//******************************************************************************
+
+TEST_F(BPWriteReadMinMaxTestADIOS2, ADIOS2BPWriteReadMinMax1D)
+{
+    const std::string fname("ADIOS2BPWriteReadMinMax1D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    const auto i8 = GenerateData<int8_t>(Nx, mpiRank);
+    const auto i16 = GenerateData<int16_t>(Nx, mpiRank);
+    const auto i32 = GenerateData<int32_t>(Nx, mpiRank);
+    const auto i64 = GenerateData<int64_t>(Nx, mpiRank);
+    const auto u8 = GenerateData<uint8_t>(Nx, mpiRank);
+    const auto u16 = GenerateData<uint16_t>(Nx, mpiRank);
+    const auto u32 = GenerateData<uint32_t>(Nx, mpiRank);
+    const auto u64 = GenerateData<uint64_t>(Nx, mpiRank);
+    const auto r32 = GenerateData<float>(Nx, mpiRank);
+    const auto r64 = GenerateData<double>(Nx, mpiRank);
+
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+        io.SetEngine("BPFile");
+        // sums add a bitmap and stat record to characteristics
+        io.SetParameters({{"StatsSum", "On"}});
+        io.AddTransport("file");
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        DefineAndPut(io, bpWriter, "i8", i8, mpiRank, mpiSize);
+        DefineAndPut(io, bpWriter, "i16", i16, mpiRank, mpiSize);
+        DefineAndPut(io, bpWriter, "i32", i32, mpiRank, mpiSize);
+        DefineAndPut(io, bpWriter, "i64", i64, mpiRank, mpiSize);
+        DefineAndPut(io, bpWriter, "u8", u8, mpiRank, mpiSize);
+        DefineAndPut(io, bpWriter, "u16", u16, mpiRank, mpiSize);
+        DefineAndPut(io, bpWriter, "u32", u32, mpiRank, mpiSize);
+        DefineAndPut(io, bpWriter, "u64", u64, mpiRank, mpiSize);
+        DefineAndPut(io, bpWriter, "r32", r32, mpiRank, mpiSize);
+        DefineAndPut(io, bpWriter, "r64", r64, mpiRank, mpiSize);
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        CheckMinMax<int8_t>(io, "i8", mpiSize);
+        CheckMinMax<int16_t>(io, "i16", mpiSize);
+        CheckMinMax<int32_t>(io, "i32", mpiSize);
+        CheckMinMax<int64_t>(io, "i64", mpiSize);
+        CheckMinMax<uint8_t>(io, "u8", mpiSize);
+        CheckMinMax<uint16_t>(io, "u16", mpiSize);
+        CheckMinMax<uint32_t>(io, "u32", mpiSize);
+        CheckMinMax<uint64_t>(io, "u64", mpiSize);
+        CheckMinMax<float>(io, "r32", mpiSize);
+        CheckMinMax<double>(io, "r64", mpiSize);
+
+        // payloads are still found after the extra characteristics
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        var_r64->SetSelection({{static_cast<size_t>(mpiRank) * Nx}, {Nx}});
+
+        std::vector<double> R64(Nx);
+        bpReader.GetSync(*var_r64, R64.data());
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            EXPECT_EQ(R64[i], r64[i]) << "i=" << i << " rank=" << mpiRank;
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 1D floating point data with NaN values in the first element, the middle and
+// the vector tail, NaN values are skipped by min and max
+//******************************************************************************
+
+namespace
+{
+
+template <class T>
+std::vector<T> GenerateNaNData(const size_t size, const int rank)
+{
+    std::vector<T> data(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<T>(static_cast<int>(i % 17) - 8 + rank);
+    }
+
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    data[0] = nan;
+    data[size / 2] = nan;
+    data[size - 2] = nan;
+    return data;
+}
+
+template <class T>
+void CheckNaNMinMax(adios2::IO &io, const std::string &name, const size_t size,
+                    const int mpiSize)
+{
+    auto variable = io.InquireVariable<T>(name);
+    ASSERT_NE(variable, nullptr) << name;
+
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+    for (int rank = 0; rank < mpiSize; ++rank)
+    {
+        for (const T value : GenerateNaNData<T>(size, rank))
+        {
+            if (value == value)
+            {
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+        }
+    }
+
+    EXPECT_EQ(variable->m_Min, min) << name;
+    EXPECT_EQ(variable->m_Max, max) << name;
+}
+
+} // end anonymous namespace
+
+TEST_F(BPWriteReadMinMaxTestADIOS2, ADIOS2BPWriteReadMinMaxNaN1D)
+{
+    const std::string fname("ADIOS2BPWriteReadMinMaxNaN1D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    // scalar path, one vector step, vector tails
+    const std::vector<size_t> sizes = {5, 32, 37, Nx};
+
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+        io.SetEngine("BPFile");
+        io.AddTransport("file");
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (const size_t size : sizes)
+        {
+            const std::string suffix = "_" + std::to_string(size);
+            const auto r32 = GenerateNaNData<float>(size, mpiRank);
+            const auto r64 = GenerateNaNData<double>(size, mpiRank);
+
+            auto &var_r32 = io.DefineVariable<float>(
+                "r32" + suffix, {static_cast<size_t>(mpiSize) * size},
+                {static_cast<size_t>(mpiRank) * size}, {size},
+                adios2::ConstantDims);
+            auto &var_r64 = io.DefineVariable<double>(
+                "r64" + suffix, {static_cast<size_t>(mpiSize) * size},
+                {static_cast<size_t>(mpiRank) * size}, {size},
+                adios2::ConstantDims);
+            bpWriter.PutSync(var_r32, r32.data());
+            bpWriter.PutSync(var_r64, r64.data());
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        for (const size_t size : sizes)
+        {
+            const std::string suffix = "_" + std::to_string(size);
+            CheckNaNMinMax<float>(io, "r32" + suffix, size, mpiSize);
+            CheckNaNMinMax<double>(io, "r64" + suffix, size, mpiSize);
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
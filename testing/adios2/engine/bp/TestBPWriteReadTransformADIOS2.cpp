@@ -0,0 +1,389 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <functional>
+#include <iostream>
+#include <numeric> //std::iota
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class BPWriteReadTransformTestADIOS2 : public ::testing::Test
+{
+public:
+    BPWriteReadTransformTestADIOS2() = default;
+};
+
+//******************************************************************************
+// 1D 1x1000 and 2D 10x100 data per rank, BZip2 applied per block
+//******************************************************************************
+
+TEST_F(BPWriteReadTransformTestADIOS2, ADIOS2BPWriteReadBZip2)
+{
+    const std::string fname("ADIOS2BPWriteReadBZip2.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows
+    const size_t Nx = 1000;
+    // 2D is Ny x Nx2
+    const size_t Ny = 10;
+    const size_t Nx2 = 100;
+
+    // Number of steps
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    // smooth data, compressible
+    auto lf_Fill = [&](std::vector<int32_t> &i32, std::vector<double> &r64,
+                       const size_t step, const int rank) {
+        std::iota(i32.begin(), i32.end(),
+                  static_cast<int32_t>(step * 10 + rank * Nx));
+        for (size_t i = 0; i < r64.size(); ++i)
+        {
+            r64[i] = static_cast<double>(step + rank) + 0.5 * (i / Nx2);
+        }
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    adios2::Operator &bzip2Op = adios.DefineOperator("BZip2Op", "BZip2");
+
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+
+        std::vector<int32_t> I32(Nx);
+        std::vector<double> R64(Ny * Nx2);
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        auto &var_i32 = io.DefineVariable<int32_t>(
+            "i32", shape, start, count, adios2::ConstantDims, I32.data());
+
+        const adios2::Dims shape2{Ny, static_cast<size_t>(Nx2 * mpiSize)};
+        const adios2::Dims start2{0, static_cast<size_t>(Nx2 * mpiRank)};
+        const adios2::Dims count2{Ny, Nx2};
+
+        auto &var_r64 = io.DefineVariable<double>(
+            "r64_2d", shape2, start2, count2, adios2::ConstantDims, R64.data());
+
+        var_i32.AddTransform(bzip2Op, {{"BlockSize100K", "9"}});
+        var_r64.AddTransform(bzip2Op);
+
+        io.SetEngine("BPFile");
+        io.AddTransport("file");
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            lf_Fill(I32, R64, step, mpiRank);
+            EXPECT_EQ(bpWriter.CurrentStep(), step);
+            bpWriter.WriteStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_NE(var_i32, nullptr);
+        ASSERT_EQ(var_i32->m_AvailableStepsCount, NSteps);
+        ASSERT_EQ(var_i32->m_Shape[0], mpiSize * Nx);
+
+        auto var_r64 = io.InquireVariable<double>("r64_2d");
+        ASSERT_NE(var_r64, nullptr);
+        ASSERT_EQ(var_r64->m_AvailableStepsCount, NSteps);
+        ASSERT_EQ(var_r64->m_Shape[0], Ny);
+        ASSERT_EQ(var_r64->m_Shape[1], static_cast<size_t>(mpiSize * Nx2));
+
+        // read a part of the neighbor's block
+        const size_t readRank = static_cast<size_t>((mpiRank + 1) % mpiSize);
+        const size_t offset = 10;
+        const size_t offset2 = 3;
+
+        std::vector<int32_t> I32(Nx - 2 * offset);
+        std::vector<double> R64((Ny - 2) * (Nx2 - 2 * offset2));
+
+        var_i32->SetSelection({{readRank * Nx + offset}, {Nx - 2 * offset}});
+        var_r64->SetSelection({{1, readRank * Nx2 + offset2},
+                               {Ny - 2, Nx2 - 2 * offset2}});
+
+        std::vector<int32_t> originalI32(Nx);
+        std::vector<double> originalR64(Ny * Nx2);
+
+        unsigned int t = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            EXPECT_EQ(bpReader.CurrentStep(), static_cast<size_t>(t));
+
+            bpReader.GetDeferred(*var_i32, I32.data());
+            bpReader.GetDeferred(*var_r64, R64.data());
+            bpReader.PerformGets();
+            bpReader.EndStep();
+
+            lf_Fill(originalI32, originalR64, t, static_cast<int>(readRank));
+
+            for (size_t i = 0; i < I32.size(); ++i)
+            {
+                std::stringstream ss;
+                ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+                std::string msg = ss.str();
+
+                EXPECT_EQ(I32[i], originalI32[i + offset]) << msg;
+            }
+
+            for (size_t j = 0; j < Ny - 2; ++j)
+            {
+                for (size_t i = 0; i < Nx2 - 2 * offset2; ++i)
+                {
+                    std::stringstream ss;
+                    ss << "t=" << t << " j=" << j << " i=" << i
+                       << " rank=" << mpiRank;
+                    std::string msg = ss.str();
+
+                    EXPECT_EQ(R64[j * (Nx2 - 2 * offset2) + i],
+                              originalR64[(j + 1) * Nx2 + i + offset2])
+                        << msg;
+                }
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 1D (NBlocks*Nb*mpiSize) array, each rank writes many small BZip2 blocks
+// into 1Kb buffer chunks, so the index size estimate drives each resize
+//******************************************************************************
+
+TEST_F(BPWriteReadTransformTestADIOS2, ADIOS2BPWriteReadBZip2ManyBlocks)
+{
+    const std::string fname("ADIOS2BPWriteReadBZip2ManyBlocks.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t NBlocks = 64;
+    const size_t Nb = 6;
+    const size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t Nx = NBlocks * Nb * static_cast<size_t>(mpiSize);
+
+    auto lf_Value = [](const size_t step, const size_t i) {
+        return static_cast<double>(step) * 0.5 + static_cast<double>(i / 3);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    adios2::Operator &bzip2Op = adios.DefineOperator("BZip2Op", "BZip2");
+
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+        io.SetParameters({{"BufferChunkSize", "1Kb"}});
+        io.AddTransport("file");
+
+        auto &var_r64 = io.DefineVariable<double>("r64", {Nx});
+        // parameters are stored in each block transform record
+        var_r64.AddTransform(bzip2Op, {{"BlockSize100K", "9"},
+                                       {"Verbosity", "0"},
+                                       {"WorkFactor", "30"}});
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> block(Nb);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                const size_t x0 = (mpiRank * NBlocks + b) * Nb;
+                for (size_t i = 0; i < Nb; ++i)
+                {
+                    block[i] = lf_Value(step, x0 + i);
+                }
+                var_r64.SetSelection({{x0}, {Nb}});
+                bpWriter.PutSync(var_r64, block.data());
+            }
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_r64, nullptr);
+        ASSERT_EQ(var_r64->m_AvailableStepsCount, NSteps);
+        ASSERT_EQ(var_r64->m_Shape[0], Nx);
+
+        // across block boundaries of this rank and the whole array
+        const size_t x0 = mpiRank * NBlocks * Nb + Nb / 2;
+        const std::vector<adios2::Box<adios2::Dims>> selections = {
+            {{x0}, {4 * Nb}}, {{0}, {Nx}}};
+
+        for (const auto &selection : selections)
+        {
+            const size_t start = selection.first[0];
+            const size_t count = selection.second[0];
+            std::vector<double> R64(count);
+
+            var_r64->SetSelection(selection);
+
+            for (size_t step = 0; step < NSteps; ++step)
+            {
+                var_r64->SetStepSelection({step, 1});
+                bpReader.GetSync(*var_r64, R64.data());
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    ASSERT_EQ(R64[i], lf_Value(step, start + i))
+                        << "step=" << step << " i=" << start + i
+                        << " rank=" << mpiRank;
+                }
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 1D 1x100 float data per rank with a callback operator, which BP3 does not
+// apply: the payload is written untransformed
+//******************************************************************************
+
+TEST_F(BPWriteReadTransformTestADIOS2, ADIOS2BPWriteReadCallbackOperator)
+{
+    const std::string fname("ADIOS2BPWriteReadCallbackOperator.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    adios2::Operator &callbackOp = adios.DefineOperator(
+        "PrintR32", std::function<void(const float *, const std::string &,
+                                       const std::string &, const std::string &,
+                                       const adios2::Dims &)>(
+                        [](const float *, const std::string &,
+                           const std::string &, const std::string &,
+                           const adios2::Dims &) {}));
+
+    {
+        adios2::IO &io = adios.DeclareIO("TestIO");
+        io.AddTransport("file");
+
+        std::vector<float> R32(Nx);
+
+        auto &var_r32 = io.DefineVariable<float>(
+            "r32", {static_cast<size_t>(Nx * mpiSize)},
+            {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+        var_r32.AddTransform(callbackOp);
+
+        adios2::Engine &bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(R32.begin(), R32.end(),
+                      static_cast<float>(step * 1000 + mpiRank * Nx));
+            bpWriter.BeginStep();
+            bpWriter.PutSync(var_r32, R32.data());
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        adios2::Engine &bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r32 = io.InquireVariable<float>("r32");
+        ASSERT_NE(var_r32, nullptr);
+        ASSERT_EQ(var_r32->m_AvailableStepsCount, NSteps);
+
+        std::vector<float> R32(Nx);
+        var_r32->SetSelection({{static_cast<size_t>(Nx * mpiRank)}, {Nx}});
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            var_r32->SetStepSelection({step, 1});
+            bpReader.GetSync(*var_r32, R32.data());
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(R32[i],
+                          static_cast<float>(step * 1000 + mpiRank * Nx + i))
+                    << "step=" << step << " i=" << i << " rank=" << mpiRank;
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,267 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestDataManSegments.cpp : rebuilds DataMan buffers sent as segments over
+ * in-process channels that can lose or truncate messages
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "adios2/toolkit/transport/Transport.h"
+#include "adios2/toolkit/transportman/dataman/DataMan.h"
+
+namespace
+{
+
+/** in-process channel, each Write is one message like a zmq frame, IRead
+ * returns one message or times out */
+class LoopbackTransport : public adios2::Transport
+{
+public:
+    LoopbackTransport()
+    : adios2::Transport("Loopback", "test", MPI_COMM_SELF, true)
+    {
+    }
+
+    /** messages lost in transit, by write index */
+    std::set<size_t> m_Drop;
+    /** messages losing their last byte in transit, by write index */
+    std::set<size_t> m_Truncate;
+
+    /** IRead receives nothing until Release, a slow channel */
+    void Hold()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Held = true;
+    }
+
+    void Release()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Held = false;
+        m_Condition.notify_one();
+    }
+
+    void Open(const std::string &name, const adios2::Mode openMode) final
+    {
+        m_Name = name;
+        m_OpenMode = openMode;
+        m_IsOpen = true;
+    }
+
+    void Write(const char *buffer, size_t size,
+               size_t /*start*/ = adios2::MaxSizeT) final
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        const size_t index = m_Written++;
+        if (m_Drop.count(index) == 1)
+        {
+            return;
+        }
+        if (m_Truncate.count(index) == 1 && size > 0)
+        {
+            --size;
+        }
+        m_Messages.emplace_back(buffer, buffer + size);
+        m_Condition.notify_one();
+    }
+
+    void Read(char * /*buffer*/, size_t /*size*/,
+              size_t /*start*/ = adios2::MaxSizeT) final
+    {
+        throw std::invalid_argument("ERROR: LoopbackTransport only IRead\n");
+    }
+
+    void IRead(char *buffer, size_t size, Status &status,
+               size_t /*start*/ = adios2::MaxSizeT) final
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait_for(lock, std::chrono::milliseconds(10), [this] {
+            return !m_Held && !m_Messages.empty();
+        });
+        status.Running = true;
+        if (m_Held || m_Messages.empty())
+        {
+            status.Bytes = 0;
+            status.Successful = false;
+            return;
+        }
+
+        const std::vector<char> message(std::move(m_Messages.front()));
+        m_Messages.pop_front();
+        status.Bytes = std::min(size, message.size());
+        std::memcpy(buffer, message.data(), status.Bytes);
+        status.Successful = (status.Bytes == size);
+    }
+
+    void Close() final { m_IsOpen = false; }
+
+private:
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::deque<std::vector<char>> m_Messages;
+    size_t m_Written = 0;
+    bool m_Held = false;
+};
+
+const size_t BufferSize = 100;
+const size_t SegmentSize = 32;
+/** header and segment messages per buffer */
+const size_t MessagesPerStep =
+    2 * ((BufferSize + SegmentSize - 1) / SegmentSize);
+
+/** sends steps buffers of BufferSize bytes, each filled with its step */
+void WriteSteps(adios2::transportman::DataMan &writer, const size_t steps)
+{
+    std::vector<char> buffer(BufferSize);
+    for (size_t step = 0; step < steps; ++step)
+    {
+        std::fill(buffer.begin(), buffer.end(), static_cast<char>(step));
+        writer.WriteWAN(buffer, buffer.size());
+    }
+}
+
+/** @return first byte, the step, of each buffer read before timing out
+ * or after expected buffers */
+std::vector<size_t> ReadSteps(adios2::transportman::DataMan &reader,
+                              const size_t expected)
+{
+    std::vector<size_t> steps;
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (steps.size() < expected &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::shared_ptr<std::vector<char>> buffer = reader.ReadWAN(100);
+        if (!buffer)
+        {
+            continue;
+        }
+        EXPECT_EQ(buffer->size(), BufferSize);
+        steps.push_back(static_cast<unsigned char>(buffer->front()));
+    }
+    return steps;
+}
+
+} // end empty namespace
+
+TEST(DataManSegments, PubSubSkipsStepWithLostSegment)
+{
+    auto channel = std::make_shared<LoopbackTransport>();
+    // second segment of step 2 and its header never arrive
+    channel->m_Drop = {2 * MessagesPerStep + 2, 2 * MessagesPerStep + 3};
+
+    adios2::transportman::DataMan writer(MPI_COMM_SELF, true);
+    writer.SetSegmentSize(SegmentSize);
+    writer.AddWANTransport(channel, adios2::Mode::Write, "pubsub");
+
+    adios2::transportman::DataMan reader(MPI_COMM_SELF, true);
+    reader.AddWANTransport(channel, adios2::Mode::Read, "pubsub");
+
+    WriteSteps(writer, 6);
+    EXPECT_EQ(ReadSteps(reader, 5), std::vector<size_t>({0, 1, 3, 4, 5}));
+}
+
+TEST(DataManSegments, PubSubWaitsForSlowerChannel)
+{
+    // whole steps alternate between channels, channel1 is slow and loses
+    // step 1, its first header and segment
+    auto channel0 = std::make_shared<LoopbackTransport>();
+    auto channel1 = std::make_shared<LoopbackTransport>();
+    channel1->m_Drop = {0, 1};
+    channel1->Hold();
+
+    adios2::transportman::DataMan writer(MPI_COMM_SELF, true);
+    writer.SetStripeSteps(true);
+    writer.AddWANTransport(channel0, adios2::Mode::Write, "pubsub");
+    writer.AddWANTransport(channel1, adios2::Mode::Write, "pubsub");
+
+    adios2::transportman::DataMan reader(MPI_COMM_SELF, true);
+    reader.AddWANTransport(channel0, adios2::Mode::Read, "pubsub");
+    reader.AddWANTransport(channel1, adios2::Mode::Read, "pubsub");
+
+    WriteSteps(writer, 6);
+    EXPECT_EQ(ReadSteps(reader, 1), std::vector<size_t>({0}));
+
+    // steps 2 and 4 are complete, but channel1 may still deliver step 1
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(reader.ReadWAN(), nullptr);
+
+    // step 3 on channel1 shows step 1 is lost
+    channel1->Release();
+    EXPECT_EQ(ReadSteps(reader, 4), std::vector<size_t>({2, 3, 4, 5}));
+}
+
+TEST(DataManSegments, ReqRepDropsStepWithFailedSegment)
+{
+    auto channel = std::make_shared<LoopbackTransport>();
+    // first segment of step 2 arrives short
+    channel->m_Truncate = {2 * MessagesPerStep + 1};
+
+    adios2::transportman::DataMan writer(MPI_COMM_SELF, true);
+    writer.SetSegmentSize(SegmentSize);
+    writer.AddWANTransport(channel, adios2::Mode::Write, "reqrep");
+
+    adios2::transportman::DataMan reader(MPI_COMM_SELF, true);
+    reader.AddWANTransport(channel, adios2::Mode::Read, "reqrep");
+
+    WriteSteps(writer, 6);
+    EXPECT_EQ(ReadSteps(reader, 5), std::vector<size_t>({0, 1, 3, 4, 5}));
+}
+
+TEST(DataManSegments, ReqRepKeepsAllStepsUnderBackPressure)
+{
+    // more steps than the reassembly window and queue hold, across two
+    // channels, read after all were sent
+    const size_t steps = 200;
+    auto channel0 = std::make_shared<LoopbackTransport>();
+    auto channel1 = std::make_shared<LoopbackTransport>();
+
+    adios2::transportman::DataMan writer(MPI_COMM_SELF, true);
+    writer.SetSegmentSize(SegmentSize);
+    writer.AddWANTransport(channel0, adios2::Mode::Write, "reqrep");
+    writer.AddWANTransport(channel1, adios2::Mode::Write, "reqrep");
+
+    adios2::transportman::DataMan reader(MPI_COMM_SELF, true);
+    reader.AddWANTransport(channel0, adios2::Mode::Read, "reqrep");
+    reader.AddWANTransport(channel1, adios2::Mode::Read, "reqrep");
+
+    WriteSteps(writer, steps);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<size_t> expected(steps);
+    for (size_t step = 0; step < steps; ++step)
+    {
+        expected[step] = step % 256;
+    }
+    EXPECT_EQ(ReadSteps(reader, steps), expected);
+}
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
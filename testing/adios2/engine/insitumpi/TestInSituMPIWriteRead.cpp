@@ -0,0 +1,201 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "mpi.h"
+
+class InSituMPIWriteReadTest : public ::testing::Test
+{
+public:
+    InSituMPIWriteReadTest() = default;
+};
+
+namespace
+{
+
+// the first half of the world ranks write, the second half read
+const int NWriters = 2;
+const int NReaders = 2;
+
+// each writer puts a Ny x Nx column block of a Ny x (NWriters * Nx) array
+const size_t Ny = 4;
+const size_t Nx = 4;
+
+const size_t NSteps = 3;
+
+double Value(const size_t step, const size_t y, const size_t x)
+{
+    return static_cast<double>(step * 1000 + y * 100 + x);
+}
+
+void Write(MPI_Comm comm, const std::string &fname,
+           const adios2::Params &parameters)
+{
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    const size_t x0 = rank * Nx;
+
+    adios2::ADIOS adios(comm, adios2::DebugON);
+    adios2::IO &io = adios.DeclareIO("TestIO");
+    io.SetEngine("InSituMPI");
+    io.SetParameters(parameters);
+
+    auto &var_a = io.DefineVariable<double>("a", {Ny, NWriters * Nx}, {0, x0},
+                                            {Ny, Nx});
+    // 1D array read whole by every reader, puts are in place
+    auto &var_b =
+        io.DefineVariable<int32_t>("b", {NWriters * Nx}, {x0}, {Nx});
+
+    adios2::Engine &engine = io.Open(fname, adios2::Mode::Write);
+
+    // the puts must stay valid until EndStep
+    std::vector<double> a(Ny * Nx);
+    std::vector<int32_t> b(Nx);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        for (size_t y = 0; y < Ny; ++y)
+        {
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                a[y * Nx + x] = Value(step, y, x0 + x);
+            }
+        }
+        for (size_t x = 0; x < Nx; ++x)
+        {
+            b[x] = static_cast<int32_t>(step * 100 + x0 + x);
+        }
+
+        engine.BeginStep();
+        // put in the opposite order of the reader requests
+        engine.PutDeferred(var_b, b.data());
+        engine.PutDeferred(var_a, a.data());
+        engine.EndStep();
+    }
+    engine.Close();
+}
+
+void Read(MPI_Comm comm, const std::string &fname,
+          const adios2::Params &parameters)
+{
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    // rows [2 * rank, 2 * rank + 2), columns [Nx/2, Nx/2 + Nx) cross both
+    // writer blocks, each intersection is a strided part of the block
+    const adios2::Dims start{2 * static_cast<size_t>(rank), Nx / 2};
+    const adios2::Dims count{2, Nx};
+
+    adios2::ADIOS adios(comm, adios2::DebugON);
+    adios2::IO &io = adios.DeclareIO("TestIO");
+    io.SetEngine("InSituMPI");
+    io.SetParameters(parameters);
+
+    adios2::Engine &engine = io.Open(fname, adios2::Mode::Read);
+
+    std::vector<double> a(count[0] * count[1]);
+    std::vector<int32_t> b(NWriters * Nx);
+    size_t step = 0;
+    while (engine.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var_a = io.InquireVariable<double>("a");
+        auto var_b = io.InquireVariable<int32_t>("b");
+        ASSERT_NE(var_a, nullptr);
+        ASSERT_NE(var_b, nullptr);
+
+        var_a->SetSelection({start, count});
+        std::fill(a.begin(), a.end(), -1.0);
+        std::fill(b.begin(), b.end(), -1);
+
+        engine.GetDeferred(*var_a, a.data());
+        engine.GetDeferred(*var_b, b.data());
+        engine.EndStep();
+
+        for (size_t y = 0; y < count[0]; ++y)
+        {
+            for (size_t x = 0; x < count[1]; ++x)
+            {
+                std::stringstream ss;
+                ss << "step=" << step << " reader=" << rank << " y=" << y
+                   << " x=" << x;
+                EXPECT_EQ(a[y * count[1] + x],
+                          Value(step, start[0] + y, start[1] + x))
+                    << ss.str();
+            }
+        }
+        for (size_t x = 0; x < b.size(); ++x)
+        {
+            EXPECT_EQ(b[x], static_cast<int32_t>(step * 100 + x))
+                << "step=" << step << " reader=" << rank << " x=" << x;
+        }
+        ++step;
+    }
+    EXPECT_EQ(step, NSteps);
+    engine.Close();
+}
+
+void WriteRead(const std::string &fname, const adios2::Params &parameters)
+{
+    int worldRank, worldSize;
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+    ASSERT_EQ(worldSize, NWriters + NReaders);
+
+    const bool isWriter = worldRank < NWriters;
+    MPI_Comm comm;
+    MPI_Comm_split(MPI_COMM_WORLD, isWriter ? 0 : 1, worldRank, &comm);
+    if (isWriter)
+    {
+        Write(comm, fname, parameters);
+    }
+    else
+    {
+        Read(comm, fname, parameters);
+    }
+    MPI_Comm_free(&comm);
+}
+
+} // end empty namespace
+
+//******************************************************************************
+// 2 writers, 2 readers, each reader reads a sub-box from both writers
+//******************************************************************************
+
+TEST_F(InSituMPIWriteReadTest, 2x2SubBox)
+{
+    WriteRead("ADIOS2InSituMPI2x2SubBox", {});
+}
+
+// after the first step the writers send without a new handshake
+TEST_F(InSituMPIWriteReadTest, 2x2SubBoxFixedSchedule)
+{
+    WriteRead("ADIOS2InSituMPI2x2SubBoxFixed", {{"FixedSchedule", "true"}});
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+    MPI_Init(nullptr, nullptr);
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+
+    return result;
+}
@@ -0,0 +1,122 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class SstDiscardReadTest : public ::testing::Test
+{
+public:
+    SstDiscardReadTest() = default;
+};
+
+//******************************************************************************
+// 1D 1x8 test data
+//******************************************************************************
+
+// ADIOS2 Sst read of a Discard writer, holding the first step while the
+// writer discards the step that adds variable b
+TEST_F(SstDiscardReadTest, ADIOS2SstDiscardRead)
+{
+    const std::string fname = "ADIOS2SstDiscard.sst";
+
+    // Number of rows
+    const std::size_t Nx = 8;
+
+    // Number of steps written
+    const std::size_t NSteps = 30;
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    adios2::IO &io = adios.DeclareIO("TestIO");
+
+    io.SetEngine("Sst");
+
+    adios2::Engine &engine = io.Open(fname, adios2::Mode::Read);
+
+    std::vector<int32_t> steps;
+    while (engine.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var_a = io.InquireVariable<int32_t>("a");
+        auto var_b = io.InquireVariable<int32_t>("b");
+        ASSERT_NE(var_a, nullptr);
+
+        const size_t size = var_a->m_Shape[0];
+        ASSERT_EQ(size % Nx, 0);
+        std::vector<int32_t> a(size);
+        std::vector<int32_t> b(size);
+        engine.GetDeferred(*var_a, a.data());
+        if (var_b != nullptr)
+        {
+            engine.GetDeferred(*var_b, b.data());
+        }
+
+        if (steps.empty())
+        {
+            // fill the writer queue while the variable set changes
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+        engine.EndStep();
+
+        const int32_t step = a[0];
+        for (size_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ(a[i], step) << "i=" << i;
+        }
+        if (step == 0)
+        {
+            EXPECT_EQ(var_b, nullptr);
+        }
+        else
+        {
+            // decoding needs the formats sent with a discarded step
+            ASSERT_NE(var_b, nullptr) << "step=" << step;
+            for (size_t i = 0; i < size; ++i)
+            {
+                EXPECT_EQ(b[i], -step) << "step=" << step << " i=" << i;
+            }
+        }
+        if (!steps.empty())
+        {
+            EXPECT_GT(step, steps.back());
+        }
+        steps.push_back(step);
+    }
+
+    // the step that added b was discarded, later ones arrived
+    ASSERT_GE(steps.size(), 2);
+    EXPECT_GT(steps[1], 1);
+    EXPECT_EQ(steps.back(), static_cast<int32_t>(NSteps - 1));
+
+    // Close the file
+    engine.Close();
+}
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,103 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class SstDiscardWriteTest : public ::testing::Test
+{
+public:
+    SstDiscardWriteTest() = default;
+};
+
+//******************************************************************************
+// 1D 1x8 test data
+//******************************************************************************
+
+// ADIOS2 Sst write with the Discard queue policy, adding a variable while the
+// reader holds the queue full
+TEST_F(SstDiscardWriteTest, ADIOS2SstDiscardWrite)
+{
+    const std::string fname = "ADIOS2SstDiscard.sst";
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows
+    const std::size_t Nx = 8;
+
+    // Number of steps
+    const std::size_t NSteps = 30;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    adios2::IO &io = adios.DeclareIO("TestIO");
+
+    const adios2::Dims shape{static_cast<unsigned int>(Nx * mpiSize)};
+    const adios2::Dims start{static_cast<unsigned int>(Nx * mpiRank)};
+    const adios2::Dims count{static_cast<unsigned int>(Nx)};
+    auto &var_a = io.DefineVariable<int32_t>("a", shape, start, count);
+
+    // Create the Engine, a single queued timestep, newer ones are discarded
+    io.SetEngine("Sst");
+    io.SetParameters({{"QueueLimit", "1"}, {"QueueFullPolicy", "Discard"}});
+
+    adios2::Engine &engine = io.Open(fname, adios2::Mode::Write);
+
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        const std::vector<int32_t> a(Nx, static_cast<int32_t>(step));
+        const std::vector<int32_t> b(Nx, -static_cast<int32_t>(step));
+
+        engine.BeginStep();
+        engine.PutSync(var_a, a.data());
+        // the field list changes on the first step the reader still holds
+        if (step > 0)
+        {
+            auto *var_b = io.InquireVariable<int32_t>("b");
+            if (var_b == nullptr)
+            {
+                var_b = &io.DefineVariable<int32_t>("b", shape, start, count);
+            }
+            engine.PutSync(*var_b, b.data());
+        }
+        engine.EndStep();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    // Close the file
+    engine.Close();
+}
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,160 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../SmallTestData.h"
+
+class SstShmReadTest : public ::testing::Test
+{
+public:
+    SstShmReadTest() = default;
+
+    SmallTestData m_TestData;
+};
+
+//******************************************************************************
+// 1D 1x8 test data
+//******************************************************************************
+
+// ADIOS2 Sst read through the shared memory data plane
+TEST_F(SstShmReadTest, ADIOS2SstShmRead1D8)
+{
+    // Each writer process wrote a 1x8 array and all writer processes
+    // form a writerSize * Nx 1D array, read here as a whole
+    const std::string fname = "ADIOS2SstShm1D8.sst";
+
+    // Number of rows
+    const std::size_t Nx = 8;
+
+    // Number of steps
+    const std::size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    adios2::IO &io = adios.DeclareIO("TestIO");
+
+    // Create the Engine, moving data through the shared memory data plane
+    io.SetEngine("Sst");
+    io.SetParameters({{"DataTransport", "shm"}});
+
+    adios2::Engine &engine = io.Open(fname, adios2::Mode::Read);
+
+    size_t t = 0;
+    while (engine.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var_i8 = io.InquireVariable<int8_t>("i8");
+        auto var_i16 = io.InquireVariable<int16_t>("i16");
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        auto var_i64 = io.InquireVariable<int64_t>("i64");
+        auto var_u8 = io.InquireVariable<uint8_t>("u8");
+        auto var_u16 = io.InquireVariable<uint16_t>("u16");
+        auto var_u32 = io.InquireVariable<uint32_t>("u32");
+        auto var_u64 = io.InquireVariable<uint64_t>("u64");
+        auto var_r32 = io.InquireVariable<float>("r32");
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_NE(var_i8, nullptr);
+        ASSERT_NE(var_i16, nullptr);
+        ASSERT_NE(var_i32, nullptr);
+        ASSERT_NE(var_i64, nullptr);
+        ASSERT_NE(var_u8, nullptr);
+        ASSERT_NE(var_u16, nullptr);
+        ASSERT_NE(var_u32, nullptr);
+        ASSERT_NE(var_u64, nullptr);
+        ASSERT_NE(var_r32, nullptr);
+        ASSERT_NE(var_r64, nullptr);
+
+        ASSERT_EQ(var_i8->m_Shape.size(), 1);
+        const size_t writerSize = var_i8->m_Shape[0] / Nx;
+        ASSERT_EQ(var_i8->m_Shape[0], writerSize * Nx);
+
+        std::vector<int8_t> I8(writerSize * Nx);
+        std::vector<int16_t> I16(writerSize * Nx);
+        std::vector<int32_t> I32(writerSize * Nx);
+        std::vector<int64_t> I64(writerSize * Nx);
+        std::vector<uint8_t> U8(writerSize * Nx);
+        std::vector<uint16_t> U16(writerSize * Nx);
+        std::vector<uint32_t> U32(writerSize * Nx);
+        std::vector<uint64_t> U64(writerSize * Nx);
+        std::vector<float> R32(writerSize * Nx);
+        std::vector<double> R64(writerSize * Nx);
+
+        engine.GetDeferred(*var_i8, I8.data());
+        engine.GetDeferred(*var_i16, I16.data());
+        engine.GetDeferred(*var_i32, I32.data());
+        engine.GetDeferred(*var_i64, I64.data());
+        engine.GetDeferred(*var_u8, U8.data());
+        engine.GetDeferred(*var_u16, U16.data());
+        engine.GetDeferred(*var_u32, U32.data());
+        engine.GetDeferred(*var_u64, U64.data());
+        engine.GetDeferred(*var_r32, R32.data());
+        engine.GetDeferred(*var_r64, R64.data());
+
+        // Fails with an exception if a shared memory read did not complete
+        engine.EndStep();
+
+        for (size_t w = 0; w < writerSize; ++w)
+        {
+            SmallTestData currentTestData = generateNewSmallTestData(
+                m_TestData, static_cast<int>(t), static_cast<int>(w),
+                static_cast<int>(writerSize));
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                const size_t g = w * Nx + i;
+                std::stringstream ss;
+                ss << "t=" << t << " w=" << w << " i=" << i;
+                std::string msg = ss.str();
+
+                EXPECT_EQ(I8[g], currentTestData.I8[i]) << msg;
+                EXPECT_EQ(I16[g], currentTestData.I16[i]) << msg;
+                EXPECT_EQ(I32[g], currentTestData.I32[i]) << msg;
+                EXPECT_EQ(I64[g], currentTestData.I64[i]) << msg;
+                EXPECT_EQ(U8[g], currentTestData.U8[i]) << msg;
+                EXPECT_EQ(U16[g], currentTestData.U16[i]) << msg;
+                EXPECT_EQ(U32[g], currentTestData.U32[i]) << msg;
+                EXPECT_EQ(U64[g], currentTestData.U64[i]) << msg;
+                EXPECT_EQ(R32[g], currentTestData.R32[i]) << msg;
+                EXPECT_EQ(R64[g], currentTestData.R64[i]) << msg;
+            }
+        }
+        ++t;
+    }
+    EXPECT_EQ(t, NSteps);
+
+    // Close the file
+    engine.Close();
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,216 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PerfCopyMemoryBox.cpp : micro-benchmark of the N-dimensional copy kernel
+ * used by BP3Deserializer::ClipContiguousMemory, reports GB/s for slab,
+ * pencil and transposed copies against an element by element copy using
+ * LinearIndex. Returns non-zero if results differ.
+ *
+ * Usage: PerfCopyMemoryBox [edge (default 256)] [repetitions (default 10)]
+ */
+
+#include <cstdint>
+#include <cstdlib> //std::strtoull
+#include <cstring> //std::memcpy, std::memcmp
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "adios2/helper/adiosMath.h"
+#include "adios2/helper/adiosMemory.h"
+#include "adios2/helper/adiosThreadPool.h"
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Case
+{
+    std::string Name;
+    adios2::Box<adios2::Dims> SourceBox;
+    bool SourceRowMajor;
+    adios2::Box<adios2::Dims> DestinationBox;
+    bool DestinationRowMajor;
+    adios2::Box<adios2::Dims> IntersectionBox;
+};
+
+/** element by element copy with LinearIndex, the pre-kernel algorithm */
+void ReferenceCopy(char *destination, const char *source, const Case &c,
+                   const size_t elementSize)
+{
+    const adios2::Dims &start = c.IntersectionBox.first;
+    const adios2::Dims &end = c.IntersectionBox.second;
+    adios2::Dims point(start);
+
+    while (true)
+    {
+        const size_t sourceIndex =
+            adios2::LinearIndex(c.SourceBox, point, c.SourceRowMajor);
+        const size_t destinationIndex = adios2::LinearIndex(
+            c.DestinationBox, point, c.DestinationRowMajor);
+
+        std::memcpy(destination + destinationIndex * elementSize,
+                    source + sourceIndex * elementSize, elementSize);
+
+        size_t d = 0;
+        for (; d < point.size(); ++d)
+        {
+            if (point[d] < end[d])
+            {
+                ++point[d];
+                break;
+            }
+            point[d] = start[d];
+        }
+        if (d == point.size())
+        {
+            break;
+        }
+    }
+}
+
+size_t BoxSize(const adios2::Box<adios2::Dims> &box)
+{
+    return adios2::GetTotalSize(
+        adios2::StartCountBox(box.first, box.second).second);
+}
+
+bool RunCase(const Case &c, const size_t elementSize, const size_t repetitions,
+             const unsigned int threads, adios2::ThreadPool &threadPool)
+{
+    std::vector<char> source(BoxSize(c.SourceBox) * elementSize);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<char>(i * 7 + i / 251);
+    }
+
+    const size_t destinationSize = BoxSize(c.DestinationBox) * elementSize;
+    std::vector<char> expected(destinationSize, 0);
+    std::vector<char> result(destinationSize, 0);
+
+    const size_t sourceStart =
+        adios2::LinearIndex(c.SourceBox, c.IntersectionBox.first,
+                            c.SourceRowMajor) *
+        elementSize;
+    const size_t destinationStart =
+        adios2::LinearIndex(c.DestinationBox, c.IntersectionBox.first,
+                            c.DestinationRowMajor) *
+        elementSize;
+
+    auto lf_Kernel = [&]() {
+        adios2::CopyMemoryBox(
+            result.data() + destinationStart, c.DestinationBox,
+            c.DestinationRowMajor, source.data() + sourceStart, c.SourceBox,
+            c.SourceRowMajor, c.IntersectionBox, elementSize, threads,
+            &threadPool);
+    };
+
+    auto lf_Reference = [&]() {
+        ReferenceCopy(expected.data(), source.data(), c, elementSize);
+    };
+
+    auto lf_Time = [&](const std::function<void()> &function) {
+        const auto start = Clock::now();
+        for (size_t r = 0; r < repetitions; ++r)
+        {
+            function();
+        }
+        return std::chrono::duration<double>(Clock::now() - start).count() /
+               static_cast<double>(repetitions);
+    };
+
+    const double referenceSeconds = lf_Time(lf_Reference);
+    const double kernelSeconds = lf_Time(lf_Kernel);
+
+    const double bytes =
+        static_cast<double>(BoxSize(c.IntersectionBox) * elementSize);
+
+    const bool match = (result == expected);
+
+    std::cout << std::left << std::setw(24) << c.Name << std::right
+              << std::setw(4) << elementSize << "B" << std::setw(4) << threads
+              << "T" << std::fixed << std::setprecision(2) << std::setw(10)
+              << bytes / referenceSeconds / 1e9 << " GB/s" << std::setw(10)
+              << bytes / kernelSeconds / 1e9 << " GB/s"
+              << (match ? "" : "  MISMATCH") << "\n";
+
+    return match;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 256;
+    const size_t repetitions =
+        (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10;
+
+    // 3-D block n x n x n with an offset, selections cut through it
+    const size_t o = 3;
+    const adios2::Box<adios2::Dims> block = {{o, o, o},
+                                             {o + n - 1, o + n - 1, o + n - 1}};
+
+    auto lf_Case = [&](const std::string &name, const adios2::Dims &start,
+                       const adios2::Dims &count, const bool sourceRowMajor,
+                       const bool destinationRowMajor) {
+        const adios2::Box<adios2::Dims> intersection =
+            adios2::StartEndBox(start, count);
+        return Case{name, block, sourceRowMajor, intersection,
+                    destinationRowMajor, intersection};
+    };
+
+    const std::vector<Case> cases = {
+        lf_Case("block", {o, o, o}, {n, n, n}, true, true),
+        lf_Case("sub-block", {o + 1, o + 2, o + 3}, {n - 2, n - 4, n - 6},
+                true, true),
+        lf_Case("z-plane", {o + n / 2, o, o}, {1, n, n}, true, true),
+        lf_Case("y-plane", {o, o + n / 2, o}, {n, 1, n}, true, true),
+        lf_Case("x-plane", {o, o, o + n / 2}, {n, n, 1}, true, true),
+        lf_Case("pencil", {o, o + 1, o + 1}, {n, 1, 1}, true, true),
+        lf_Case("sub-block column", {o + 1, o + 2, o + 3},
+                {n - 2, n - 4, n - 6}, false, false),
+        lf_Case("transpose row->col", {o, o, o}, {n, n, n}, true, false),
+        lf_Case("transpose col->row", {o + 1, o, o + 2}, {n - 1, n, n - 2},
+                false, true),
+        lf_Case("transpose y-plane", {o, o + 1, o}, {n, 1, n}, true, false)};
+
+    adios2::ThreadPool threadPool(4);
+
+    std::cout << "case                    size threads  reference    kernel\n";
+
+    bool match = true;
+    for (const auto &c : cases)
+    {
+        for (const size_t elementSize : {1, 4, 8, 16, 32})
+        {
+            match &= RunCase(c, elementSize, repetitions, 1, threadPool);
+        }
+        match &= RunCase(c, 8, repetitions, 4, threadPool);
+    }
+
+    // blocks and selections that overlap partially in 1, 2 and 4-D
+    const std::vector<Case> extraCases = {
+        {"1-D", {{0}, {99}}, true, {{50}, {149}}, true, {{50}, {99}}},
+        {"2-D row->col", {{0, 0}, {63, 63}}, true, {{10, 5}, {80, 40}}, false,
+         {{10, 5}, {63, 40}}},
+        {"4-D",
+         {{0, 0, 0, 0}, {7, 8, 9, 10}},
+         true,
+         {{1, 2, 3, 4}, {7, 8, 9, 10}},
+         true,
+         {{1, 2, 3, 4}, {6, 7, 9, 9}}}};
+
+    for (const auto &c : extraCases)
+    {
+        match &= RunCase(c, 8, 1, 1, threadPool);
+        match &= RunCase(c, 4, 1, 4, threadPool);
+    }
+
+    return match ? 0 : 1;
+}
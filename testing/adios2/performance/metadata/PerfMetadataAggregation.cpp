@@ -0,0 +1,132 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PerfMetadataAggregation.cpp : scaling benchmark of the collective metadata
+ * aggregation in BPFileWriter Close, every rank writes a small block of many
+ * variables per step so metadata dominates. Reports the slowest Close time
+ * and the growth of the rank 0 peak resident memory during Close, for flat
+ * (MetadataFanIn=0) or tree (MetadataFanIn >= 2) aggregation. Returns
+ * non-zero if rank 0 can't read the steps back.
+ *
+ * Usage: PerfMetadataAggregation [fan-in (default 0)]
+ *                                [variables (default 100)]
+ *                                [steps (default 10)]
+ *
+ * One configuration per run since peak memory only grows, e.g.
+ * for n in 1 4 16 64 256 1024 4096; do for k in 0 4 16; do
+ *   mpiexec --oversubscribe -n $n PerfMetadataAggregation $k; done; done
+ */
+
+#include <cstdlib> //std::strtoull
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+#include <sys/resource.h> //getrusage
+
+#include <adios2.h>
+
+namespace
+{
+
+/** peak resident memory of this process in MB */
+double PeakMemoryMB()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    MPI_Init(&argc, &argv);
+
+    int rank = 0;
+    int size = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    const std::string fanIn = (argc > 1) ? argv[1] : "0";
+    const size_t variables =
+        (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 100;
+    const size_t steps = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 10;
+
+    const std::string fname("PerfMetadataAggregation.bp");
+    const size_t count = 16;
+    std::vector<double> data(count, static_cast<double>(rank));
+
+    bool success = true;
+    {
+        adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+        adios2::IO &io = adios.DeclareIO("WriteIO");
+        io.SetEngine("BPFile");
+        io.SetParameter("MetadataFanIn", fanIn);
+
+        for (size_t v = 0; v < variables; ++v)
+        {
+            io.DefineVariable<double>(
+                "v" + std::to_string(v), {count * static_cast<size_t>(size)},
+                {count * static_cast<size_t>(rank)}, {count},
+                adios2::ConstantDims, data.data());
+        }
+
+        adios2::Engine &writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < steps; ++step)
+        {
+            data[0] = static_cast<double>(step);
+            writer.WriteStep();
+        }
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        const double memoryBefore = PeakMemoryMB();
+        const double start = MPI_Wtime();
+        writer.Close();
+        const double elapsed = MPI_Wtime() - start;
+        const double memoryGrowth = PeakMemoryMB() - memoryBefore;
+
+        double maxElapsed = 0;
+        MPI_Reduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, 0,
+                   MPI_COMM_WORLD);
+
+        if (rank == 0)
+        {
+            std::cout << "ranks " << size << " fan-in " << fanIn
+                      << " variables " << variables << " steps " << steps
+                      << std::fixed << std::setprecision(4) << " close "
+                      << maxElapsed << " s" << std::setprecision(1)
+                      << " rank 0 peak " << PeakMemoryMB() << " MB, "
+                      << memoryGrowth << " MB in close\n";
+        }
+    }
+
+    if (rank == 0)
+    {
+        adios2::ADIOS adios(MPI_COMM_SELF, adios2::DebugON);
+        adios2::IO &io = adios.DeclareIO("ReadIO");
+        adios2::Engine &reader = io.Open(fname, adios2::Mode::Read);
+
+        for (size_t v = 0; v < variables; ++v)
+        {
+            auto variable = io.InquireVariable<double>("v" + std::to_string(v));
+            if (variable == nullptr ||
+                variable->m_AvailableStepsCount != steps ||
+                variable->m_Shape[0] != count * static_cast<size_t>(size))
+            {
+                std::cout << "MISMATCH in variable v" << v << "\n";
+                success = false;
+                break;
+            }
+        }
+        reader.Close();
+    }
+
+    MPI_Bcast(&success, 1, MPI_C_BOOL, 0, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return success ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PerfMinMax.cpp : micro-benchmark of the statistics kernels used by
+ * BP3Serializer::GetStats, reports GB/s per type for GetMinMax and GetSums
+ * against std::minmax_element. Returns non-zero if results differ.
+ *
+ * Usage: PerfMinMax [elements (default 16M)] [repetitions (default 10)]
+ */
+
+#include <cstdint>
+#include <cstdlib> //std::strtoull
+
+#include <algorithm> //std::minmax_element
+#include <chrono>
+#include <cmath> //std::sqrt
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "adios2/helper/adiosMath.h"
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+template <class T>
+std::vector<T> GenerateData(const size_t size)
+{
+    std::vector<T> data(size);
+    uint64_t state = 2018;
+    for (size_t i = 0; i < size; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        data[i] = static_cast<T>(static_cast<int>((state >> 33) % 200) - 100);
+    }
+    return data;
+}
+
+/** runs function repetitions times, returns best throughput in GB/s */
+template <class F>
+double Throughput(const size_t bytes, const size_t repetitions, F function)
+{
+    double best = 0.;
+    for (size_t r = 0; r < repetitions; ++r)
+    {
+        const auto start = Clock::now();
+        function();
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+        if (elapsed.count() > 0.)
+        {
+            best = std::max(best, bytes / elapsed.count() / 1.e9);
+        }
+    }
+    return best;
+}
+
+void PrintRow(const std::string &type, const double reference,
+              const double minMax, const double sums)
+{
+    std::cout << std::left << std::setw(22) << type << std::right
+              << std::fixed << std::setprecision(2) << std::setw(14)
+              << reference << std::setw(14) << minMax << std::setw(14)
+              << sums << "\n";
+}
+
+template <class T>
+bool Run(const std::string &type, const size_t size, const size_t repetitions)
+{
+    const std::vector<T> data = GenerateData<T>(size);
+    const size_t bytes = size * sizeof(T);
+
+    T refMin, refMax;
+    const double reference = Throughput(bytes, repetitions, [&]() {
+        const auto bounds = std::minmax_element(data.begin(), data.end());
+        refMin = *bounds.first;
+        refMax = *bounds.second;
+    });
+
+    T min, max;
+    const double minMax = Throughput(bytes, repetitions, [&]() {
+        adios2::GetMinMax(data.data(), size, min, max);
+    });
+
+    double sum, sumSquare;
+    const double sums = Throughput(bytes, repetitions, [&]() {
+        adios2::GetSums(data.data(), size, sum, sumSquare);
+    });
+
+    PrintRow(type, reference, minMax, sums);
+
+    if (min != refMin || max != refMax)
+    {
+        std::cerr << "ERROR: GetMinMax differs from std::minmax_element for "
+                  << type << "\n";
+        return false;
+    }
+    return true;
+}
+
+template <class T>
+bool RunComplex(const std::string &type, const size_t size,
+                const size_t repetitions)
+{
+    const std::vector<T> real = GenerateData<T>(2 * size);
+    std::vector<std::complex<T>> data(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        data[i] = std::complex<T>(real[2 * i], real[2 * i + 1]);
+    }
+    const size_t bytes = size * sizeof(std::complex<T>);
+
+    T refMin, refMax;
+    const double reference = Throughput(bytes, repetitions, [&]() {
+        const auto bounds = std::minmax_element(
+            data.begin(), data.end(),
+            [](const std::complex<T> &a, const std::complex<T> &b) {
+                return std::norm(a) < std::norm(b);
+            });
+        refMin = std::sqrt(std::norm(*bounds.first));
+        refMax = std::sqrt(std::norm(*bounds.second));
+    });
+
+    T min, max;
+    const double minMax = Throughput(bytes, repetitions, [&]() {
+        adios2::GetMinMaxComplex(data.data(), size, min, max);
+    });
+
+    double sum, sumSquare;
+    const double sums = Throughput(bytes, repetitions, [&]() {
+        adios2::GetSums(data.data(), size, sum, sumSquare);
+    });
+
+    PrintRow(type, reference, minMax, sums);
+
+    if (min != refMin || max != refMax)
+    {
+        std::cerr << "ERROR: GetMinMaxComplex differs from reference for "
+                  << type << "\n";
+        return false;
+    }
+    return true;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    size_t size = 16 * 1024 * 1024;
+    size_t repetitions = 10;
+    if (argc > 1)
+    {
+        size = static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+    if (argc > 2)
+    {
+        repetitions = static_cast<size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+
+    std::cout << "elements: " << size << " repetitions: " << repetitions
+              << "\n";
+    std::cout << std::left << std::setw(22) << "type (GB/s)" << std::right
+              << std::setw(14) << "minmax_elem" << std::setw(14)
+              << "GetMinMax" << std::setw(14) << "GetSums"
+              << "\n";
+
+    bool passed = true;
+    passed &= Run<int8_t>("int8_t", size, repetitions);
+    passed &= Run<uint8_t>("uint8_t", size, repetitions);
+    passed &= Run<int16_t>("int16_t", size, repetitions);
+    passed &= Run<uint16_t>("uint16_t", size, repetitions);
+    passed &= Run<int32_t>("int32_t", size, repetitions);
+    passed &= Run<uint32_t>("uint32_t", size, repetitions);
+    passed &= Run<int64_t>("int64_t", size, repetitions);
+    passed &= Run<uint64_t>("uint64_t", size, repetitions);
+    passed &= Run<float>("float", size, repetitions);
+    passed &= Run<double>("double", size, repetitions);
+    passed &= Run<long double>("long double", size, repetitions);
+    passed &= RunComplex<float>("std::complex<float>", size, repetitions);
+    passed &= RunComplex<double>("std::complex<double>", size, repetitions);
+
+    return passed ? 0 : 1;
+}